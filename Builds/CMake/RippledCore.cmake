@@ -50,7 +50,6 @@ target_sources (xrpl_core PRIVATE
   src/ripple/basics/impl/FileUtilities.cpp
   src/ripple/basics/impl/IOUAmount.cpp
   src/ripple/basics/impl/Log.cpp
-  src/ripple/basics/impl/strHex.cpp
   src/ripple/basics/impl/StringUtilities.cpp
   #[===============================[
     main sources:
@@ -102,6 +101,7 @@ target_sources (xrpl_core PRIVATE
   src/ripple/protocol/impl/Seed.cpp
   src/ripple/protocol/impl/Serializer.cpp
   src/ripple/protocol/impl/Sign.cpp
+  src/ripple/protocol/impl/SignatureCache.cpp
   src/ripple/protocol/impl/TER.cpp
   src/ripple/protocol/impl/TxFormats.cpp
   src/ripple/protocol/impl/TxMeta.cpp
@@ -231,6 +231,7 @@ install (
     src/ripple/protocol/SeqProxy.h
     src/ripple/protocol/Serializer.h
     src/ripple/protocol/Sign.h
+    src/ripple/protocol/SignatureCache.h
     src/ripple/protocol/SystemParameters.h
     src/ripple/protocol/TER.h
     src/ripple/protocol/TxFlags.h
@@ -348,6 +349,8 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/InboundTransactions.cpp
   src/ripple/app/ledger/impl/LedgerCleaner.cpp
   src/ripple/app/ledger/impl/LedgerDeltaAcquire.cpp
+  src/ripple/app/ledger/impl/LedgerFragmentCache.cpp
+  src/ripple/app/ledger/impl/LedgerHashIndex.cpp
   src/ripple/app/ledger/impl/LedgerMaster.cpp
   src/ripple/app/ledger/impl/LedgerReplay.cpp
   src/ripple/app/ledger/impl/LedgerReplayer.cpp
@@ -407,6 +410,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/rdb/impl/RelationalDBInterface_nodes.cpp
   src/ripple/app/rdb/impl/RelationalDBInterface_postgres.cpp
   src/ripple/app/rdb/impl/RelationalDBInterface_shards.cpp
+  src/ripple/app/rdb/impl/TxIndex.cpp
   src/ripple/app/tx/impl/ApplyContext.cpp
   src/ripple/app/tx/impl/BookTip.cpp
   src/ripple/app/tx/impl/CancelCheck.cpp
@@ -446,6 +450,7 @@ target_sources (rippled PRIVATE
   src/ripple/basics/impl/BasicConfig.cpp
   src/ripple/basics/impl/ResolverAsio.cpp
   src/ripple/basics/impl/UptimeClock.cpp
+  src/ripple/basics/impl/WorkerPool.cpp
   src/ripple/basics/impl/make_SSLContext.cpp
   src/ripple/basics/impl/mulDiv.cpp
   src/ripple/basics/impl/partitioned_unordered_map.cpp
@@ -491,6 +496,7 @@ target_sources (rippled PRIVATE
   src/ripple/ledger/impl/PaymentSandbox.cpp
   src/ripple/ledger/impl/RawStateTable.cpp
   src/ripple/ledger/impl/ReadView.cpp
+  src/ripple/ledger/impl/RecordingView.cpp
   src/ripple/ledger/impl/View.cpp
   #[===============================[
      main sources:
@@ -523,6 +529,7 @@ target_sources (rippled PRIVATE
   src/ripple/nodestore/impl/DecodedBlob.cpp
   src/ripple/nodestore/impl/DummyScheduler.cpp
   src/ripple/nodestore/impl/EncodedBlob.cpp
+  src/ripple/nodestore/impl/FilteredBackend.cpp
   src/ripple/nodestore/impl/ManagerImp.cpp
   src/ripple/nodestore/impl/NodeObject.cpp
   src/ripple/nodestore/impl/Shard.cpp
@@ -533,6 +540,7 @@ target_sources (rippled PRIVATE
        subdir: overlay
   #]===============================]
   src/ripple/overlay/impl/Cluster.cpp
+  src/ripple/overlay/impl/Compression.cpp
   src/ripple/overlay/impl/ConnectAttempt.cpp
   src/ripple/overlay/impl/Handshake.cpp
   src/ripple/overlay/impl/Message.cpp
@@ -541,6 +549,7 @@ target_sources (rippled PRIVATE
   src/ripple/overlay/impl/PeerReservationTable.cpp
   src/ripple/overlay/impl/PeerSet.cpp
   src/ripple/overlay/impl/ProtocolVersion.cpp
+  src/ripple/overlay/impl/SendQueue.cpp
   src/ripple/overlay/impl/TrafficCount.cpp
   src/ripple/overlay/impl/TxMetrics.cpp
   #[===============================[
@@ -634,8 +643,10 @@ target_sources (rippled PRIVATE
   src/ripple/rpc/impl/Handler.cpp
   src/ripple/rpc/impl/GRPCHelpers.cpp
   src/ripple/rpc/impl/LegacyPathFind.cpp
+  src/ripple/rpc/impl/ObligationsIndex.cpp
   src/ripple/rpc/impl/RPCHandler.cpp
   src/ripple/rpc/impl/RPCHelpers.cpp
+  src/ripple/rpc/impl/ResponseCache.cpp
   src/ripple/rpc/impl/Role.cpp
   src/ripple/rpc/impl/ServerHandlerImp.cpp
   src/ripple/rpc/impl/ShardArchiveHandler.cpp
@@ -674,6 +685,7 @@ target_sources (rippled PRIVATE
   #]===============================]
 if (tests)
   target_sources (rippled PRIVATE
+    src/test/app/AcceptedLedger_test.cpp
     src/test/app/AccountDelete_test.cpp
     src/test/app/AccountTxPaging_test.cpp
     src/test/app/AmendmentTable_test.cpp
@@ -688,6 +700,8 @@ if (tests)
     src/test/app/Flow_test.cpp
     src/test/app/Freeze_test.cpp
     src/test/app/HashRouter_test.cpp
+    src/test/app/LedgerFragmentCache_test.cpp
+    src/test/app/LedgerHashIndex_test.cpp
     src/test/app/LedgerHistory_test.cpp
     src/test/app/LedgerLoad_test.cpp
     src/test/app/LedgerReplay_test.cpp
@@ -699,7 +713,9 @@ if (tests)
     src/test/app/NFTokenDir_test.cpp
     src/test/app/OfferStream_test.cpp
     src/test/app/Offer_test.cpp
+    src/test/app/OpenLedger_test.cpp
     src/test/app/OversizeMeta_test.cpp
+    src/test/app/ParallelApply_test.cpp
     src/test/app/Path_test.cpp
     src/test/app/PayChan_test.cpp
     src/test/app/PayStrand_test.cpp
@@ -716,6 +732,7 @@ if (tests)
     src/test/app/Ticket_test.cpp
     src/test/app/Transaction_ordering_test.cpp
     src/test/app/TrustAndBalance_test.cpp
+    src/test/app/TxIndex_test.cpp
     src/test/app/TxQ_test.cpp
     src/test/app/ValidatorKeys_test.cpp
     src/test/app/ValidatorList_test.cpp
@@ -737,6 +754,7 @@ if (tests)
     src/test/basics/Slice_test.cpp
     src/test/basics/StringUtilities_test.cpp
     src/test/basics/TaggedCache_test.cpp
+    src/test/basics/WorkerPool_test.cpp
     src/test/basics/XRPAmount_test.cpp
     src/test/basics/base64_test.cpp
     src/test/basics/base_uint_test.cpp
@@ -867,6 +885,7 @@ if (tests)
          subdir: net
     #]===============================]
     src/test/net/DatabaseDownloader_test.cpp
+    src/test/net/RPCSub_test.cpp
     #[===============================[
        test sources:
          subdir: nodestore
@@ -889,6 +908,7 @@ if (tests)
     src/test/overlay/reduce_relay_test.cpp
     src/test/overlay/handshake_test.cpp
     src/test/overlay/tx_reduce_relay_test.cpp
+    src/test/overlay/SendQueue_test.cpp
     #[===============================[
        test sources:
          subdir: peerfinder
@@ -914,6 +934,7 @@ if (tests)
     src/test/protocol/SecretKey_test.cpp
     src/test/protocol/Seed_test.cpp
     src/test/protocol/SeqProxy_test.cpp
+    src/test/protocol/SignatureCache_test.cpp
     src/test/protocol/TER_test.cpp
     src/test/protocol/types_test.cpp
     #[===============================[
@@ -953,6 +974,7 @@ if (tests)
     src/test/rpc/OwnerInfo_test.cpp
     src/test/rpc/Peers_test.cpp
     src/test/rpc/ReportingETL_test.cpp
+    src/test/rpc/ResponseCache_test.cpp
     src/test/rpc/Roles_test.cpp
     src/test/rpc/RPCCall_test.cpp
     src/test/rpc/RPCOverload_test.cpp
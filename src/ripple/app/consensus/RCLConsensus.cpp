@@ -624,11 +624,10 @@ RCLConsensus::Adaptor::doAccept(
             }
         }
 
-        // Build new open ledger
-        std::unique_lock lock{app_.getMasterMutex(), std::defer_lock};
-        std::unique_lock sl{ledgerMaster_.peekMutex(), std::defer_lock};
-        std::lock(lock, sl);
-
+        // Build new open ledger. OpenLedger::accept takes the master and
+        // ledger master locks itself, but only to publish the new open
+        // view, so incoming submissions are not stalled while the open
+        // ledger is rebuilt.
         auto const lastVal = ledgerMaster_.getValidatedLedger();
         std::optional<Rules> rules;
         if (lastVal)
@@ -21,6 +21,7 @@
 #include <ripple/core/Config.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/SignatureCache.h>
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 
@@ -54,7 +55,8 @@ RCLCxPeerPos::signingHash() const
 bool
 RCLCxPeerPos::checkSign() const
 {
-    return verifyDigest(publicKey(), signingHash(), signature(), false);
+    return signatureCache().verifyDigest(
+        publicKey(), signingHash(), signature(), false);
 }
 
 Json::Value
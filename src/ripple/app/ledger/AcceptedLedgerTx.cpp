@@ -30,16 +30,29 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     std::shared_ptr<STTx const> const& txn,
     std::shared_ptr<STObject const> const& met,
     AccountIDCache const& accountCache)
-    : mTxn(txn)
+    : mLedger(ledger)
+    , mTxn(txn)
     , mMeta(txn->getTransactionID(), ledger->seq(), *met)
     , mAffected(mMeta.getAffectedAccounts())
+    , mAccountCache(accountCache)
 {
     assert(!ledger->open());
 
     Serializer s;
     met->add(s);
     mRawMeta = std::move(s.modData());
+}
 
+Json::Value const&
+AcceptedLedgerTx::getJson() const
+{
+    std::call_once(mJsonOnce, &AcceptedLedgerTx::buildJson, this);
+    return mJson;
+}
+
+void
+AcceptedLedgerTx::buildJson() const
+{
     mJson = Json::objectValue;
     mJson[jss::transaction] = mTxn->getJson(JsonOptions::none);
 
@@ -52,7 +65,7 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     {
         Json::Value& affected = (mJson[jss::affected] = Json::arrayValue);
         for (auto const& account : mAffected)
-            affected.append(accountCache.toBase58(account));
+            affected.append(mAccountCache.toBase58(account));
     }
 
     if (mTxn->getTxnType() == ttOFFER_CREATE)
@@ -64,7 +77,7 @@ AcceptedLedgerTx::AcceptedLedgerTx(
         if (account != amount.issue().account)
         {
             auto const ownerFunds = accountFunds(
-                *ledger,
+                *mLedger,
                 account,
                 amount,
                 fhIGNORE_FREEZE,
@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/protocol/AccountID.h>
 #include <boost/container/flat_set.hpp>
+#include <mutex>
 
 namespace ripple {
 
@@ -39,6 +40,11 @@ class Logs;
         - Which accounts are affected
           * This is used by InfoSub to report to clients
         - Cached stuff
+
+    Rendering the transaction as JSON is comparatively expensive and most
+    transactions in an accepted ledger are never looked at by a subscriber
+    or an RPC client, so the JSON form is built on first use and then
+    cached for the lifetime of the object.
 */
 class AcceptedLedgerTx : public CountedObject<AcceptedLedgerTx>
 {
@@ -89,18 +95,28 @@ public:
     std::string
     getEscMeta() const;
 
+    /** Return the transaction, its metadata and the affected accounts in
+        JSON form.
+
+        The result is computed the first time it is requested and cached.
+        It is safe to call this concurrently from multiple threads.
+    */
     Json::Value const&
-    getJson() const
-    {
-        return mJson;
-    }
+    getJson() const;
 
 private:
+    void
+    buildJson() const;
+
+    std::shared_ptr<ReadView const> mLedger;
     std::shared_ptr<STTx const> mTxn;
     TxMeta mMeta;
     boost::container::flat_set<AccountID> mAffected;
     Blob mRawMeta;
-    Json::Value mJson;
+    AccountIDCache const& mAccountCache;
+
+    mutable std::once_flag mJsonOnce;
+    mutable Json::Value mJson;
 };
 
 }  // namespace ripple
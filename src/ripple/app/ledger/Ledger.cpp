@@ -1086,6 +1086,14 @@ loadByHash(uint256 const& ledgerHash, Application& app, bool acquire)
     return {};
 }
 
+std::shared_ptr<Ledger>
+loadByInfo(LedgerInfo const& info, Application& app, bool acquire)
+{
+    std::shared_ptr<Ledger> ledger = loadLedgerHelper(info, app, acquire);
+    finishLoadByIndexOrHash(ledger, app.config(), app.journal("Ledger"));
+    return ledger;
+}
+
 std::vector<
     std::pair<std::shared_ptr<STTx const>, std::shared_ptr<STObject const>>>
 flatFetchTransactions(Application& app, std::vector<uint256>& nodestoreHashes)
@@ -440,6 +440,11 @@ loadByIndex(std::uint32_t ledgerIndex, Application& app, bool acquire = true);
 std::shared_ptr<Ledger>
 loadByHash(uint256 const& ledgerHash, Application& app, bool acquire = true);
 
+// Open a ledger from a header that is already known, such as one kept in
+// memory, without looking it up in the relational database.
+std::shared_ptr<Ledger>
+loadByInfo(LedgerInfo const& info, Application& app, bool acquire = true);
+
 // Fetch the ledger with the highest sequence contained in the database
 extern std::tuple<std::shared_ptr<Ledger>, std::uint32_t, uint256>
 getLatestLedger(Application& app);
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERFRAGMENTCACHE_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERFRAGMENTCACHE_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/shamap/SHAMapNodeID.h>
+#include <ripple/shamap/SHAMapTreeNode.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+/** Remembers serialized pieces of replies to ledger requests.
+
+    Syncing peers tend to ask for the same nodes of the same recent
+    ledgers. Ledgers and transaction sets never change once they are
+    closed, so the nodes returned for a request, and the objects added
+    to a fetch pack for a ledger, are the same for every peer. They are
+    kept here as serialized protocol messages holding only the repeated
+    fields, which can be merged into a reply without walking the map or
+    reading the node store again.
+
+    The least recently used fragments are evicted to keep their total
+    size within a byte budget.
+*/
+class LedgerFragmentCache
+{
+public:
+    explicit LedgerFragmentCache(std::size_t maxBytes);
+
+    LedgerFragmentCache(LedgerFragmentCache const&) = delete;
+    LedgerFragmentCache&
+    operator=(LedgerFragmentCache const&) = delete;
+
+    /** Returns the key for the nodes returned for a TMGetLedger query. */
+    static uint256
+    nodeKey(
+        SHAMapHash const& map,
+        SHAMapNodeID const& node,
+        std::uint32_t depth,
+        bool fatLeaves);
+
+    /** Returns the key for the fetch pack objects of a ledger's parent. */
+    static uint256
+    fetchPackKey(uint256 const& ledgerHash);
+
+    /** Returns the fragment stored for a key, or nullptr. */
+    std::shared_ptr<std::string const>
+    fetch(uint256 const& key);
+
+    /** Stores a fragment, evicting older ones as needed.
+
+        Fragments larger than a quarter of the budget are not stored.
+    */
+    void
+    insert(uint256 const& key, std::shared_ptr<std::string const> fragment);
+
+    std::size_t
+    size() const;
+
+    std::size_t
+    bytes() const;
+
+    /** Returns the percentage of lookups that found a fragment. */
+    double
+    getHitRate() const;
+
+private:
+    struct Entry
+    {
+        uint256 key;
+        std::shared_ptr<std::string const> fragment;
+    };
+
+    using List = std::list<Entry>;
+
+    std::size_t const maxBytes_;
+
+    mutable std::mutex mutex_;
+
+    // Most recently used first
+    List entries_;
+    hash_map<uint256, List::iterator> index_;
+    std::size_t bytes_ = 0;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
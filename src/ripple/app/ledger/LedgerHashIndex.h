@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** Persistent map from ledger sequence to the hash of the validated ledger.
+
+    The hashes are kept in a file that holds one 32 byte slot per
+    sequence number, from a base sequence chosen by the first insert,
+    so that a lookup is a single read from a memory mapping of the
+    file. A slot holding zero has no hash.
+
+    The file starts with a header that identifies the format, the
+    network the ledgers belong to and the base sequence. A file whose
+    header doesn't match is discarded. Whether the hashes belong to the
+    ledger database in use can only be checked against that database,
+    so lookups find nothing until the contents are confirmed against
+    hashes read from that database.
+
+    Only hashes of validated ledgers may be inserted. The file grows
+    as needed and is never truncated.
+
+    If no path is given, or the file can't be opened, the index is
+    disabled: inserts are ignored and lookups find nothing.
+
+    @note All functions can be called concurrently.
+*/
+class LedgerHashIndex
+{
+public:
+    /** Open the index.
+        @param path The file, or empty to disable the index.
+        @param networkID The network the ledgers belong to, if known.
+    */
+    LedgerHashIndex(
+        boost::filesystem::path const& path,
+        std::optional<std::uint32_t> networkID,
+        beast::Journal j);
+
+    LedgerHashIndex(LedgerHashIndex const&) = delete;
+    LedgerHashIndex&
+    operator=(LedgerHashIndex const&) = delete;
+
+    ~LedgerHashIndex();
+
+    /** Returns `true` if the index is backed by a file. */
+    bool
+    enabled() const
+    {
+        return !path_.empty();
+    }
+
+    /** Check the contents against hashes known to be right.
+
+        If any of the hashes disagrees with the index, the index belongs
+        to another ledger database or network, and every hash in it is
+        forgotten. The known hashes are then recorded, and lookups are
+        enabled.
+
+        @param known Sequences and hashes of validated ledgers.
+        @return `false` if the contents were discarded.
+    */
+    bool
+    confirm(std::vector<std::pair<LedgerIndex, LedgerHash>> const& known);
+
+    /** Record the hash of a validated ledger.
+        An existing entry for the sequence is replaced.
+    */
+    void
+    insert(LedgerIndex seq, LedgerHash const& hash);
+
+    /** Returns the hash of the validated ledger with the given sequence. */
+    std::optional<LedgerHash>
+    get(LedgerIndex seq) const;
+
+    /** Forget the hash of the ledger with the given sequence. */
+    void
+    erase(LedgerIndex seq);
+
+    /** Write modified pages to disk. */
+    void
+    sync();
+
+private:
+    struct Header;
+
+    // Start an empty file. Must be called with the mutex held exclusively.
+    void
+    create();
+
+    // Record a hash. Must be called with the mutex held exclusively.
+    void
+    set(LedgerIndex seq, LedgerHash const& hash);
+
+    // Map the header and `slots` slots, growing the file if necessary.
+    // Must be called with the mutex held exclusively.
+    void
+    map(std::size_t slots);
+
+    // Move the base down to make room for a sequence below it.
+    // Must be called with the mutex held exclusively.
+    void
+    rebase(LedgerIndex seq);
+
+    // Write the header. Must be called with the mutex held exclusively.
+    void
+    writeHeader(bool moving);
+
+    bool
+    contains(LedgerIndex seq) const
+    {
+        return seq != 0 && seq >= base_ && seq - base_ < slots_;
+    }
+
+    unsigned char*
+    slot(LedgerIndex seq) const;
+
+    boost::filesystem::path path_;
+    std::optional<std::uint32_t> const networkID_;
+    beast::Journal const j_;
+
+    std::atomic<bool> confirmed_{false};
+
+    std::shared_mutex mutable mutex_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+
+    // The sequence of the first slot, and the number of slots mapped
+    LedgerIndex base_ = 0;
+    std::size_t slots_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerToJson.h>
+#include <ripple/app/rdb/RelationalDBInterface.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/basics/contract.h>
@@ -46,6 +47,7 @@ LedgerHistory::LedgerHistory(
           std::chrono::minutes{5},
           stopwatch(),
           app_.journal("TaggedCache"))
+    , headers_(app_.config().getValueFor(SizedItem::ledgerHeaders))
     , j_(app.journal("LedgerHistory"))
 {
 }
@@ -63,11 +65,93 @@ LedgerHistory::insert(std::shared_ptr<Ledger const> ledger, bool validated)
     const bool alreadyHad = m_ledgers_by_hash.canonicalize_replace_cache(
         ledger->info().hash, ledger);
     if (validated)
+    {
         mLedgersByIndex[ledger->info().seq] = ledger->info().hash;
+        insertHeader(ledger->info());
+    }
 
     return alreadyHad;
 }
 
+bool
+LedgerHistory::insertHeader(LedgerInfo const& info)
+{
+    std::lock_guard sl(headersMutex_);
+    auto& slot = headers_[info.seq % headers_.size()];
+
+    if (slot.seq > info.seq)
+        return false;
+
+    if (slot.seq != 0)
+        headersByHash_.erase(slot.hash);
+    slot = info;
+    headersByHash_[info.hash] = info.seq;
+    return true;
+}
+
+std::optional<LedgerInfo>
+LedgerHistory::findHeader(LedgerIndex ledgerIndex) const
+{
+    std::lock_guard sl(headersMutex_);
+    auto const& slot = headers_[ledgerIndex % headers_.size()];
+
+    if (slot.seq != ledgerIndex || ledgerIndex == 0)
+        return std::nullopt;
+
+    return slot;
+}
+
+std::optional<LedgerInfo>
+LedgerHistory::findHeader(LedgerHash const& ledgerHash) const
+{
+    std::lock_guard sl(headersMutex_);
+    auto const it = headersByHash_.find(ledgerHash);
+
+    if (it == headersByHash_.end())
+        return std::nullopt;
+
+    return headers_[it->second % headers_.size()];
+}
+
+void
+LedgerHistory::eraseHeader(LedgerIndex ledgerIndex)
+{
+    std::lock_guard sl(headersMutex_);
+    auto& slot = headers_[ledgerIndex % headers_.size()];
+
+    if (slot.seq == ledgerIndex)
+    {
+        headersByHash_.erase(slot.hash);
+        slot = LedgerInfo{};
+    }
+}
+
+void
+LedgerHistory::loadHeaders(LedgerIndex seq)
+{
+    auto& db = app_.getNodeFamily().db();
+    std::size_t loaded = 0;
+
+    for (auto index = seq; index > 1 && loaded < headers_.size(); ++loaded)
+    {
+        auto const info =
+            app_.getRelationalDBInterface().getLedgerInfoByIndex(--index);
+        if (!info || !insertHeader(*info))
+            break;
+
+        // Warm the node store cache with the roots of the ledger's maps,
+        // which are the first nodes read when the ledger is reopened.
+        for (auto const& hash : {info->accountHash, info->txHash})
+        {
+            if (hash.isNonZero())
+                db.asyncFetch(hash, info->seq, [](auto const&) {});
+        }
+    }
+
+    JLOG(j_.debug()) << "Loaded " << loaded << " ledger headers before "
+                     << seq;
+}
+
 LedgerHash
 LedgerHistory::getLedgerHash(LedgerIndex index)
 {
@@ -95,7 +179,12 @@ LedgerHistory::getLedgerBySeq(LedgerIndex index)
         }
     }
 
-    std::shared_ptr<Ledger const> ret = loadByIndex(index, app_);
+    std::shared_ptr<Ledger const> ret;
+
+    if (auto const info = findHeader(index))
+        ret = loadByInfo(*info, app_);
+    else
+        ret = loadByIndex(index, app_);
 
     if (!ret)
         return ret;
@@ -125,7 +214,10 @@ LedgerHistory::getLedgerByHash(LedgerHash const& hash)
         return ret;
     }
 
-    ret = loadByHash(hash, app_);
+    if (auto const info = findHeader(hash))
+        ret = loadByInfo(*info, app_);
+    else
+        ret = loadByHash(hash, app_);
 
     if (!ret)
         return ret;
@@ -510,8 +602,14 @@ LedgerHistory::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
     if ((it != mLedgersByIndex.end()) && (it->second != ledgerHash))
     {
         it->second = ledgerHash;
+        eraseHeader(ledgerIndex);
         return false;
     }
+
+    if (auto const info = findHeader(ledgerIndex);
+        info && info->hash != ledgerHash)
+        eraseHeader(ledgerIndex);
+
     return true;
 }
 
@@ -26,7 +26,9 @@
 #include <ripple/beast/insight/Event.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 
+#include <mutex>
 #include <optional>
+#include <vector>
 
 namespace ripple {
 
@@ -103,6 +105,18 @@ public:
     void
     clearLedgerCachePrior(LedgerIndex seq);
 
+    /** Fill the header cache with the ledgers stored before a ledger
+
+        Loads the headers of the validated ledgers preceding `seq` from
+        the relational database, stopping at the first gap, and starts
+        fetching their root nodes so that they can be reopened without
+        touching the disk.
+
+        @param seq The sequence of the first ledger not to load.
+    */
+    void
+    loadHeaders(LedgerIndex seq);
+
 private:
     /** Log details in the case where we build one ledger but
         validate a different one.
@@ -122,6 +136,24 @@ private:
         std::optional<uint256> const& validatedConsensusHash,
         Json::Value const& consensus);
 
+    /** Remember the header of a validated ledger
+        @return `false` if a newer ledger already uses the slot
+    */
+    bool
+    insertHeader(LedgerInfo const& info);
+
+    /** Look up a remembered header by sequence */
+    std::optional<LedgerInfo>
+    findHeader(LedgerIndex ledgerIndex) const;
+
+    /** Look up a remembered header by hash */
+    std::optional<LedgerInfo>
+    findHeader(LedgerHash const& ledgerHash) const;
+
+    /** Forget the header of the ledger with the given sequence */
+    void
+    eraseHeader(LedgerIndex ledgerIndex);
+
     Application& app_;
     beast::insight::Collector::ptr collector_;
     beast::insight::Counter mismatch_counter_;
@@ -151,6 +183,13 @@ private:
     // Maps ledger indexes to the corresponding hash.
     std::map<LedgerIndex, LedgerHash> mLedgersByIndex;  // validated ledgers
 
+    // Headers of the most recent validated ledgers, in slots indexed by
+    // sequence modulo the size, which lets ledgers that have dropped out
+    // of m_ledgers_by_hash be reopened without going to the database.
+    std::mutex mutable headersMutex_;
+    std::vector<LedgerInfo> headers_;
+    hash_map<LedgerHash, LedgerIndex> headersByHash_;
+
     beast::Journal j_;
 };
 
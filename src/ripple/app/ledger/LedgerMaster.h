@@ -23,6 +23,8 @@
 #include <ripple/app/ledger/AbstractFetchPackContainer.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/LedgerFragmentCache.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerHolder.h>
 #include <ripple/app/ledger/LedgerReplay.h>
@@ -281,6 +283,13 @@ public:
     std::size_t
     getFetchPackCacheSize() const;
 
+    /** The serialized nodes and fetch pack objects sent to peers. */
+    LedgerFragmentCache&
+    getFragmentCache()
+    {
+        return fragmentCache_;
+    }
+
     //! Whether we have ever fully validated a ledger.
     bool
     haveValidated()
@@ -307,6 +316,15 @@ private:
     std::optional<LedgerHash>
     getLedgerHashForHistory(LedgerIndex index, InboundLedger::Reason reason);
 
+    // Record the hashes in a ledger's skip list in the hash index.
+    void
+    indexSkipList(ReadView const& ledger);
+
+    // Reconcile the hash index with the SQL database for the ledgers
+    // preceding the given one.
+    void
+    checkHashIndex(LedgerIndex seq);
+
     std::size_t
     getNeededValidations();
     void
@@ -359,6 +377,9 @@ private:
 
     LedgerHistory mLedgerHistory;
 
+    // Hashes of validated ledgers by sequence, kept across restarts
+    LedgerHashIndex mHashIndex;
+
     CanonicalTXSet mHeldTransactions{uint256()};
 
     // A set of transactions to replay during the next close
@@ -380,6 +401,9 @@ private:
     std::atomic_flag mGotFetchPackThread =
         ATOMIC_FLAG_INIT;  // GotFetchPack jobs dispatched
 
+    std::atomic_flag mLoadHeadersThread =
+        ATOMIC_FLAG_INIT;  // ledger header and hash index warm-up dispatched
+
     std::atomic<std::uint32_t> mPubLedgerClose{0};
     std::atomic<LedgerIndex> mPubLedgerSeq{0};
     std::atomic<std::uint32_t> mValidLedgerSign{0};
@@ -399,6 +423,8 @@ private:
 
     TaggedCache<uint256, Blob> fetch_packs_;
 
+    LedgerFragmentCache fragmentCache_;
+
     std::uint32_t fetch_seq_{0};
 
     // Try to keep a validator from switching from test to live network
@@ -29,6 +29,7 @@
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/ledger/OpenView.h>
 #include <cassert>
+#include <cstdint>
 #include <mutex>
 
 namespace ripple {
@@ -43,6 +44,10 @@ namespace ripple {
 
 using OrderedTxs = CanonicalTXSet;
 
+namespace test {
+class OpenLedger_test;
+}
+
 //------------------------------------------------------------------------------
 
 /** Represents the open ledger. */
@@ -54,6 +59,11 @@ private:
     std::mutex mutable modify_mutex_;
     std::mutex mutable current_mutex_;
     std::shared_ptr<OpenView const> current_;
+    // Calls to accept are numbered when they take their snapshot. A new
+    // view is published only if no later call has published one already.
+    // Both are guarded by modify_mutex_.
+    std::uint64_t acceptsStarted_ = 0;
+    std::uint64_t lastAcceptPublished_ = 0;
 
 public:
     /** Signature for modification functions.
@@ -138,7 +148,12 @@ public:
             depending on the value of `retriesFirst`.
 
             The transactions in the current open view
-            are applied to the new open view.
+            are applied to the new open view. Calls to
+            modify are not blocked while this happens;
+            transactions added to the current open view
+            in the meantime are applied afterwards, while
+            the master and ledger master locks are held
+            to publish the new open view.
 
             The list of local transactions are applied
             to the new open view.
@@ -153,7 +168,8 @@ public:
             in `retries` for the caller.
 
             The current view is atomically set to the
-            new open view.
+            new open view, unless a call to accept that
+            started later has already replaced it.
 
         @param rules The rules for the open ledger
         @param ledger A new closed ledger
@@ -200,6 +216,8 @@ private:
         bool retry,
         ApplyFlags flags,
         beast::Journal j);
+
+    friend class test::OpenLedger_test;
 };
 
 //------------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Indexes.h>
+#include <algorithm>
 
 namespace ripple {
 
@@ -234,53 +235,62 @@ void
 OrderBookDB::processTxn(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& alTx,
-    Json::Value const& jvObj)
+    std::function<Json::Value const&()> const& getJson)
 {
-    std::lock_guard sl(mLock);
-
-    // For this particular transaction, maintain the set of unique
-    // subscriptions that have already published it.  This prevents sending
-    // the transaction multiple times if it touches multiple ltOFFER
-    // entries for the same book, or if it touches multiple books and a
-    // single client has subscribed to those books.
-    hash_set<std::uint64_t> havePublished;
-
-    for (auto const& node : alTx.getMeta().getNodes())
+    // Find the listeners of every book the transaction touches, then
+    // publish to them once the lock is released.
+    std::vector<BookListeners::pointer> books;
     {
-        try
+        std::lock_guard sl(mLock);
+
+        for (auto const& node : alTx.getMeta().getNodes())
         {
-            if (node.getFieldU16(sfLedgerEntryType) == ltOFFER)
+            try
             {
-                auto process = [&, this](SField const& field) {
-                    if (auto data = dynamic_cast<STObject const*>(
-                            node.peekAtPField(field));
-                        data && data->isFieldPresent(sfTakerPays) &&
-                        data->isFieldPresent(sfTakerGets))
-                    {
-                        auto listeners = getBookListeners(
-                            {data->getFieldAmount(sfTakerGets).issue(),
-                             data->getFieldAmount(sfTakerPays).issue()});
-                        if (listeners)
-                            listeners->publish(jvObj, havePublished);
-                    }
-                };
-
-                // We need a field that contains the TakerGets and TakerPays
-                // parameters.
-                if (node.getFName() == sfModifiedNode)
-                    process(sfPreviousFields);
-                else if (node.getFName() == sfCreatedNode)
-                    process(sfNewFields);
-                else if (node.getFName() == sfDeletedNode)
-                    process(sfFinalFields);
+                if (node.getFieldU16(sfLedgerEntryType) == ltOFFER)
+                {
+                    auto process = [&, this](SField const& field) {
+                        if (auto data = dynamic_cast<STObject const*>(
+                                node.peekAtPField(field));
+                            data && data->isFieldPresent(sfTakerPays) &&
+                            data->isFieldPresent(sfTakerGets))
+                        {
+                            auto listeners = getBookListeners(
+                                {data->getFieldAmount(sfTakerGets).issue(),
+                                 data->getFieldAmount(sfTakerPays).issue()});
+                            if (listeners &&
+                                std::find(
+                                    books.begin(), books.end(), listeners) ==
+                                    books.end())
+                                books.push_back(std::move(listeners));
+                        }
+                    };
+
+                    // We need a field that contains the TakerGets and
+                    // TakerPays parameters.
+                    if (node.getFName() == sfModifiedNode)
+                        process(sfPreviousFields);
+                    else if (node.getFName() == sfCreatedNode)
+                        process(sfNewFields);
+                    else if (node.getFName() == sfDeletedNode)
+                        process(sfFinalFields);
+                }
+            }
+            catch (std::exception const& ex)
+            {
+                JLOG(j_.info())
+                    << "processTxn: field not found (" << ex.what() << ")";
             }
-        }
-        catch (std::exception const& ex)
-        {
-            JLOG(j_.info())
-                << "processTxn: field not found (" << ex.what() << ")";
         }
     }
+
+    // For this particular transaction, maintain the set of unique
+    // subscriptions that have already published it.  This prevents sending
+    // the transaction multiple times if it touches multiple books and a
+    // single client has subscribed to those books.
+    hash_set<std::uint64_t> havePublished;
+    for (auto const& listeners : books)
+        listeners->publish(getJson(), havePublished);
 }
 
 }  // namespace ripple
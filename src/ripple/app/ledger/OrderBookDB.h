@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/AcceptedLedgerTx.h>
 #include <ripple/app/ledger/BookListeners.h>
 #include <ripple/app/main/Application.h>
+#include <functional>
 #include <mutex>
 
 namespace ripple {
@@ -58,12 +59,18 @@ public:
     BookListeners::pointer
     makeBookListeners(Book const&);
 
-    // see if this txn effects any orderbook
+    /** See if this txn effects any orderbook and publish it to the
+        listeners of every book it touches.
+
+        @param getJson returns the JSON to publish. It is only invoked if
+                       the transaction touches a book that has listeners,
+                       and never while the order book lock is held.
+    */
     void
     processTxn(
         std::shared_ptr<ReadView const> const& ledger,
         const AcceptedLedgerTx& alTx,
-        Json::Value const& jvObj);
+        std::function<Json::Value const&()> const& getJson);
 
 private:
     Application& app_;
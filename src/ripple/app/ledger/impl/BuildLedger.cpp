@@ -24,7 +24,11 @@
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/WorkerPool.h>
+#include <ripple/ledger/RecordingView.h>
 #include <ripple/protocol/Feature.h>
+#include <algorithm>
+#include <vector>
 
 namespace ripple {
 
@@ -81,38 +85,185 @@ buildLedgerImpl(
     return built;
 }
 
-/** Apply a set of consensus transactions to a ledger.
+namespace {
 
-  @param app Handle to application
-  @param txns the set of transactions to apply,
-  @param failed set of transactions that failed to apply
-  @param view ledger to apply to
-  @param j Journal for logging
-  @return number of transactions applied; transactions to retry left in txns
-*/
+// Forwards the changes made by a transaction applied on top of a view to
+// the view itself, remembering which state entries and transactions were
+// written so that later speculative reads can be checked against them.
+class CommitView : public TxsRawView
+{
+private:
+    OpenView& to_;
 
-std::size_t
-applyTransactions(
+public:
+    std::set<uint256> changed;
+    std::set<uint256> inserted;
+
+    explicit CommitView(OpenView& to) : to_(to)
+    {
+    }
+
+    void
+    rawErase(std::shared_ptr<SLE> const& sle) override
+    {
+        changed.insert(sle->key());
+        to_.rawErase(sle);
+    }
+
+    void
+    rawInsert(std::shared_ptr<SLE> const& sle) override
+    {
+        changed.insert(sle->key());
+        to_.rawInsert(sle);
+    }
+
+    void
+    rawReplace(std::shared_ptr<SLE> const& sle) override
+    {
+        changed.insert(sle->key());
+        to_.rawReplace(sle);
+    }
+
+    void
+    rawDestroyXRP(XRPAmount const& fee) override
+    {
+        to_.rawDestroyXRP(fee);
+    }
+
+    void
+    rawTxInsert(
+        uint256 const& key,
+        std::shared_ptr<Serializer const> const& txn,
+        std::shared_ptr<Serializer const> const& metaData) override
+    {
+        inserted.insert(key);
+
+        // The metadata records the position of the transaction in the
+        // ledger, which was not known when the transaction was applied.
+        auto const index = static_cast<std::uint32_t>(to_.txCount());
+        if (metaData)
+        {
+            STObject meta(SerialIter{metaData->slice()}, sfMetadata);
+            if (meta.getFieldU32(sfTransactionIndex) != index)
+            {
+                meta.setFieldU32(sfTransactionIndex, index);
+                auto s = std::make_shared<Serializer>();
+                meta.add(*s);
+                to_.rawTxInsert(key, txn, s);
+                return;
+            }
+        }
+        to_.rawTxInsert(key, txn, metaData);
+    }
+};
+
+// A transaction applied to a private view layered over the ledger being
+// built, along with a record of everything it read.
+struct Speculation
+{
+    explicit Speculation(ReadView const& base) : reads(base), view(&reads)
+    {
+    }
+
+    RecordingView reads;
+    OpenView view;
+    ApplyResult result = ApplyResult::Retry;
+};
+
+// Apply the transactions in one pass, one after the other.
+int
+applyPass(
     Application& app,
     std::shared_ptr<Ledger const> const& built,
     CanonicalTXSet& txns,
     std::set<TxID>& failed,
     OpenView& view,
+    int pass,
+    bool certainRetry,
     beast::Journal j)
 {
-    bool certainRetry = true;
-    std::size_t count = 0;
+    int changes = 0;
 
-    // Attempt to apply all of the retriable transactions
-    for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
+    auto it = txns.begin();
+
+    while (it != txns.end())
     {
-        JLOG(j.debug()) << (certainRetry ? "Pass: " : "Final pass: ") << pass
-                        << " begins (" << txns.size() << " transactions)";
-        int changes = 0;
+        auto const txid = it->first.getTXID();
+
+        try
+        {
+            if (pass == 0 && built->txExists(txid))
+            {
+                it = txns.erase(it);
+                continue;
+            }
+
+            switch (applyTransaction(
+                app, view, *it->second, certainRetry, tapNONE, j))
+            {
+                case ApplyResult::Success:
+                    it = txns.erase(it);
+                    ++changes;
+                    break;
+
+                case ApplyResult::Fail:
+                    failed.insert(txid);
+                    it = txns.erase(it);
+                    break;
+
+                case ApplyResult::Retry:
+                    ++it;
+            }
+        }
+        catch (std::exception const&)
+        {
+            JLOG(j.warn()) << "Transaction " << txid << " throws";
+            failed.insert(txid);
+            it = txns.erase(it);
+        }
+    }
+
+    return changes;
+}
+
+/* Apply the transactions in one pass, using several threads.
+
+   Transactions are taken in batches, in canonical order. Every transaction
+   in a batch, other than pseudo-transactions and all but the first from any
+   one account, is first applied speculatively and concurrently to a private
+   view of the ledger as it stood before the batch. The results are then
+   committed in canonical order. A transaction which read something that an
+   earlier transaction in the batch wrote is applied again on top of the
+   committed changes, so the outcome is exactly that of applyPass.
+*/
+int
+applyPassInParallel(
+    Application& app,
+    std::shared_ptr<Ledger const> const& built,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    int pass,
+    bool certainRetry,
+    std::size_t workers,
+    beast::Journal j)
+{
+    int changes = 0;
+    std::size_t reapplied = 0;
+
+    std::size_t const batchSize = workers * 8;
+    std::vector<CanonicalTXSet::const_iterator> batch;
+    std::vector<std::unique_ptr<Speculation>> speculations;
+    std::vector<std::size_t> jobs;
+    batch.reserve(batchSize);
+    jobs.reserve(batchSize);
 
-        auto it = txns.begin();
+    auto it = txns.begin();
 
-        while (it != txns.end())
+    while (it != txns.end())
+    {
+        batch.clear();
+        while (it != txns.end() && batch.size() < batchSize)
         {
             auto const txid = it->first.getTXID();
 
@@ -123,31 +274,145 @@ applyTransactions(
                     it = txns.erase(it);
                     continue;
                 }
+            }
+            catch (std::exception const&)
+            {
+                JLOG(j.warn()) << "Transaction " << txid << " throws";
+                failed.insert(txid);
+                it = txns.erase(it);
+                continue;
+            }
+
+            batch.push_back(it++);
+        }
+
+        // Only the first transaction from an account can be speculated:
+        // the ones after it depend on its changes to the account root.
+        jobs.clear();
+        {
+            std::set<uint256> accounts;
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                if (accounts.insert(batch[i]->first.getAccount()).second &&
+                    !isPseudoTx(*batch[i]->second))
+                    jobs.push_back(i);
+            }
+        }
+
+        speculations.clear();
+        speculations.resize(batch.size());
+
+        auto speculate = [&](std::size_t n) {
+            auto const i = jobs[n];
+            try
+            {
+                auto s = std::make_unique<Speculation>(view);
+                s->result = applyTransaction(
+                    app, s->view, *batch[i]->second, certainRetry, tapNONE, j);
+                speculations[i] = std::move(s);
+            }
+            catch (std::exception const&)
+            {
+                // The transaction is applied again below, where the
+                // exception is reported.
+            }
+        };
+
+        // The calling thread is one of the workers
+        WorkerPool::instance().forEach(jobs.size(), workers - 1, speculate);
+
+        CommitView commit(view);
+
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto const txid = batch[i]->first.getTXID();
+
+            try
+            {
+                auto& s = speculations[i];
+
+                if (!s || s->reads.conflicts(commit.changed, commit.inserted))
+                {
+                    if (s)
+                        ++reapplied;
+
+                    s = std::make_unique<Speculation>(view);
+                    s->result = applyTransaction(
+                        app, s->view, *batch[i]->second, certainRetry, tapNONE,
+                        j);
+                }
+
+                s->view.apply(commit);
 
-                switch (applyTransaction(
-                    app, view, *it->second, certainRetry, tapNONE, j))
+                switch (s->result)
                 {
                     case ApplyResult::Success:
-                        it = txns.erase(it);
+                        txns.erase(batch[i]);
                         ++changes;
                         break;
 
                     case ApplyResult::Fail:
                         failed.insert(txid);
-                        it = txns.erase(it);
+                        txns.erase(batch[i]);
                         break;
 
                     case ApplyResult::Retry:
-                        ++it;
+                        break;
                 }
             }
             catch (std::exception const&)
             {
                 JLOG(j.warn()) << "Transaction " << txid << " throws";
                 failed.insert(txid);
-                it = txns.erase(it);
+                txns.erase(batch[i]);
             }
         }
+    }
+
+    JLOG(j.debug()) << "Pass: " << pass << " reapplied " << reapplied
+                    << " transactions";
+
+    return changes;
+}
+
+}  // namespace
+
+/** Apply a set of consensus transactions to a ledger.
+
+  @param app Handle to application
+  @param txns the set of transactions to apply,
+  @param failed set of transactions that failed to apply
+  @param view ledger to apply to
+  @param j Journal for logging
+  @return number of transactions applied; transactions to retry left in txns
+*/
+
+std::size_t
+applyTransactions(
+    Application& app,
+    std::shared_ptr<Ledger const> const& built,
+    CanonicalTXSet& txns,
+    std::set<TxID>& failed,
+    OpenView& view,
+    beast::Journal j)
+{
+    bool certainRetry = true;
+    std::size_t count = 0;
+
+    auto const workers =
+        static_cast<std::size_t>(std::max(app.config().APPLY_WORKERS, 1));
+
+    // Attempt to apply all of the retriable transactions
+    for (int pass = 0; pass < LEDGER_TOTAL_PASSES; ++pass)
+    {
+        JLOG(j.debug()) << (certainRetry ? "Pass: " : "Final pass: ") << pass
+                        << " begins (" << txns.size() << " transactions)";
+
+        int const changes = (workers > 1)
+            ? applyPassInParallel(
+                  app, built, txns, failed, view, pass, certainRetry, workers,
+                  j)
+            : applyPass(app, built, txns, failed, view, pass, certainRetry, j);
 
         JLOG(j.debug()) << (certainRetry ? "Pass: " : "Final pass: ") << pass
                         << " completed (" << changes << " changes)";
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerFragmentCache.h>
+#include <ripple/protocol/digest.h>
+
+namespace ripple {
+
+namespace {
+
+// Keeps the keys of the two kinds of fragment apart
+enum class Fragment : std::uint8_t { nodes, fetchPack };
+
+}  // namespace
+
+LedgerFragmentCache::LedgerFragmentCache(std::size_t maxBytes)
+    : maxBytes_(maxBytes)
+{
+}
+
+uint256
+LedgerFragmentCache::nodeKey(
+    SHAMapHash const& map,
+    SHAMapNodeID const& node,
+    std::uint32_t depth,
+    bool fatLeaves)
+{
+    return sha512Half(
+        static_cast<std::uint8_t>(Fragment::nodes),
+        map.as_uint256(),
+        node.getNodeID(),
+        static_cast<std::uint8_t>(node.getDepth()),
+        depth,
+        fatLeaves);
+}
+
+uint256
+LedgerFragmentCache::fetchPackKey(uint256 const& ledgerHash)
+{
+    return sha512Half(
+        static_cast<std::uint8_t>(Fragment::fetchPack), ledgerHash);
+}
+
+std::shared_ptr<std::string const>
+LedgerFragmentCache::fetch(uint256 const& key)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = index_.find(key);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return {};
+    }
+
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->fragment;
+}
+
+void
+LedgerFragmentCache::insert(
+    uint256 const& key,
+    std::shared_ptr<std::string const> fragment)
+{
+    auto const bytes = fragment->size();
+    if (bytes > maxBytes_ / 4)
+        return;
+
+    std::lock_guard lock(mutex_);
+    if (index_.count(key) != 0)
+        return;
+
+    while (!entries_.empty() && bytes_ + bytes > maxBytes_)
+    {
+        auto const& last = entries_.back();
+        bytes_ -= last.fragment->size();
+        index_.erase(last.key);
+        entries_.pop_back();
+    }
+
+    entries_.push_front({key, std::move(fragment)});
+    index_.emplace(key, entries_.begin());
+    bytes_ += bytes;
+}
+
+std::size_t
+LedgerFragmentCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t
+LedgerFragmentCache::bytes() const
+{
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+double
+LedgerFragmentCache::getHitRate() const
+{
+    std::lock_guard lock(mutex_);
+    auto const total = hits_ + misses_;
+    return total == 0 ? 0.0 : hits_ * 100.0 / total;
+}
+
+}  // namespace ripple
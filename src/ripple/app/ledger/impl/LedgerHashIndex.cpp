@@ -0,0 +1,319 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/basics/Log.h>
+#include <boost/filesystem/fstream.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+namespace ripple {
+
+// Kept at the start of the file
+struct LedgerHashIndex::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    // Non-zero while the slots are being moved to a lower base
+    std::uint32_t moving;
+    std::uint32_t hasNetwork;
+    std::uint32_t networkID;
+    std::uint32_t base;
+    std::uint32_t reserved;
+};
+
+// Identifies the file format
+static char const magic[8] = {'L', 'G', 'R', 'H', 'A', 'S', 'H', 'I'};
+static std::uint32_t const version = 2;
+
+// The file grows by this many slots at a time, and the base is a
+// multiple of it
+static std::size_t const growSlots = 65536;
+
+LedgerHashIndex::LedgerHashIndex(
+    boost::filesystem::path const& path,
+    std::optional<std::uint32_t> networkID,
+    beast::Journal j)
+    : path_(path), networkID_(networkID), j_(j)
+{
+    if (path_.empty())
+        return;
+
+    try
+    {
+        using namespace boost::filesystem;
+
+        std::unique_lock lock(mutex_);
+
+        if (exists(path_) && file_size(path_) >= sizeof(Header) &&
+            (file_size(path_) - sizeof(Header)) % LedgerHash::bytes == 0)
+        {
+            map(0);
+
+            Header header;
+            std::memcpy(&header, region_.get_address(), sizeof(header));
+
+            if (std::memcmp(header.magic, magic, sizeof(magic)) == 0 &&
+                header.version == version && header.moving == 0 &&
+                (header.hasNetwork != 0) == networkID_.has_value() &&
+                (!networkID_ || header.networkID == *networkID_))
+            {
+                base_ = header.base;
+                map((file_size(path_) - sizeof(Header)) / LedgerHash::bytes);
+                return;
+            }
+
+            JLOG(j_.warn()) << "Discarding ledger hash index " << path_
+                            << " of another format or network";
+        }
+
+        create();
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "Unable to open ledger hash index " << path_
+                         << ": " << e.what();
+        region_ = {};
+        file_ = {};
+        slots_ = 0;
+        path_.clear();
+    }
+}
+
+LedgerHashIndex::~LedgerHashIndex()
+{
+    sync();
+}
+
+void
+LedgerHashIndex::create()
+{
+    region_ = {};
+    file_ = {};
+    boost::filesystem::ofstream{path_, std::ios::trunc};
+    base_ = 0;
+    map(0);
+    writeHeader(false);
+}
+
+void
+LedgerHashIndex::map(std::size_t slots)
+{
+    using namespace boost::interprocess;
+
+    auto const bytes = sizeof(Header) + slots * LedgerHash::bytes;
+    if (boost::filesystem::file_size(path_) < bytes)
+        boost::filesystem::resize_file(path_, bytes);
+
+    file_mapping file(path_.string().c_str(), read_write);
+    mapped_region region(file, read_write, 0, bytes);
+
+    file_.swap(file);
+    region_.swap(region);
+    slots_ = slots;
+}
+
+void
+LedgerHashIndex::rebase(LedgerIndex seq)
+{
+    assert(seq < base_);
+
+    // Move down at least as far as there are slots already, so that
+    // backfilling older and older ledgers moves the contents rarely
+    std::size_t shift = std::max<std::size_t>(base_ - seq, slots_);
+    shift = std::min<std::size_t>(
+        (shift + growSlots - 1) / growSlots * growSlots, base_);
+
+    // A file left with the moving flag set is discarded when opened
+    writeHeader(true);
+    region_.flush(0, sizeof(Header), false);
+
+    auto const slots = slots_;
+    map(slots + shift);
+    auto const data =
+        static_cast<unsigned char*>(region_.get_address()) + sizeof(Header);
+    std::memmove(
+        data + shift * LedgerHash::bytes, data, slots * LedgerHash::bytes);
+    std::memset(data, 0, shift * LedgerHash::bytes);
+    base_ -= shift;
+
+    region_.flush(0, 0, false);
+    writeHeader(false);
+}
+
+void
+LedgerHashIndex::writeHeader(bool moving)
+{
+    static_assert(sizeof(Header) == LedgerHash::bytes);
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.moving = moving ? 1 : 0;
+    header.hasNetwork = networkID_ ? 1 : 0;
+    header.networkID = networkID_.value_or(0);
+    header.base = base_;
+    std::memcpy(region_.get_address(), &header, sizeof(header));
+}
+
+unsigned char*
+LedgerHashIndex::slot(LedgerIndex seq) const
+{
+    return static_cast<unsigned char*>(region_.get_address()) +
+        sizeof(Header) + (seq - base_) * LedgerHash::bytes;
+}
+
+bool
+LedgerHashIndex::confirm(
+    std::vector<std::pair<LedgerIndex, LedgerHash>> const& known)
+{
+    if (!enabled())
+        return true;
+
+    std::unique_lock lock(mutex_);
+
+    std::size_t matched = 0;
+    std::size_t mismatched = 0;
+    for (auto const& [seq, hash] : known)
+    {
+        if (!contains(seq))
+            continue;
+
+        auto const indexed = LedgerHash::fromVoid(slot(seq));
+        if (indexed == hash)
+            ++matched;
+        else if (indexed.isNonZero())
+            ++mismatched;
+    }
+
+    bool const kept = (mismatched == 0);
+    if (!kept)
+    {
+        JLOG(j_.warn()) << "Discarding ledger hash index " << path_
+                        << ": it disagrees with the ledger database on "
+                        << mismatched << " of " << (matched + mismatched)
+                        << " ledgers";
+        try
+        {
+            create();
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.error()) << "Unable to clear ledger hash index "
+                             << path_ << ": " << e.what();
+            region_ = {};
+            file_ = {};
+            slots_ = 0;
+            return false;
+        }
+    }
+
+    for (auto const& [seq, hash] : known)
+        set(seq, hash);
+
+    JLOG(j_.debug()) << "Ledger hash index confirmed: " << matched
+                     << " of " << known.size() << " known ledgers matched";
+
+    confirmed_ = true;
+    return kept;
+}
+
+void
+LedgerHashIndex::insert(LedgerIndex seq, LedgerHash const& hash)
+{
+    if (!enabled())
+        return;
+
+    std::unique_lock lock(mutex_);
+    set(seq, hash);
+}
+
+void
+LedgerHashIndex::set(LedgerIndex seq, LedgerHash const& hash)
+{
+    if (seq == 0 || region_.get_size() == 0)
+        return;
+
+    try
+    {
+        if (slots_ == 0)
+        {
+            base_ = seq - seq % growSlots;
+            writeHeader(false);
+            map(growSlots);
+        }
+        else if (seq < base_)
+        {
+            rebase(seq);
+        }
+        else if (seq - base_ >= slots_)
+        {
+            map(((seq - base_) / growSlots + 1) * growSlots);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.error()) << "Unable to grow ledger hash index " << path_
+                         << ": " << e.what();
+        return;
+    }
+
+    if (contains(seq))
+        std::memcpy(slot(seq), hash.data(), LedgerHash::bytes);
+}
+
+std::optional<LedgerHash>
+LedgerHashIndex::get(LedgerIndex seq) const
+{
+    if (!confirmed_)
+        return std::nullopt;
+
+    std::shared_lock lock(mutex_);
+
+    if (!contains(seq))
+        return std::nullopt;
+
+    auto const hash = LedgerHash::fromVoid(slot(seq));
+    if (hash.isZero())
+        return std::nullopt;
+
+    return hash;
+}
+
+void
+LedgerHashIndex::erase(LedgerIndex seq)
+{
+    std::unique_lock lock(mutex_);
+
+    if (contains(seq))
+        std::memset(slot(seq), 0, LedgerHash::bytes);
+}
+
+void
+LedgerHashIndex::sync()
+{
+    std::shared_lock lock(mutex_);
+
+    if (region_.get_size() != 0)
+        region_.flush(0, 0, false);
+}
+
+}  // namespace ripple
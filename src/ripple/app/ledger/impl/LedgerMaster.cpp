@@ -37,6 +37,7 @@
 #include <ripple/app/rdb/RelationalDBInterface_postgres.h>
 #include <ripple/app/rdb/backend/RelationalDBInterfacePostgres.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/TaggedCache.h>
@@ -181,6 +182,19 @@ shouldAcquire(
     return ret;
 }
 
+static boost::filesystem::path
+hashIndexPath(Config const& config)
+{
+    // A standalone server may start a new chain on every run, and a
+    // reporting server keeps its ledgers in a shared database.
+    if (config.standalone() || config.reporting() ||
+        config.legacy("database_path").empty())
+        return {};
+
+    return boost::filesystem::path(config.legacy("database_path")) /
+        "ledger_hashes.idx";
+}
+
 LedgerMaster::LedgerMaster(
     Application& app,
     Stopwatch& stopwatch,
@@ -189,6 +203,10 @@ LedgerMaster::LedgerMaster(
     : app_(app)
     , m_journal(journal)
     , mLedgerHistory(collector, app)
+    , mHashIndex(
+          hashIndexPath(app.config()),
+          app.config().NETWORK_ID,
+          app.journal("LedgerHashIndex"))
     , standalone_(app_.config().standalone())
     , fetch_depth_(
           app_.getSHAMapStore().clampFetchDepth(app_.config().FETCH_DEPTH))
@@ -200,6 +218,8 @@ LedgerMaster::LedgerMaster(
           std::chrono::seconds{45},
           stopwatch,
           app_.journal("TaggedCache"))
+    , fragmentCache_(megabytes(
+          app_.config().getValueFor(SizedItem::ledgerFragmentCache)))
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
 }
@@ -530,6 +550,7 @@ LedgerMaster::switchLCL(std::shared_ptr<Ledger const> const& lastClosed)
 bool
 LedgerMaster::fixIndex(LedgerIndex ledgerIndex, LedgerHash const& ledgerHash)
 {
+    mHashIndex.insert(ledgerIndex, ledgerHash);
     return mLedgerHistory.fixIndex(ledgerIndex, ledgerHash);
 }
 
@@ -921,9 +942,25 @@ LedgerMaster::setFullLedger(
     ledger->setValidated();
     ledger->setFull();
 
+    mHashIndex.insert(ledger->info().seq, ledger->info().hash);
+    mHashIndex.insert(ledger->info().seq - 1, ledger->info().parentHash);
+
     if (isCurrent)
+    {
         mLedgerHistory.insert(ledger, true);
 
+        // Once, remember the headers and hashes of the ledgers we already had
+        if (!mLoadHeadersThread.test_and_set())
+        {
+            app_.getJobQueue().addJob(
+                jtLEDGER_DATA, "loadLedgerHeaders", [this, ledger]() {
+                    mLedgerHistory.loadHeaders(ledger->info().seq);
+                    indexSkipList(*ledger);
+                    checkHashIndex(ledger->info().seq);
+                });
+        }
+    }
+
     {
         // Check the SQL database's entry for the sequence before this
         // ledger, if it's not this ledger's parent, invalidate it
@@ -1309,6 +1346,52 @@ LedgerMaster::getLedgerHashForHistory(
     return ret;
 }
 
+void
+LedgerMaster::indexSkipList(ReadView const& ledger)
+{
+    if (!mHashIndex.enabled())
+        return;
+
+    auto const sle = ledger.read(keylet::skip());
+    if (!sle)
+        return;
+
+    // The last hash in the list is that of the ledger's parent
+    auto const& hashes = sle->getFieldV256(sfHashes);
+    auto seq = ledger.seq() - hashes.size();
+    for (auto const& hash : hashes)
+        mHashIndex.insert(seq++, hash);
+}
+
+void
+LedgerMaster::checkHashIndex(LedgerIndex seq)
+{
+    if (!mHashIndex.enabled())
+        return;
+
+    // How far back to check, and how many ledgers to query at once
+    LedgerIndex const depth = 65536;
+    LedgerIndex const chunk = 1024;
+
+    std::vector<std::pair<LedgerIndex, LedgerHash>> known;
+
+    for (auto max = seq - 1; max > 0 && seq - max <= depth;)
+    {
+        auto const min = max > chunk ? max - chunk + 1 : 1;
+        for (auto const& [index, hashes] :
+             app_.getRelationalDBInterface().getHashesByIndex(min, max))
+        {
+            known.emplace_back(index, hashes.ledgerHash);
+        }
+        max = min - 1;
+    }
+
+    // SQL is authoritative. An index that disagrees with it was built
+    // for another database, and is discarded and rebuilt.
+    mHashIndex.confirm(known);
+    mHashIndex.sync();
+}
+
 std::vector<std::shared_ptr<Ledger const>>
 LedgerMaster::findNewLedgersToPublish(
     std::unique_lock<std::recursive_mutex>& sl)
@@ -1746,7 +1829,17 @@ LedgerMaster::getHashBySeq(std::uint32_t index)
     if (hash.isNonZero())
         return hash;
 
-    return app_.getRelationalDBInterface().getHashByIndex(index);
+    if (index <= mValidLedgerSeq)
+    {
+        if (auto const indexed = mHashIndex.get(index))
+            return *indexed;
+    }
+
+    hash = app_.getRelationalDBInterface().getHashByIndex(index);
+    if (hash.isNonZero() && index <= mValidLedgerSeq)
+        mHashIndex.insert(index, hash);
+
+    return hash;
 }
 
 std::optional<LedgerHash>
@@ -1777,6 +1870,13 @@ LedgerMaster::walkHashBySeq(
     if (ledgerHash)
         return ledgerHash;
 
+    // See if we have recorded the hash of the validated ledger
+    if (index <= mValidLedgerSeq)
+    {
+        if ((ledgerHash = mHashIndex.get(index)))
+            return ledgerHash;
+    }
+
     // The hash is not in the reference ledger. Get another ledger which can
     // be located easily and should contain the hash.
     LedgerIndex refIndex = getCandidateLedger(index);
@@ -1792,6 +1892,7 @@ LedgerMaster::walkHashBySeq(
             try
             {
                 ledgerHash = hashOfSeq(*ledger, index, m_journal);
+                indexSkipList(*ledger);
             }
             catch (SHAMapMissingNode const&)
             {
@@ -1807,6 +1908,7 @@ LedgerMaster::walkHashBySeq(
             {
                 ledgerHash = hashOfSeq(*l, index, m_journal);
                 assert(ledgerHash);
+                indexSkipList(*l);
             }
         }
     }
@@ -2305,32 +2407,58 @@ LedgerMaster::makeFetchPack(
         //  4. If the FetchPack now contains at least 512 entries then stop.
         //  5. If not very much time has elapsed, then loop back and repeat
         //     the same process adding the previous ledger to the FetchPack.
+        //
+        // The objects added for a ledger only depend on that ledger and
+        // its child, so they are cached and shared by every peer asking.
         do
         {
             std::uint32_t lSeq = want->info().seq;
 
+            auto const key =
+                LedgerFragmentCache::fetchPackKey(have->info().hash);
+            auto fragment = fragmentCache_.fetch(key);
+
+            if (!fragment)
             {
-                // Serialize the ledger header:
-                hdr.erase();
-
-                hdr.add32(HashPrefix::ledgerMaster);
-                addRaw(want->info(), hdr);
-
-                // Add the data
-                protocol::TMIndexedObject* obj = reply.add_objects();
-                obj->set_hash(
-                    want->info().hash.data(), want->info().hash.size());
-                obj->set_data(hdr.getDataPtr(), hdr.getLength());
-                obj->set_ledgerseq(lSeq);
-            }
+                protocol::TMGetObjectByHash objects;
+
+                {
+                    // Serialize the ledger header:
+                    hdr.erase();
+
+                    hdr.add32(HashPrefix::ledgerMaster);
+                    addRaw(want->info(), hdr);
+
+                    // Add the data
+                    protocol::TMIndexedObject* obj = objects.add_objects();
+                    obj->set_hash(
+                        want->info().hash.data(), want->info().hash.size());
+                    obj->set_data(hdr.getDataPtr(), hdr.getLength());
+                    obj->set_ledgerseq(lSeq);
+                }
 
-            populateFetchPack(
-                want->stateMap(), &have->stateMap(), 16384, &reply, lSeq);
+                populateFetchPack(
+                    want->stateMap(),
+                    &have->stateMap(),
+                    16384,
+                    &objects,
+                    lSeq);
+
+                // We use nullptr here because transaction maps are per
+                // ledger and so the requestor is unlikely to already
+                // have it.
+                if (want->info().txHash.isNonZero())
+                    populateFetchPack(
+                        want->txMap(), nullptr, 512, &objects, lSeq);
+
+                auto s = std::make_shared<std::string>();
+                objects.SerializePartialToString(s.get());
+                fragment = s;
+                fragmentCache_.insert(key, std::move(s));
+            }
 
-            // We use nullptr here because transaction maps are per ledger
-            // and so the requestor is unlikely to already have it.
-            if (want->info().txHash.isNonZero())
-                populateFetchPack(want->txMap(), nullptr, 512, &reply, lSeq);
+            // The repeated objects are appended to those already present
+            reply.MergeFromString(*fragment);
 
             if (reply.objects().size() >= 512)
                 break;
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/OpenLedger.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/HashRouter.h>
@@ -31,6 +32,17 @@
 
 namespace ripple {
 
+// The transactions of an open view, without their metadata
+static auto
+transactions(OpenView const& view)
+{
+    return boost::adaptors::transform(
+        view.txs,
+        [](std::pair<
+            std::shared_ptr<STTx const>,
+            std::shared_ptr<STObject const>> const& p) { return p.first; });
+}
+
 OpenLedger::OpenLedger(
     std::shared_ptr<Ledger const> const& ledger,
     CachedSLEs& cache,
@@ -87,34 +99,86 @@ OpenLedger::accept(
         using empty = std::vector<std::shared_ptr<STTx const>>;
         apply(app, *next, *ledger, empty{}, retries, flags, j_);
     }
-    // Block calls to modify, otherwise
-    // new tx going into the open ledger
-    // would get lost.
-    std::lock_guard lock1(modify_mutex_);
-    // Apply tx from the current open view
-    if (!current_->txs.empty())
-    {
+
+    // Take a snapshot of the open view and re-apply its transactions
+    // without blocking calls to modify. New transactions keep going into
+    // the current open view while this happens and are carried over below.
+    // Nothing here needs a lock: the closed ledger, the snapshot and the
+    // new view are not visible to any other thread.
+    auto const [snapshot, acceptId] = [this] {
+        std::lock_guard lock(modify_mutex_);
+        return std::make_pair(current_, ++acceptsStarted_);
+    }();
+    if (!snapshot->txs.empty())
         apply(
             app,
             *next,
             *ledger,
-            boost::adaptors::transform(
-                current_->txs,
-                [](std::pair<
-                    std::shared_ptr<STTx const>,
-                    std::shared_ptr<STObject const>> const& p) {
-                    return p.first;
-                }),
+            transactions(*snapshot),
             retries,
             flags,
             j_);
+
+    {
+        // Publish the new view under the master and ledger master locks,
+        // which the callers of accept used to hold throughout. The switch
+        // of the open view therefore stays atomic with respect to
+        // NetworkOPs and LedgerMaster. Both locks are recursive, so callers
+        // that already hold them are unaffected.
+        std::unique_lock masterLock{app.getMasterMutex(), std::defer_lock};
+        std::unique_lock ledgerLock{
+            app.getLedgerMaster().peekMutex(), std::defer_lock};
+        std::lock(masterLock, ledgerLock);
+
+        // Block calls to modify, otherwise
+        // new tx going into the open ledger
+        // would get lost.
+        std::lock_guard lock1(modify_mutex_);
+        // An accept that started later, such as a jump to another closed
+        // ledger, may have published its view while we were rebuilding.
+        // That view supersedes this one.
+        if (acceptId < lastAcceptPublished_)
+        {
+            JLOG(j_.debug()) << "accept ledger " << ledger->seq()
+                             << " superseded by a later accept";
+            return;
+        }
+        lastAcceptPublished_ = acceptId;
+        // Apply tx that made it into the open view while we were busy,
+        // including any view installed by another accept. Transactions
+        // left in `retries` by the first pass were already retried.
+        if (current_ != snapshot)
+        {
+            std::vector<std::shared_ptr<STTx const>> added;
+            for (auto const& tx : transactions(*current_))
+            {
+                if (!snapshot->txExists(tx->getTransactionID()))
+                    added.push_back(tx);
+            }
+            JLOG(j_.debug()) << "accept: " << added.size()
+                             << " transaction(s) added during rebuild";
+            if (!added.empty())
+            {
+                OrderedTxs pending(retries.key());
+                apply(app, *next, *ledger, added, pending, flags, j_);
+                for (auto const& item : pending)
+                    retries.insert(item.second);
+            }
+        }
+        // Call the modifier
+        if (f)
+            f(*next, j_);
+        // Apply local tx. Those already in the new view can only fail.
+        for (auto const& item : locals)
+        {
+            if (!next->txExists(item.first.getTXID()))
+                app.getTxQ().apply(app, *next, item.second, flags, j_);
+        }
+
+        // Switch to the new open view
+        std::lock_guard lock2(current_mutex_);
+        current_ = next;
     }
-    // Call the modifier
-    if (f)
-        f(*next, j_);
-    // Apply local tx
-    for (auto const& item : locals)
-        app.getTxQ().apply(app, *next, item.second, flags, j_);
 
     // If we didn't relay this transaction recently, relay it to all peers
     for (auto const& txpair : next->txs)
@@ -135,10 +199,6 @@ OpenLedger::accept(
             app.overlay().relay(txId, msg, *toSkip);
         }
     }
-
-    // Switch to the new open view
-    std::lock_guard lock2(current_mutex_);
-    current_ = std::move(next);
 }
 
 //------------------------------------------------------------------------------
@@ -68,6 +68,8 @@
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STParsedJSON.h>
 #include <ripple/resource/Fees.h>
+#include <ripple/rpc/ObligationsIndex.h>
+#include <ripple/rpc/ResponseCache.h>
 #include <ripple/rpc/ShardArchiveHandler.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/shamap/NodeFamily.h>
@@ -195,6 +197,8 @@ public:
     // VFALCO TODO Make OrderBookDB abstract
     OrderBookDB m_orderBookDB;
     std::unique_ptr<PathRequests> m_pathRequests;
+    RPC::ResponseCache rpcResponseCache_;
+    RPC::ObligationsIndex obligationsIndex_;
     std::unique_ptr<LedgerMaster> m_ledgerMaster;
     std::unique_ptr<LedgerCleaner> ledgerCleaner_;
     std::unique_ptr<InboundLedgers> m_inboundLedgers;
@@ -368,6 +372,10 @@ public:
               logs_->journal("PathRequest"),
               m_collectorManager->collector()))
 
+        , rpcResponseCache_(config_->RPC_RESPONSE_CACHE)
+
+        , obligationsIndex_(config_->GATEWAY_BALANCES_INDEX)
+
         , m_ledgerMaster(std::make_unique<LedgerMaster>(
               *this,
               stopwatch(),
@@ -763,6 +771,18 @@ public:
         return *m_pathRequests;
     }
 
+    RPC::ResponseCache&
+    getRPCResponseCache() override
+    {
+        return rpcResponseCache_;
+    }
+
+    RPC::ObligationsIndex&
+    getObligationsIndex() override
+    {
+        return obligationsIndex_;
+    }
+
     CachedSLEs&
     cachedSLEs() override
     {
@@ -47,8 +47,10 @@ namespace perf {
 class PerfLog;
 }
 namespace RPC {
+class ObligationsIndex;
+class ResponseCache;
 class ShardArchiveHandler;
-}
+}  // namespace RPC
 
 // VFALCO TODO Fix forward declares required for header dependency loops
 class AmendmentTable;
@@ -241,6 +243,10 @@ public:
     getResourceManager() = 0;
     virtual PathRequests&
     getPathRequests() = 0;
+    virtual RPC::ResponseCache&
+    getRPCResponseCache() = 0;
+    virtual RPC::ObligationsIndex&
+    getObligationsIndex() = 0;
     virtual SHAMapStore&
     getSHAMapStore() = 0;
     virtual PendingSaves&
@@ -54,6 +54,7 @@
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/to_string.h>
 #include <ripple/net/RPCErr.h>
+#include <ripple/net/RPCSub.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/overlay/Cluster.h>
 #include <ripple/overlay/Overlay.h>
@@ -64,11 +65,13 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/DeliveredAmount.h>
+#include <ripple/rpc/ObligationsIndex.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 #include <boost/asio/ip/host_name.hpp>
 #include <boost/asio/steady_timer.hpp>
 
 #include <mutex>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -437,6 +440,8 @@ public:
     updateLocalTx(ReadView const& view) override;
     std::size_t
     getLocalTxCount() override;
+    void
+    getRpcSubCounts(Json::Value& obj) override;
 
     //
     // Monitoring: publisher side.
@@ -625,7 +630,8 @@ private:
     void
     pubAccountTransaction(
         std::shared_ptr<ReadView const> const& ledger,
-        AcceptedLedgerTx const& transaction);
+        AcceptedLedgerTx const& transaction,
+        std::function<Json::Value const&()> const& getJson);
 
     void
     pubProposedAccountTransaction(
@@ -2853,6 +2859,9 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
 
     assert(alpAccepted->getLedger().get() == lpAccepted.get());
 
+    if (auto& index = app_.getObligationsIndex(); index.enabled())
+        index.apply(*alpAccepted);
+
     {
         JLOG(m_journal.debug())
             << "Publishing ledger " << lpAccepted->info().seq << " "
@@ -3034,17 +3043,24 @@ NetworkOPsImp::pubValidatedTransaction(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& transaction)
 {
-    auto const& stTxn = transaction.getTxn();
-
-    Json::Value jvObj =
-        transJson(*stTxn, transaction.getResult(), true, ledger);
+    // Built on first use and shared by the transaction, book and account
+    // streams. It is never built while a subscription lock is held.
+    std::optional<Json::Value> jvObj;
+    auto const getJson = [&]() -> Json::Value const& {
+        if (!jvObj)
+        {
+            auto const& stTxn = transaction.getTxn();
+            auto const& meta = transaction.getMeta();
 
-    {
-        auto const& meta = transaction.getMeta();
-        jvObj[jss::meta] = meta.getJson(JsonOptions::none);
-        RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
-    }
+            jvObj = transJson(*stTxn, transaction.getResult(), true, ledger);
+            (*jvObj)[jss::meta] = meta.getJson(JsonOptions::none);
+            RPC::insertDeliveredAmount(
+                (*jvObj)[jss::meta], *ledger, stTxn, meta);
+        }
+        return *jvObj;
+    };
 
+    std::vector<InfoSub::pointer> notify;
     {
         std::lock_guard sl(mSubLock);
 
@@ -3055,7 +3071,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(jvObj, true);
+                notify.push_back(std::move(p));
                 ++it;
             }
             else
@@ -3070,7 +3086,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(jvObj, true);
+                notify.push_back(std::move(p));
                 ++it;
             }
             else
@@ -3078,16 +3094,20 @@ NetworkOPsImp::pubValidatedTransaction(
         }
     }
 
+    for (auto const& p : notify)
+        p->send(getJson(), true);
+
     if (transaction.getResult() == tesSUCCESS)
-        app_.getOrderBookDB().processTxn(ledger, transaction, jvObj);
+        app_.getOrderBookDB().processTxn(ledger, transaction, getJson);
 
-    pubAccountTransaction(ledger, transaction);
+    pubAccountTransaction(ledger, transaction, getJson);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
     std::shared_ptr<ReadView const> const& ledger,
-    AcceptedLedgerTx const& transaction)
+    AcceptedLedgerTx const& transaction,
+    std::function<Json::Value const&()> const& getJson)
 {
     hash_set<InfoSub::pointer> notify;
     int iProposed = 0;
@@ -3178,22 +3198,13 @@ NetworkOPsImp::pubAccountTransaction(
         << "pubAccountTransaction: "
         << "proposed=" << iProposed << ", accepted=" << iAccepted;
 
-    if (!notify.empty() || !accountHistoryNotify.empty())
-    {
-        auto const& stTxn = transaction.getTxn();
-
-        Json::Value jvObj =
-            transJson(*stTxn, transaction.getResult(), true, ledger);
-
-        {
-            auto const& meta = transaction.getMeta();
+    for (InfoSub::ref isrListener : notify)
+        isrListener->send(getJson(), true);
 
-            jvObj[jss::meta] = meta.getJson(JsonOptions::none);
-            RPC::insertDeliveredAmount(jvObj[jss::meta], *ledger, stTxn, meta);
-        }
-
-        for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
+    if (!accountHistoryNotify.empty())
+    {
+        // The history stream annotates the object, so work on a copy
+        Json::Value jvObj = getJson();
 
         assert(!jvObj.isMember(jss::account_history_tx_stream));
         for (auto& info : accountHistoryNotify)
@@ -4078,6 +4089,22 @@ NetworkOPsImp::tryRemoveRpcSub(std::string const& strUrl)
     return true;
 }
 
+void
+NetworkOPsImp::getRpcSubCounts(Json::Value& obj)
+{
+    std::lock_guard sl(mSubLock);
+
+    if (mRpcSubMap.empty())
+        return;
+
+    Json::Value& jv = (obj[jss::rpc_sub_dropped] = Json::objectValue);
+    for (auto const& [url, sub] : mRpcSubMap)
+    {
+        if (auto const rpcSub = std::dynamic_pointer_cast<RPCSub>(sub))
+            jv[url] = std::to_string(rpcSub->dropped());
+    }
+}
+
 #ifndef USE_NEW_BOOK_PAGE
 
 // NIKB FIXME this should be looked at. There's no reason why this shouldn't
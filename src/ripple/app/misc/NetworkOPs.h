@@ -247,6 +247,12 @@ public:
     virtual std::size_t
     getLocalTxCount() = 0;
 
+    /** Adds the events dropped by each URL subscription to a get_counts
+        result.
+    */
+    virtual void
+    getRpcSubCounts(Json::Value& obj) = 0;
+
     //--------------------------------------------------------------------------
     //
     // Monitoring: publisher side
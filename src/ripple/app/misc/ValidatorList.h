@@ -23,6 +23,8 @@
 #include <ripple/app/misc/Manifest.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/beast/container/aged_unordered_map.h>
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/crypto/csprng.h>
 #include <ripple/json/json_value.h>
@@ -48,6 +50,9 @@ class Message;
 class NetworkOPs;
 class Peer;
 class STValidation;
+namespace test {
+class ValidatorList_test;
+}  // namespace test
 
 /* Entries in this enum are ordered by "desirability".
    The "better" dispositions have lower values than the
@@ -221,6 +226,24 @@ class ValidatorList
         std::uint32_t rawVersion = 0;
     };
 
+    // A published list whose signature has been checked
+    struct VerifiedBlob
+    {
+        // The publisher signing key the signature was checked against
+        PublicKey signingKey;
+        // The decoded list
+        Json::Value list;
+    };
+
+    // A publisher manifest that came with a list, and the result of
+    // applying it
+    struct AppliedManifest
+    {
+        PublicKey masterKey;
+        bool revoked;
+        ManifestDisposition disposition;
+    };
+
     ManifestCache& validatorManifests_;
     ManifestCache& publisherManifests_;
     TimeKeeper& timeKeeper_;
@@ -239,6 +262,9 @@ class ValidatorList
     // Listed master public keys with the number of lists they appear on
     hash_map<PublicKey, std::size_t> keyListings_;
 
+    // Listed master keys added or removed since the last updateTrusted
+    hash_set<PublicKey> listingChanges_;
+
     // The current list of trusted master keys
     hash_set<PublicKey> trustedMasterKeys_;
 
@@ -260,6 +286,19 @@ class ValidatorList
     // Prefix of the file name used to store cache files.
     static const std::string filePrefix_;
 
+    // Lists whose signature was recently checked, by hash of the blob and
+    // signature. The same lists are relayed by many peers and refetched
+    // from the publisher sites, so most are seen more than once.
+    std::mutex mutable verifiedBlobsMutex_;
+    beast::aged_unordered_map<
+        uint256,
+        std::shared_ptr<VerifiedBlob const>,
+        Stopwatch::clock_type,
+        hardened_hash<strong_hash>> mutable verifiedBlobs_;
+    // How long a checked list is remembered, longer than the default
+    // interval between fetches from a publisher site
+    static constexpr std::chrono::minutes verifiedBlobLifetime{15};
+
 public:
     ValidatorList(
         ManifestCache& validatorManifests,
@@ -748,6 +787,8 @@ private:
         @param hash Optional hash of the data parameters.
             Defaults to uninitialized
 
+        @param verified The result of calling verifyBlob for the list
+
         @return `ListDisposition::accepted`, plus some of the publisher
             information, if list was successfully applied
 
@@ -764,6 +805,8 @@ private:
         std::uint32_t version,
         std::string siteUri,
         std::optional<uint256> const& hash,
+        std::optional<AppliedManifest> const& applied,
+        std::shared_ptr<VerifiedBlob const> const& verified,
         lock_guard const&);
 
     void
@@ -841,8 +884,49 @@ private:
     void
     cacheValidatorFile(lock_guard const& lock, PublicKey const& pubKey) const;
 
+    /** Apply the manifest that came with a published list
+
+        Checking the signature of a new manifest costs as much as checking
+        a list, so this is done before the mutex is locked. The result is
+        acted upon by verify.
+
+        @return The result, or nothing if the manifest is malformed or
+        not of a configured publisher
+
+        @par Thread Safety
+
+        May be called concurrently. Must not be called with the mutex locked.
+    */
+    std::optional<AppliedManifest>
+    applyPublisherManifest(std::string const& manifest);
+
+    /** Check the signature of a published list and decode it
+
+        This does the expensive part of the work of verify, so that it can
+        be done before the mutex is locked. The signature is checked against
+        the signing key in the manifest, which verify later compares to the
+        publisher's current signing key.
+
+        @return The decoded list, or `nullptr` if the publisher is not
+        trusted or the signature is not valid
+
+        @par Thread Safety
+
+        May be called concurrently. Must not be called with the mutex locked.
+    */
+    std::shared_ptr<VerifiedBlob const>
+    verifyBlob(
+        std::string const& manifest,
+        std::string const& blob,
+        std::string const& signature) const;
+
     /** Check response for trusted valid published list
 
+        @param applied The result of calling applyPublisherManifest for the
+        manifest of the list
+
+        @param verified The result of calling verifyBlob for the list
+
         @return `ListDisposition::accepted` if list can be applied
 
         @par Thread Safety
@@ -854,9 +938,10 @@ private:
         lock_guard const&,
         Json::Value& list,
         PublicKey& pubKey,
-        std::string const& manifest,
+        std::optional<AppliedManifest> const& applied,
         std::string const& blob,
-        std::string const& signature);
+        std::string const& signature,
+        std::shared_ptr<VerifiedBlob const> const& verified);
 
     /** Stop trusting publisher's list of keys.
 
@@ -889,6 +974,8 @@ private:
         std::size_t unlSize,
         std::size_t effectiveUnlSize,
         std::size_t seenSize);
+
+    friend class test::ValidatorList_test;
 };
 
 // hashing helpers
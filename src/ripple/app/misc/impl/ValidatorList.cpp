@@ -33,6 +33,7 @@
 #include <boost/regex.hpp>
 
 #include <cmath>
+#include <map>
 #include <mutex>
 #include <numeric>
 #include <shared_mutex>
@@ -129,6 +130,7 @@ ValidatorList::ValidatorList(
     , j_(j)
     , quorum_(minimumQuorum.value_or(1))  // Genesis ledger quorum
     , minimumQuorum_(minimumQuorum)
+    , verifiedBlobs_(stopwatch())
 {
 }
 
@@ -196,7 +198,10 @@ ValidatorList::load(
 
     // Treat local validator key as though it was listed in the config
     if (localPubKey_.size())
+    {
         keyListings_.insert({localPubKey_, 1});
+        listingChanges_.insert(localPubKey_);
+    }
 
     JLOG(j_.debug()) << "Loading configured validator keys";
 
@@ -231,6 +236,7 @@ ValidatorList::load(
             JLOG(j_.warn()) << "Duplicate node identity: " << match[1];
             continue;
         }
+        listingChanges_.insert(*id);
         auto [it, inserted] = publisherLists_.emplace();
         // Config listed keys never expire
         auto& current = it->second.current;
@@ -932,11 +938,30 @@ ValidatorList::applyLists(
             version) != 1)
         return PublisherListStats{ListDisposition::unsupported_version};
 
+    // Check the signatures of the manifests and lists before locking the
+    // mutex, so that lists received from several peers and sites are
+    // checked concurrently rather than one at a time.
+    std::map<std::string, std::optional<AppliedManifest>> manifests;
+    std::vector<std::optional<AppliedManifest>> applied;
+    std::vector<std::shared_ptr<VerifiedBlob const>> verified;
+    applied.reserve(blobs.size());
+    verified.reserve(blobs.size());
+    for (auto const& blobInfo : blobs)
+    {
+        auto const& m = blobInfo.manifest ? *blobInfo.manifest : manifest;
+        auto [iter, inserted] = manifests.try_emplace(m);
+        if (inserted)
+            iter->second = applyPublisherManifest(m);
+        applied.push_back(iter->second);
+        verified.push_back(verifyBlob(m, blobInfo.blob, blobInfo.signature));
+    }
+
     std::lock_guard lock{mutex_};
 
     PublisherListStats result;
-    for (auto const& blobInfo : blobs)
+    for (std::size_t i = 0; i < blobs.size(); ++i)
     {
+        auto const& blobInfo = blobs[i];
         auto stats = applyList(
             manifest,
             blobInfo.manifest,
@@ -945,6 +970,8 @@ ValidatorList::applyLists(
             version,
             siteUri,
             hash,
+            applied[i],
+            verified[i],
             lock);
 
         if (stats.bestDisposition() < result.bestDisposition() ||
@@ -1010,7 +1037,8 @@ ValidatorList::updatePublisherList(
             (iNew != publisherList.end() && *iNew < *iOld))
         {
             // Increment list count for added keys
-            ++keyListings_[*iNew];
+            if (++keyListings_[*iNew] == 1)
+                listingChanges_.insert(*iNew);
             ++iNew;
         }
         else if (
@@ -1019,7 +1047,10 @@ ValidatorList::updatePublisherList(
         {
             // Decrement list count for removed keys
             if (keyListings_[*iOld] <= 1)
+            {
                 keyListings_.erase(*iOld);
+                listingChanges_.insert(*iOld);
+            }
             else
                 --keyListings_[*iOld];
             ++iOld;
@@ -1065,14 +1096,16 @@ ValidatorList::applyList(
     std::uint32_t version,
     std::string siteUri,
     std::optional<uint256> const& hash,
+    std::optional<AppliedManifest> const& applied,
+    std::shared_ptr<VerifiedBlob const> const& verified,
     ValidatorList::lock_guard const& lock)
 {
     using namespace std::string_literals;
 
     Json::Value list;
     PublicKey pubKey;
-    auto const& manifest = localManifest ? *localManifest : globalManifest;
-    auto const result = verify(lock, list, pubKey, manifest, blob, signature);
+    auto const result =
+        verify(lock, list, pubKey, applied, blob, signature, verified);
     if (result > ListDisposition::pending)
     {
         if (publisherLists_.count(pubKey))
@@ -1255,24 +1288,91 @@ ValidatorList::loadLists()
     return sites;
 }
 
+std::optional<ValidatorList::AppliedManifest>
+ValidatorList::applyPublisherManifest(std::string const& manifest)
+{
+    auto m = deserializeManifest(base64_decode(manifest));
+    if (!m)
+        return std::nullopt;
+
+    {
+        // Keep manifests of unknown publishers out of the cache
+        std::shared_lock read_lock{mutex_};
+        if (!publisherLists_.count(m->masterKey))
+            return std::nullopt;
+    }
+
+    auto const masterKey = m->masterKey;
+    auto const revoked = m->revoked();
+    return AppliedManifest{
+        masterKey, revoked, publisherManifests_.applyManifest(std::move(*m))};
+}
+
+std::shared_ptr<ValidatorList::VerifiedBlob const>
+ValidatorList::verifyBlob(
+    std::string const& manifest,
+    std::string const& blob,
+    std::string const& signature) const
+{
+    auto const m = deserializeManifest(base64_decode(manifest));
+    if (!m || m->revoked())
+        return {};
+
+    {
+        // The set of publishers is fixed once the configuration is loaded.
+        // Checking it first keeps lists from unknown publishers out of the
+        // cache.
+        std::shared_lock read_lock{mutex_};
+        if (!publisherLists_.count(m->masterKey))
+            return {};
+    }
+
+    auto const key = sha512Half(blob, signature);
+    {
+        std::lock_guard lock{verifiedBlobsMutex_};
+        if (auto const iter = verifiedBlobs_.find(key);
+            iter != verifiedBlobs_.end() &&
+            iter->second->signingKey == m->signingKey)
+        {
+            verifiedBlobs_.touch(iter);
+            return iter->second;
+        }
+    }
+
+    auto const sig = strUnHex(signature);
+    auto const data = base64_decode(blob);
+    if (!sig ||
+        !ripple::verify(m->signingKey, makeSlice(data), makeSlice(*sig)))
+        return {};
+
+    auto verified = std::make_shared<VerifiedBlob>();
+    verified->signingKey = m->signingKey;
+    Json::Reader r;
+    if (!r.parse(data, verified->list))
+        return {};
+
+    std::lock_guard lock{verifiedBlobsMutex_};
+    expire(verifiedBlobs_, verifiedBlobLifetime);
+    verifiedBlobs_[key] = verified;
+    return verified;
+}
+
 ListDisposition
 ValidatorList::verify(
     ValidatorList::lock_guard const& lock,
     Json::Value& list,
     PublicKey& pubKey,
-    std::string const& manifest,
+    std::optional<AppliedManifest> const& applied,
     std::string const& blob,
-    std::string const& signature)
+    std::string const& signature,
+    std::shared_ptr<VerifiedBlob const> const& verified)
 {
-    auto m = deserializeManifest(base64_decode(manifest));
-
-    if (!m || !publisherLists_.count(m->masterKey))
+    if (!applied || !publisherLists_.count(applied->masterKey))
         return ListDisposition::untrusted;
 
-    pubKey = m->masterKey;
-    auto const revoked = m->revoked();
-
-    auto const result = publisherManifests_.applyManifest(std::move(*m));
+    pubKey = applied->masterKey;
+    auto const revoked = applied->revoked;
+    auto const result = applied->disposition;
 
     if (revoked && result == ManifestDisposition::accepted)
     {
@@ -1284,18 +1384,26 @@ ValidatorList::verify(
     if (revoked || result == ManifestDisposition::invalid)
         return ListDisposition::untrusted;
 
-    auto const sig = strUnHex(signature);
-    auto const data = base64_decode(blob);
-    if (!sig ||
-        !ripple::verify(
-            publisherManifests_.getSigningKey(pubKey),
-            makeSlice(data),
-            makeSlice(*sig)))
-        return ListDisposition::invalid;
+    // The list was checked against the signing key in the manifest it came
+    // with. Only check it again if the publisher has since moved to a newer
+    // key.
+    auto const signingKey = publisherManifests_.getSigningKey(pubKey);
+    if (verified && verified->signingKey == signingKey)
+    {
+        list = verified->list;
+    }
+    else
+    {
+        auto const sig = strUnHex(signature);
+        auto const data = base64_decode(blob);
+        if (!sig ||
+            !ripple::verify(signingKey, makeSlice(data), makeSlice(*sig)))
+            return ListDisposition::invalid;
 
-    Json::Reader r;
-    if (!r.parse(data, list))
-        return ListDisposition::invalid;
+        Json::Reader r;
+        if (!r.parse(data, list))
+            return ListDisposition::invalid;
+    }
 
     if (list.isMember(jss::sequence) && list[jss::sequence].isInt() &&
         list.isMember(jss::expiration) && list[jss::expiration].isInt() &&
@@ -1438,7 +1546,10 @@ ValidatorList::removePublisherList(
             continue;
 
         if (iVal->second <= 1)
+        {
+            listingChanges_.insert(iVal->first);
             keyListings_.erase(iVal);
+        }
         else
             --iVal->second;
     }
@@ -1854,10 +1965,15 @@ ValidatorList::updateTrusted(
 
     TrustChanges trustChanges;
 
+    // Only keys whose listing changed since the last update can join or
+    // leave the trusted set, except that a trusted key may be revoked at
+    // any time. A revoked key stays revoked, so it never needs to be
+    // reconsidered.
     auto it = trustedMasterKeys_.cbegin();
     while (it != trustedMasterKeys_.cend())
     {
-        if (!keyListings_.count(*it) || validatorManifests_.revoked(*it))
+        if ((listingChanges_.count(*it) && !keyListings_.count(*it)) ||
+            validatorManifests_.revoked(*it))
         {
             trustChanges.removed.insert(calcNodeID(*it));
             it = trustedMasterKeys_.erase(it);
@@ -1868,12 +1984,13 @@ ValidatorList::updateTrusted(
         }
     }
 
-    for (auto const& val : keyListings_)
+    for (auto const& key : listingChanges_)
     {
-        if (!validatorManifests_.revoked(val.first) &&
-            trustedMasterKeys_.emplace(val.first).second)
-            trustChanges.added.insert(calcNodeID(val.first));
+        if (keyListings_.count(key) && !validatorManifests_.revoked(key) &&
+            trustedMasterKeys_.emplace(key).second)
+            trustChanges.added.insert(calcNodeID(key));
     }
+    listingChanges_.clear();
 
     // If there were any changes, we need to update the ephemeral signing
     // keys:
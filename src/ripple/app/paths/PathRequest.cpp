@@ -470,6 +470,7 @@ PathRequest::getPathFinder(
     Currency const& currency,
     STAmount const& dst_amount,
     int const level,
+    std::optional<std::chrono::steady_clock::time_point> const& deadline,
     std::function<bool(void)> const& continueCallback)
 {
     auto i = currency_map.find(currency);
@@ -484,6 +485,8 @@ PathRequest::getPathFinder(
         dst_amount,
         saSendMax,
         app_);
+    if (deadline)
+        pathfinder->setDeadline(*deadline);
     if (pathfinder->findPaths(level, continueCallback))
         pathfinder->computePathRanks(max_paths_, continueCallback);
     else
@@ -519,12 +522,28 @@ PathRequest::findPaths(
         }
     }
 
+    using namespace std::chrono;
+
+    // The search time is shared between the source currencies
+    std::optional<steady_clock::time_point> deadline;
+    if (auto const searchTime = app_.config().PATH_SEARCH_TIME;
+        searchTime != milliseconds::zero())
+        deadline = steady_clock::now() + searchTime;
+    auto issuesLeft = sourceCurrencies.size();
+
     auto const dst_amount = convertAmount(saDstAmount, convert_all_);
     hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
     for (auto const& issue : sourceCurrencies)
     {
         if (continueCallback && !continueCallback())
             break;
+
+        std::optional<steady_clock::time_point> issueDeadline;
+        if (deadline)
+            issueDeadline =
+                shareDeadline(*deadline, steady_clock::now(), issuesLeft);
+        --issuesLeft;
+
         JLOG(m_journal.debug())
             << iIdentifier
             << " Trying to find paths: " << STAmount(issue, 1).getFullText();
@@ -535,6 +554,7 @@ PathRequest::findPaths(
             issue.currency,
             dst_amount,
             level,
+            issueDeadline,
             continueCallback);
         if (!pathfinder)
         {
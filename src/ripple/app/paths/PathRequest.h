@@ -117,6 +117,7 @@ private:
         Currency const&,
         STAmount const&,
         int const,
+        std::optional<std::chrono::steady_clock::time_point> const&,
         std::function<bool(void)> const&);
 
     /** Finds and sets a PathSet in the JSON argument.
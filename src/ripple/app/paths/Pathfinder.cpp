@@ -23,6 +23,8 @@
 #include <ripple/app/paths/RippleCalc.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/app/paths/impl/PathfinderUtils.h>
+#include <ripple/app/paths/impl/Steps.h>
+#include <ripple/app/paths/impl/StrandFlow.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/join.h>
 #include <ripple/core/Config.h>
@@ -191,6 +193,15 @@ Pathfinder::Pathfinder(
     assert(!uSrcIssuer || isXRP(uSrcCurrency) == isXRP(uSrcIssuer.value()));
 }
 
+void
+Pathfinder::setDeadline(std::chrono::steady_clock::time_point deadline)
+{
+    // The search and the ranking share the time
+    searchDeadline_ =
+        shareDeadline(deadline, std::chrono::steady_clock::now(), 2);
+    rankDeadline_ = deadline;
+}
+
 bool
 Pathfinder::findPaths(
     int searchLevel,
@@ -317,16 +328,32 @@ Pathfinder::findPaths(
         paymentType = pt_nonXRP_to_nonXRP;
     }
 
+    // Past the search deadline, keep the paths found so far. The first
+    // path type searched is always completed, so some paths are found.
+    bool searched = false;
+    std::function<bool(void)> const keepSearching = [&]() {
+        if (continueCallback && !continueCallback())
+            return false;
+        return !searched || !searchDeadline_ ||
+            std::chrono::steady_clock::now() < *searchDeadline_;
+    };
+
     // Now iterate over all paths for that paymentType.
     for (auto const& costedPath : mPathTable[paymentType])
     {
         if (continueCallback && !continueCallback())
             return false;
+        if (!keepSearching())
+        {
+            JLOG(j_.debug()) << "findPaths: search deadline reached";
+            break;
+        }
         // Only use paths with at most the current search level.
         if (costedPath.searchLevel <= searchLevel)
         {
             JLOG(j_.trace()) << "findPaths trying payment type " << paymentType;
-            addPathsForType(costedPath.type, continueCallback);
+            addPathsForType(costedPath.type, keepSearching);
+            searched = true;
 
             if (mCompletePaths.size() > PATHFINDER_MAX_COMPLETE_PATHS)
                 break;
@@ -509,31 +536,52 @@ Pathfinder::rankPaths(
         return largestAmount(mDstAmount);
     }();
 
-    for (int i = 0; i < paths.size(); ++i)
+    // With a deadline, compute the liquidity of the most promising paths
+    // first, so that the best paths are ranked if it is reached.
+    std::vector<int> order;
+    if (rankDeadline_)
+        order = orderPaths(paths);
+    else
+    {
+        for (int i = 0; i < paths.size(); ++i)
+        {
+            if (!paths[i].empty())
+                order.push_back(i);
+        }
+    }
+
+    int evaluated = 0;
+    for (auto const i : order)
     {
         if (continueCallback && !continueCallback())
             return;
+        if (rankDeadline_ && evaluated > maxPaths &&
+            std::chrono::steady_clock::now() >= *rankDeadline_)
+        {
+            JLOG(j_.debug()) << "findPaths: rank deadline reached after "
+                             << evaluated << " of " << paths.size()
+                             << " paths";
+            break;
+        }
+        ++evaluated;
+
         auto const& currentPath = paths[i];
-        if (!currentPath.empty())
+        STAmount liquidity;
+        uint64_t uQuality;
+        auto const resultCode = getPathLiquidity(
+            currentPath, saMinDstAmount, liquidity, uQuality);
+        if (resultCode != tesSUCCESS)
         {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity(
-                currentPath, saMinDstAmount, liquidity, uQuality);
-            if (resultCode != tesSUCCESS)
-            {
-                JLOG(j_.debug())
-                    << "findPaths: dropping : " << transToken(resultCode)
-                    << ": " << currentPath.getJson(JsonOptions::none);
-            }
-            else
-            {
-                JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
-                                 << currentPath.getJson(JsonOptions::none);
+            JLOG(j_.debug()) << "findPaths: dropping : "
+                             << transToken(resultCode) << ": "
+                             << currentPath.getJson(JsonOptions::none);
+        }
+        else
+        {
+            JLOG(j_.debug()) << "findPaths: quality: " << uQuality << ": "
+                             << currentPath.getJson(JsonOptions::none);
 
-                rankedPaths.push_back(
-                    {uQuality, currentPath.size(), liquidity, i});
-            }
+            rankedPaths.push_back({uQuality, currentPath.size(), liquidity, i});
         }
     }
 
@@ -563,6 +611,70 @@ Pathfinder::rankPaths(
         });
 }
 
+std::vector<int>
+Pathfinder::orderPaths(STPathSet const& paths) const
+{
+    // Build the strands the way RippleCalc does
+    bool const ownerPaysTransferFee =
+        mLedger->rules().enabled(featureOwnerPaysFee);
+    std::optional<Issue> sendMaxIssue;
+    if (mSrcAmount >= beast::zero ||
+        mSrcAmount.getCurrency() != mDstAmount.getCurrency() ||
+        mSrcAmount.getIssuer() != mSrcAccount)
+        sendMaxIssue = mSrcAmount.issue();
+
+    std::vector<std::pair<Quality, int>> bounded;
+    std::vector<int> unbounded;
+    for (int i = 0; i < paths.size(); ++i)
+    {
+        if (paths[i].empty())
+            continue;
+
+        try
+        {
+            auto const [ter, strand] = toStrand(
+                *mLedger,
+                mSrcAccount,
+                mDstAccount,
+                mDstAmount.issue(),
+                std::nullopt,
+                sendMaxIssue,
+                paths[i],
+                ownerPaysTransferFee,
+                /* offerCrossing */ false,
+                j_);
+            if (ter == tesSUCCESS)
+            {
+                if (auto const q = qualityUpperBound(*mLedger, strand))
+                    bounded.emplace_back(*q, i);
+                else
+                    JLOG(j_.debug())
+                        << "findPaths: dropping dry path: "
+                        << paths[i].getJson(JsonOptions::none);
+                continue;
+            }
+        }
+        catch (std::exception const&)
+        {
+        }
+
+        // The liquidity computation reports why the path is invalid
+        unbounded.push_back(i);
+    }
+
+    std::stable_sort(
+        bounded.begin(), bounded.end(), [](auto const& a, auto const& b) {
+            return a.first > b.first;
+        });
+
+    std::vector<int> ordered;
+    ordered.reserve(bounded.size() + unbounded.size());
+    for (auto const& b : bounded)
+        ordered.push_back(b.second);
+    ordered.insert(ordered.end(), unbounded.begin(), unbounded.end());
+    return ordered;
+}
+
 STPathSet
 Pathfinder::getBestPaths(
     int maxPaths,
@@ -27,8 +27,14 @@
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STPathSet.h>
 
+#include <chrono>
+
 namespace ripple {
 
+namespace test {
+class Path_test;
+}  // namespace test
+
 /** Calculates payment paths.
 
     The @ref RippleCalc determines the quality of the found paths.
@@ -56,6 +62,18 @@ public:
     static void
     initPathTable();
 
+    /** Bound the time spent finding and ranking paths.
+
+        The first half of the time is spent finding paths. Past that, the
+        search stops once the first path type is searched, and the paths
+        found so far are ranked, most promising first, until the deadline.
+        Once more than the maximum number of paths are ranked, the paths
+        left are dropped. Without a deadline, paths are ranked in the
+        order they were found.
+    */
+    void
+    setDeadline(std::chrono::steady_clock::time_point deadline);
+
     bool
     findPaths(
         int searchLevel,
@@ -192,6 +210,11 @@ private:
         std::vector<PathRank>& rankedPaths,
         std::function<bool(void)> const& continueCallback);
 
+    // Order the indexes of the non-empty paths by an upper bound on their
+    // quality, best first. Paths through an empty order book are dropped.
+    std::vector<int>
+    orderPaths(STPathSet const& paths) const;
+
     AccountID mSrcAccount;
     AccountID mDstAccount;
     AccountID mEffectiveDst;  // The account the paths need to end at
@@ -215,6 +238,9 @@ private:
 
     hash_map<Issue, int> mPathsOutCountMap;
 
+    std::optional<std::chrono::steady_clock::time_point> searchDeadline_;
+    std::optional<std::chrono::steady_clock::time_point> rankDeadline_;
+
     Application& app_;
     beast::Journal const j_;
 
@@ -232,6 +258,8 @@ private:
 
     // Destination account only
     static std::uint32_t const afAC_LAST = 0x080;
+
+    friend class test::Path_test;
 };
 
 }  // namespace ripple
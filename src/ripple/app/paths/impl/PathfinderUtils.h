@@ -21,6 +21,8 @@
 #define RIPPLE_PATH_IMPL_PATHFINDERUTILS_H_INCLUDED
 
 #include <ripple/protocol/STAmount.h>
+#include <algorithm>
+#include <chrono>
 
 namespace ripple {
 
@@ -48,6 +50,17 @@ convertAllCheck(STAmount const& a)
     return a == largestAmount(a);
 }
 
+// The deadline of the next of `searches` searches which evenly share the
+// time left before `deadline`
+inline std::chrono::steady_clock::time_point
+shareDeadline(
+    std::chrono::steady_clock::time_point deadline,
+    std::chrono::steady_clock::time_point now,
+    std::size_t searches)
+{
+    return now + (std::max(deadline, now) - now) / searches;
+}
+
 }  // namespace ripple
 
 #endif
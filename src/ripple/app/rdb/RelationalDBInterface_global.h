@@ -328,6 +328,19 @@ savePeerFinderDB(
     soci::session& session,
     std::vector<PeerFinder::Store::Entry> const& v);
 
+/**
+ * @brief savePeerFinderDBChanges Updates changed entries of peer finder DB
+ *        and deletes removed ones.
+ * @param session Session with database.
+ * @param changed Entries which were added or changed.
+ * @param removed Addresses of entries which were removed.
+ */
+void
+savePeerFinderDBChanges(
+    soci::session& session,
+    std::vector<PeerFinder::Store::Entry> const& changed,
+    std::vector<beast::IP::Endpoint> const& removed);
+
 }  // namespace ripple
 
 #endif
@@ -383,6 +383,20 @@ getNewestAccountTxsB(
     std::optional<int> const& limit_used,
     beast::Journal j);
 
+/**
+ * @brief accountTxPageSize Returns the number of transactions a search for
+ *        a page of transactions of an account returns at most.
+ * @param options Struct AccountTxPageOptions which contain the number of
+ *        transactions to return and flag if this number unlimited.
+ * @param page_length Total number of transactions to return if the number
+ *        requested is unlimited or too large.
+ * @return Number of transactions.
+ */
+std::uint32_t
+accountTxPageSize(
+    RelationalDBInterface::AccountTxPageOptions const& options,
+    std::uint32_t page_length);
+
 /**
  * @brief oldestAccountTxPage Searches oldest transactions for given
  *        account which match given criteria starting from given marker
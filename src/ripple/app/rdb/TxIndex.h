@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_RDB_TXINDEX_H_INCLUDED
+#define RIPPLE_APP_RDB_TXINDEX_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/Protocol.h>
+#include <boost/filesystem.hpp>
+#include <nudb/nudb.hpp>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+
+namespace ripple {
+
+/**
+ * @brief An on-disk index from the hash of each validated transaction to
+ *        the ledger which holds it and the key of its leaf node in the
+ *        node store, so a lookup needs one hash probe and one node store
+ *        read instead of a query on the transaction database.
+ *
+ *        The index is kept in NuDB databases, which are append-only.
+ *        Deleting old transactions starts a new database and removes the
+ *        one before it, so that at most two are kept: the one being
+ *        written and the one holding the ledgers before it.
+ */
+class TxIndex
+{
+public:
+    struct Entry
+    {
+        LedgerIndex ledgerSeq;
+        uint256 nodeKey;
+    };
+
+    /**
+     * @brief TxIndex Opens the index, if any, stored in given directory.
+     * @param dir Directory of the index.
+     * @param j Journal.
+     */
+    TxIndex(boost::filesystem::path const& dir, beast::Journal j);
+
+    ~TxIndex();
+
+    TxIndex(TxIndex const&) = delete;
+    TxIndex&
+    operator=(TxIndex const&) = delete;
+
+    /**
+     * @brief insert Adds a validated transaction to the index.
+     * @param txID Hash of the transaction.
+     * @param entry Ledger sequence and node store key of the transaction.
+     */
+    void
+    insert(uint256 const& txID, Entry const& entry);
+
+    /**
+     * @brief fetch Looks up a transaction in the index.
+     * @param txID Hash of the transaction.
+     * @return The entry of the transaction, or none if the transaction
+     *         is not indexed or its ledger was deleted.
+     */
+    std::optional<Entry>
+    fetch(uint256 const& txID) const;
+
+    /**
+     * @brief deleteBefore Forgets the transactions of the ledgers with
+     *        sequences lower than given one.
+     * @param ledgerSeq Ledger sequence.
+     */
+    void
+    deleteBefore(LedgerIndex ledgerSeq);
+
+private:
+    struct Generation
+    {
+        // The lowest ledger sequence written when the database was created
+        LedgerIndex firstSeq;
+        boost::filesystem::path path;
+        nudb::store db;
+    };
+
+    std::unique_ptr<Generation>
+    open(boost::filesystem::path const& path, LedgerIndex firstSeq);
+
+    void
+    close(std::unique_ptr<Generation>& gen, bool remove);
+
+    static void
+    insert(Generation& gen, uint256 const& txID, Entry const& entry);
+
+    static std::optional<Entry>
+    fetch(Generation& gen, uint256 const& txID);
+
+    boost::filesystem::path const dir_;
+    beast::Journal const j_;
+
+    std::shared_mutex mutable mutex_;
+    std::unique_ptr<Generation> current_;
+    std::unique_ptr<Generation> archive_;
+    LedgerIndex minSeq_ = 0;
+};
+
+}  // namespace ripple
+
+#endif
@@ -26,6 +26,7 @@
 #include <ripple/app/rdb/RelationalDBInterface_nodes.h>
 #include <ripple/app/rdb/RelationalDBInterface_postgres.h>
 #include <ripple/app/rdb/RelationalDBInterface_shards.h>
+#include <ripple/app/rdb/TxIndex.h>
 #include <ripple/app/rdb/backend/RelationalDBInterfaceSqlite.h>
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/basics/StringUtilities.h>
@@ -33,9 +34,15 @@
 #include <ripple/core/SociDB.h>
 #include <ripple/json/to_string.h>
 #include <ripple/nodestore/DatabaseShard.h>
+#include <ripple/shamap/SHAMapLeafNode.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <soci/sqlite3/soci-sqlite3.h>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace ripple {
 
@@ -73,6 +80,12 @@ public:
             Throw<std::runtime_error>(
                 "Shard meta database initialization failed.");
         }
+
+        if (useTxTables_ && config.useTxIndex() && !setup.dataDir.empty())
+        {
+            txIndex_ = std::make_unique<TxIndex>(
+                setup.dataDir / "txindex", app_.journal("TxIndex"));
+        }
     }
 
     std::optional<LedgerIndex>
@@ -197,6 +210,7 @@ private:
     beast::Journal j_;
     std::unique_ptr<DatabaseCon> lgrdb_, txdb_;
     std::unique_ptr<DatabaseCon> lgrMetaDB_, txMetaDB_;
+    std::unique_ptr<TxIndex> txIndex_;
 
     /**
      * @brief makeLedgerDBs Opens node ledger and transaction databases,
@@ -226,6 +240,25 @@ private:
         DatabaseCon::Setup const& setup,
         DatabaseCon::CheckpointerSetup const& checkpointerSetup);
 
+    /**
+     * @brief indexTransactions Adds the transactions of a validated ledger
+     *        to the transaction index.
+     * @param ledger The ledger.
+     */
+    void
+    indexTransactions(Ledger const& ledger);
+
+    /**
+     * @brief loadIndexedTransaction Reads a transaction found in the
+     *        transaction index from the node store.
+     * @param id Hash of the transaction.
+     * @param entry Entry of the transaction in the index.
+     * @return The transaction and its metadata, or none if the node
+     *         store no longer holds the transaction.
+     */
+    std::optional<AccountTx>
+    loadIndexedTransaction(uint256 const& id, TxIndex::Entry const& entry);
+
     /**
      * @brief seqToShardIndex Converts ledgers sequence to shard index.
      * @param ledgerSeq Ledger sequence.
@@ -383,7 +416,7 @@ private:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback)
     {
-        return app_.getShardStore()->iterateLedgerSQLsForward(
+        return app_.getShardStore()->iterateTransactionSQLsForward(
             firstIndex, callback);
     }
 
@@ -427,9 +460,113 @@ private:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback)
     {
-        return app_.getShardStore()->iterateLedgerSQLsBack(
+        return app_.getShardStore()->iterateTransactionSQLsBack(
             firstIndex, callback);
     }
+
+    /**
+     * @brief queryLedgerForward Runs given query on the ledger databases of
+     *        all shards concurrently, starting from given shard index, and
+     *        passes the results to given merge function in ascending order
+     *        of shard index until it returns false.
+     * @param firstIndex Start shard index to visit or none if all shards
+     *        should be visited.
+     * @param query Function called with a session, returning the result.
+     * @param merge Function called with each result.
+     * @return True if each merge function returned true, false otherwise.
+     */
+    template <class Query, class Merge>
+    bool
+    queryLedgerForward(
+        std::optional<std::uint32_t> firstIndex,
+        Query const& query,
+        Merge const& merge)
+    {
+        return queryForward(
+            &NodeStore::DatabaseShard::queryLedgerSQLsForward,
+            firstIndex,
+            query,
+            merge);
+    }
+
+    /**
+     * @brief queryTransactionForward Runs given query on the transaction
+     *        databases of all shards concurrently, starting from given shard
+     *        index, and passes the results to given merge function in
+     *        ascending order of shard index until it returns false.
+     * @param firstIndex Start shard index to visit or none if all shards
+     *        should be visited.
+     * @param query Function called with a session, returning the result.
+     * @param merge Function called with each result.
+     * @return True if each merge function returned true, false otherwise.
+     */
+    template <class Query, class Merge>
+    bool
+    queryTransactionForward(
+        std::optional<std::uint32_t> firstIndex,
+        Query const& query,
+        Merge const& merge)
+    {
+        return queryForward(
+            &NodeStore::DatabaseShard::queryTransactionSQLsForward,
+            firstIndex,
+            query,
+            merge);
+    }
+
+    template <class Method, class Query, class Merge>
+    bool
+    queryForward(
+        Method method,
+        std::optional<std::uint32_t> firstIndex,
+        Query const& query,
+        Merge const& merge)
+    {
+        using Result = std::invoke_result_t<Query, soci::session&>;
+
+        // Results of the queries that haven't been merged yet
+        std::mutex mutex;
+        std::map<std::uint32_t, Result> results;
+
+        return (app_.getShardStore()->*method)(
+            firstIndex,
+            [&](soci::session& session, std::uint32_t shardIndex) {
+                auto result = query(session);
+                std::lock_guard lock(mutex);
+                results.emplace(shardIndex, std::move(result));
+            },
+            [&](std::uint32_t shardIndex) {
+                auto node = [&] {
+                    std::lock_guard lock(mutex);
+                    return results.extract(shardIndex);
+                }();
+                return !node.empty() && merge(std::move(node.mapped()));
+            });
+    }
+
+    /**
+     * @brief accountTxPageShards Searches the transaction databases of the
+     *        shards for a page of transactions of an account. The shard with
+     *        the marker, if any, is searched first. The shards that follow
+     *        are then searched concurrently for a full page each, and the
+     *        results are merged in order. The shard on which the page ends
+     *        is searched again for the transactions that are still needed.
+     * @param options Struct AccountTxPageOptions which contain criteria to
+     *        match.
+     * @param page_length Total number of transactions to return.
+     * @param forward True for ascending order, false for descending.
+     * @param onTransaction Callback function to call on each found
+     *        transaction, in order.
+     * @return Marker for next search if search not finished.
+     */
+    std::optional<AccountTxMarker>
+    accountTxPageShards(
+        AccountTxPageOptions const& options,
+        std::uint32_t page_length,
+        bool forward,
+        std::function<
+            void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+            onTransaction);
 };
 
 bool
@@ -615,6 +752,9 @@ RelationalDBInterfaceSqliteImp::deleteTransactionsBeforeLedgerSeq(
     if (!useTxTables_)
         return;
 
+    if (txIndex_)
+        txIndex_->deleteBefore(ledgerSeq);
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -676,9 +816,13 @@ RelationalDBInterfaceSqliteImp::getTransactionCount()
     if (shardStoreExists())
     {
         std::size_t rows = 0;
-        iterateTransactionForward(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                rows += ripple::getRows(session, TableType::Transactions);
+        queryTransactionForward(
+            {},
+            [](soci::session& session) {
+                return ripple::getRows(session, TableType::Transactions);
+            },
+            [&](std::size_t r) {
+                rows += r;
                 return true;
             });
         return rows;
@@ -702,10 +846,14 @@ RelationalDBInterfaceSqliteImp::getAccountTransactionCount()
     if (shardStoreExists())
     {
         std::size_t rows = 0;
-        iterateTransactionForward(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                rows +=
-                    ripple::getRows(session, TableType::AccountTransactions);
+        queryTransactionForward(
+            {},
+            [](soci::session& session) {
+                return ripple::getRows(
+                    session, TableType::AccountTransactions);
+            },
+            [&](std::size_t r) {
+                rows += r;
                 return true;
             });
         return rows;
@@ -726,9 +874,12 @@ RelationalDBInterfaceSqliteImp::getLedgerCountMinMax()
     if (shardStoreExists())
     {
         CountMinMax res{0, 0, 0};
-        iterateLedgerForward(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                auto r = ripple::getRowsMinMax(session, TableType::Ledgers);
+        queryLedgerForward(
+            {},
+            [](soci::session& session) {
+                return ripple::getRowsMinMax(session, TableType::Ledgers);
+            },
+            [&](CountMinMax const& r) {
                 if (r.numberOfRows)
                 {
                     res.numberOfRows += r.numberOfRows;
@@ -754,6 +905,9 @@ RelationalDBInterfaceSqliteImp::saveValidatedLedger(
         if (!ripple::saveValidatedLedger(
                 *lgrdb_, *txdb_, app_, ledger, current))
             return false;
+
+        if (txIndex_)
+            indexTransactions(*ledger);
     }
 
     if (auto shardStore = app_.getShardStore(); shardStore)
@@ -1276,6 +1430,170 @@ RelationalDBInterfaceSqliteImp::getNewestAccountTxsB(
     return {};
 }
 
+std::optional<RelationalDBInterface::AccountTxMarker>
+RelationalDBInterfaceSqliteImp::accountTxPageShards(
+    AccountTxPageOptions const& options,
+    std::uint32_t page_length,
+    bool forward,
+    std::function<
+        void(std::uint32_t, std::string const&, Blob&&, Blob&&)> const&
+        onTransaction)
+{
+    auto& idCache = app_.accountIDCache();
+    auto onUnsavedLedger =
+        std::bind(saveLedgerAsync, std::ref(app_), std::placeholders::_1);
+    auto const searchPage =
+        forward ? &ripple::oldestAccountTxPage : &ripple::newestAccountTxPage;
+    auto const pageSize = accountTxPageSize(options, page_length);
+
+    auto const inRange = [&](std::uint32_t shardIndex) {
+        if (forward)
+            return options.maxLedger == UINT32_MAX ||
+                shardIndex <= seqToShardIndex(options.maxLedger);
+        return !options.minLedger ||
+            shardIndex >= seqToShardIndex(options.minLedger);
+    };
+
+    AccountTxPageOptions opt = options;
+    int limit_used = 0;
+    auto const visit = [&](soci::session& session, std::uint32_t shardIndex) {
+        if (!inRange(shardIndex))
+            return false;
+        auto [marker, total] = searchPage(
+            session,
+            idCache,
+            onUnsavedLedger,
+            onTransaction,
+            opt,
+            limit_used,
+            page_length);
+        opt.marker = marker;
+        if (total < 0)
+            return false;
+        limit_used += total;
+        return true;
+    };
+    auto const iterate = [&](std::optional<std::uint32_t> firstIndex) {
+        if (forward)
+            return iterateTransactionForward(firstIndex, visit);
+        return iterateTransactionBack(firstIndex, visit);
+    };
+
+    std::optional<std::uint32_t> firstIndex;
+    if (forward && opt.minLedger)
+        firstIndex = seqToShardIndex(opt.minLedger);
+    else if (!forward && opt.maxLedger != UINT32_MAX)
+        firstIndex = seqToShardIndex(opt.maxLedger);
+
+    // The marker only applies to the first shard searched
+    if (opt.marker)
+    {
+        bool more = false;
+        auto const first = [&](soci::session& session,
+                               std::uint32_t shardIndex) {
+            more = visit(session, shardIndex) && !opt.marker &&
+                (forward || shardIndex > 0);
+            firstIndex = forward ? shardIndex + 1 : shardIndex - 1;
+            return false;
+        };
+        if (forward)
+            iterateTransactionForward(firstIndex, first);
+        else
+            iterateTransactionBack(firstIndex, first);
+
+        if (!more)
+            return opt.marker;
+    }
+
+    // Transactions found in a shard, kept until it is merged
+    struct Found
+    {
+        std::vector<std::uint32_t> unsaved;
+        std::vector<std::tuple<std::uint32_t, std::string, Blob, Blob>> txns;
+        std::optional<AccountTxMarker> marker;
+    };
+
+    std::mutex mutex;
+    std::map<std::uint32_t, Found> results;
+    std::optional<std::uint32_t> resumeIndex;
+
+    auto const query = [&, search = opt](
+                           soci::session& session, std::uint32_t shardIndex) {
+        Found found;
+        if (inRange(shardIndex))
+        {
+            found.marker = searchPage(
+                               session,
+                               idCache,
+                               [&found](std::uint32_t ledgerSeq) {
+                                   found.unsaved.push_back(ledgerSeq);
+                               },
+                               [&found](
+                                   std::uint32_t ledgerSeq,
+                                   std::string const& status,
+                                   Blob&& rawTxn,
+                                   Blob&& rawMeta) {
+                                   found.txns.emplace_back(
+                                       ledgerSeq,
+                                       status,
+                                       std::move(rawTxn),
+                                       std::move(rawMeta));
+                               },
+                               search,
+                               0,
+                               page_length)
+                               .first;
+        }
+
+        std::lock_guard lock(mutex);
+        results.emplace(shardIndex, std::move(found));
+    };
+
+    auto const merge = [&](std::uint32_t shardIndex) {
+        if (!inRange(shardIndex))
+            return false;
+
+        auto node = [&] {
+            std::lock_guard lock(mutex);
+            return results.extract(shardIndex);
+        }();
+        if (node.empty())
+            return false;
+        auto& found = node.mapped();
+
+        // Each shard was searched for a full page. Unless the page ends
+        // on this shard, that finds what searching for the rest would.
+        if (limit_used > 0 &&
+            (found.marker || limit_used + found.txns.size() > pageSize))
+        {
+            resumeIndex = shardIndex;
+            return false;
+        }
+
+        for (auto const ledgerSeq : found.unsaved)
+            onUnsavedLedger(ledgerSeq);
+        for (auto& [ledgerSeq, status, rawTxn, rawMeta] : found.txns)
+            onTransaction(
+                ledgerSeq, status, std::move(rawTxn), std::move(rawMeta));
+
+        limit_used += found.txns.size();
+        opt.marker = found.marker;
+        return !opt.marker;
+    };
+
+    if (forward)
+        app_.getShardStore()->queryTransactionSQLsForward(
+            firstIndex, query, merge);
+    else
+        app_.getShardStore()->queryTransactionSQLsBack(
+            firstIndex, query, merge);
+
+    if (resumeIndex)
+        iterate(resumeIndex);
+
+    return opt.marker;
+}
+
 std::pair<
     RelationalDBInterface::AccountTxs,
     std::optional<RelationalDBInterface::AccountTxMarker>>
@@ -1316,31 +1634,9 @@ RelationalDBInterfaceSqliteImp::oldestAccountTxPage(
 
     if (shardStoreExists())
     {
-        AccountTxPageOptions opt = options;
-        int limit_used = 0;
-        iterateTransactionForward(
-            opt.minLedger ? seqToShardIndex(opt.minLedger)
-                          : std::optional<std::uint32_t>(),
-            [&](soci::session& session, std::uint32_t shardIndex) {
-                if (opt.maxLedger != UINT32_MAX &&
-                    shardIndex > seqToShardIndex(opt.minLedger))
-                    return false;
-                auto [marker, total] = ripple::oldestAccountTxPage(
-                    session,
-                    idCache,
-                    onUnsavedLedger,
-                    onTransaction,
-                    opt,
-                    limit_used,
-                    page_length);
-                opt.marker = marker;
-                if (total < 0)
-                    return false;
-                limit_used += total;
-                return true;
-            });
-
-        return {ret, opt.marker};
+        auto const marker = accountTxPageShards(
+            options, page_length, true, onTransaction);
+        return {ret, marker};
     }
 
     return {};
@@ -1386,31 +1682,9 @@ RelationalDBInterfaceSqliteImp::newestAccountTxPage(
 
     if (shardStoreExists())
     {
-        AccountTxPageOptions opt = options;
-        int limit_used = 0;
-        iterateTransactionBack(
-            opt.maxLedger != UINT32_MAX ? seqToShardIndex(opt.maxLedger)
-                                        : std::optional<std::uint32_t>(),
-            [&](soci::session& session, std::uint32_t shardIndex) {
-                if (opt.minLedger &&
-                    shardIndex < seqToShardIndex(opt.minLedger))
-                    return false;
-                auto [marker, total] = ripple::newestAccountTxPage(
-                    session,
-                    idCache,
-                    onUnsavedLedger,
-                    onTransaction,
-                    opt,
-                    limit_used,
-                    page_length);
-                opt.marker = marker;
-                if (total < 0)
-                    return false;
-                limit_used += total;
-                return true;
-            });
-
-        return {ret, opt.marker};
+        auto const marker = accountTxPageShards(
+            options, page_length, false, onTransaction);
+        return {ret, marker};
     }
 
     return {};
@@ -1455,31 +1729,9 @@ RelationalDBInterfaceSqliteImp::oldestAccountTxPageB(
 
     if (shardStoreExists())
     {
-        AccountTxPageOptions opt = options;
-        int limit_used = 0;
-        iterateTransactionForward(
-            opt.minLedger ? seqToShardIndex(opt.minLedger)
-                          : std::optional<std::uint32_t>(),
-            [&](soci::session& session, std::uint32_t shardIndex) {
-                if (opt.maxLedger != UINT32_MAX &&
-                    shardIndex > seqToShardIndex(opt.minLedger))
-                    return false;
-                auto [marker, total] = ripple::oldestAccountTxPage(
-                    session,
-                    idCache,
-                    onUnsavedLedger,
-                    onTransaction,
-                    opt,
-                    limit_used,
-                    page_length);
-                opt.marker = marker;
-                if (total < 0)
-                    return false;
-                limit_used += total;
-                return true;
-            });
-
-        return {ret, opt.marker};
+        auto const marker = accountTxPageShards(
+            options, page_length, true, onTransaction);
+        return {ret, marker};
     }
 
     return {};
@@ -1524,31 +1776,9 @@ RelationalDBInterfaceSqliteImp::newestAccountTxPageB(
 
     if (shardStoreExists())
     {
-        AccountTxPageOptions opt = options;
-        int limit_used = 0;
-        iterateTransactionBack(
-            opt.maxLedger != UINT32_MAX ? seqToShardIndex(opt.maxLedger)
-                                        : std::optional<std::uint32_t>(),
-            [&](soci::session& session, std::uint32_t shardIndex) {
-                if (opt.minLedger &&
-                    shardIndex < seqToShardIndex(opt.minLedger))
-                    return false;
-                auto [marker, total] = ripple::newestAccountTxPage(
-                    session,
-                    idCache,
-                    onUnsavedLedger,
-                    onTransaction,
-                    opt,
-                    limit_used,
-                    page_length);
-                opt.marker = marker;
-                if (total < 0)
-                    return false;
-                limit_used += total;
-                return true;
-            });
-
-        return {ret, opt.marker};
+        auto const marker = accountTxPageShards(
+            options, page_length, false, onTransaction);
+        return {ret, marker};
     }
 
     return {};
@@ -1563,6 +1793,15 @@ RelationalDBInterfaceSqliteImp::getTransaction(
     if (!useTxTables_)
         return TxSearched::unknown;
 
+    if (txIndex_)
+    {
+        if (auto const entry = txIndex_->fetch(id))
+        {
+            if (auto txn = loadIndexedTransaction(id, *entry))
+                return std::move(*txn);
+        }
+    }
+
     if (existsTransaction())
     {
         auto db = checkoutTransaction();
@@ -1603,6 +1842,56 @@ RelationalDBInterfaceSqliteImp::getTransaction(
     return TxSearched::unknown;
 }
 
+void
+RelationalDBInterfaceSqliteImp::indexTransactions(Ledger const& ledger)
+{
+    auto const seq = ledger.info().seq;
+    for (auto const& item : ledger.txMap())
+    {
+        SHAMapHash hash;
+        if (ledger.txMap().peekItem(item.key(), hash))
+            txIndex_->insert(item.key(), {seq, hash.as_uint256()});
+    }
+}
+
+std::optional<RelationalDBInterface::AccountTx>
+RelationalDBInterfaceSqliteImp::loadIndexedTransaction(
+    uint256 const& id,
+    TxIndex::Entry const& entry)
+{
+    try
+    {
+        auto const object = app_.getNodeStore().fetchNodeObject(
+            entry.nodeKey, entry.ledgerSeq);
+        if (!object)
+            return std::nullopt;
+
+        auto const leaf = std::dynamic_pointer_cast<SHAMapLeafNode>(
+            SHAMapTreeNode::makeFromPrefix(
+                makeSlice(object->getData()), SHAMapHash{entry.nodeKey}));
+        if (!leaf || leaf->getType() != SHAMapNodeType::tnTRANSACTION_MD ||
+            leaf->peekItem()->key() != id)
+            return std::nullopt;
+
+        auto const [sttx, meta] = deserializeTxPlusMeta(*leaf->peekItem());
+
+        std::string reason;
+        auto txn = std::make_shared<Transaction>(sttx, reason, app_);
+        txn->setStatus(COMMITTED);
+        txn->setLedger(entry.ledgerSeq);
+
+        return AccountTx{
+            std::move(txn),
+            std::make_shared<TxMeta>(id, entry.ledgerSeq, *meta)};
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Unable to load indexed transaction " << id << ": "
+                        << e.what();
+    }
+    return std::nullopt;
+}
+
 bool
 RelationalDBInterfaceSqliteImp::ledgerDbHasSpace(Config const& config)
 {
@@ -1657,9 +1946,13 @@ RelationalDBInterfaceSqliteImp::getKBUsedAll()
     if (shardStoreExists())
     {
         std::uint32_t sum = 0;
-        iterateLedgerBack(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                sum += ripple::getKBUsedAll(session);
+        queryLedgerForward(
+            {},
+            [](soci::session& session) {
+                return ripple::getKBUsedAll(session);
+            },
+            [&](std::uint32_t kb) {
+                sum += kb;
                 return true;
             });
         return sum;
@@ -1679,9 +1972,11 @@ RelationalDBInterfaceSqliteImp::getKBUsedLedger()
     if (shardStoreExists())
     {
         std::uint32_t sum = 0;
-        iterateLedgerBack(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                sum += ripple::getKBUsedDB(session);
+        queryLedgerForward(
+            {},
+            [](soci::session& session) { return ripple::getKBUsedDB(session); },
+            [&](std::uint32_t kb) {
+                sum += kb;
                 return true;
             });
         return sum;
@@ -1704,9 +1999,11 @@ RelationalDBInterfaceSqliteImp::getKBUsedTransaction()
     if (shardStoreExists())
     {
         std::uint32_t sum = 0;
-        iterateTransactionBack(
-            {}, [&](soci::session& session, std::uint32_t shardIndex) {
-                sum += ripple::getKBUsedDB(session);
+        queryTransactionForward(
+            {},
+            [](soci::session& session) { return ripple::getKBUsedDB(session); },
+            [&](std::uint32_t kb) {
+                sum += kb;
                 return true;
             });
         return sum;
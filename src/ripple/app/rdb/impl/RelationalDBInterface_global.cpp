@@ -833,4 +833,50 @@ savePeerFinderDB(
     tr.commit();
 }
 
+void
+savePeerFinderDBChanges(
+    soci::session& session,
+    std::vector<PeerFinder::Store::Entry> const& changed,
+    std::vector<beast::IP::Endpoint> const& removed)
+{
+    soci::transaction tr(session);
+
+    if (!removed.empty())
+    {
+        std::vector<std::string> s;
+        s.reserve(removed.size());
+
+        for (auto const& e : removed)
+            s.emplace_back(to_string(e));
+
+        session << "DELETE FROM PeerFinder_BootstrapCache "
+                   "WHERE address = :s;",
+            soci::use(s);
+    }
+
+    if (!changed.empty())
+    {
+        std::vector<std::string> s;
+        std::vector<int> valence;
+        s.reserve(changed.size());
+        valence.reserve(changed.size());
+
+        for (auto const& e : changed)
+        {
+            s.emplace_back(to_string(e.endpoint));
+            valence.emplace_back(e.valence);
+        }
+
+        session << "INSERT OR REPLACE INTO PeerFinder_BootstrapCache ( "
+                   "  address, "
+                   "  valence "
+                   ") VALUES ( "
+                   "  :s, :valence "
+                   ");",
+            soci::use(s), soci::use(valence);
+    }
+
+    tr.commit();
+}
+
 }  // namespace ripple
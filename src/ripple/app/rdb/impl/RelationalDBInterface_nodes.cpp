@@ -1040,6 +1040,17 @@ getNewestAccountTxsB(
     return getAccountTxsB(session, app, options, limit_used, true, j);
 }
 
+std::uint32_t
+accountTxPageSize(
+    RelationalDBInterface::AccountTxPageOptions const& options,
+    std::uint32_t page_length)
+{
+    if (options.limit == 0 || options.limit == UINT32_MAX ||
+        (options.limit > page_length && !options.bAdmin))
+        return page_length;
+    return options.limit;
+}
+
 /**
  * @brief accountTxPage Searches oldest or newest transactions for given
  *        account which match given criteria starting from given marker
@@ -1079,13 +1090,7 @@ accountTxPage(
 
     bool lookingForMarker = options.marker.has_value();
 
-    std::uint32_t numberOfResults;
-
-    if (options.limit == 0 || options.limit == UINT32_MAX ||
-        (options.limit > page_length && !options.bAdmin))
-        numberOfResults = page_length;
-    else
-        numberOfResults = options.limit;
+    std::uint32_t numberOfResults = accountTxPageSize(options, page_length);
 
     if (numberOfResults < limit_used)
         return {options.marker, -1};
@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/rdb/TxIndex.h>
+#include <ripple/basics/Log.h>
+#include <ripple/basics/contract.h>
+#include <ripple/beast/core/LexicalCast.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+namespace {
+
+/* "TXIX" in ASCII */
+constexpr std::uint64_t txIndexAppType = 0x5458495800000000ull;
+
+// Ledger sequence, big endian, followed by the node store key
+constexpr std::size_t valueBytes = 4 + uint256::size();
+
+}  // namespace
+
+TxIndex::TxIndex(boost::filesystem::path const& dir, beast::Journal j)
+    : dir_(dir), j_(j)
+{
+    using namespace boost::filesystem;
+
+    create_directories(dir_);
+
+    std::vector<LedgerIndex> seqs;
+    for (auto const& d : directory_iterator(dir_))
+    {
+        LedgerIndex seq;
+        if (is_directory(d.path()) &&
+            beast::lexicalCastChecked(seq, d.path().filename().string()))
+            seqs.push_back(seq);
+    }
+    std::sort(seqs.begin(), seqs.end());
+
+    // Only the two newest databases are used, any other one was being
+    // removed when the server stopped
+    while (seqs.size() > 2)
+    {
+        remove_all(dir_ / std::to_string(seqs.front()));
+        seqs.erase(seqs.begin());
+    }
+
+    if (seqs.size() == 2)
+        archive_ = open(dir_ / std::to_string(seqs.front()), seqs.front());
+    if (!seqs.empty())
+        current_ = open(dir_ / std::to_string(seqs.back()), seqs.back());
+}
+
+TxIndex::~TxIndex()
+{
+    close(current_, false);
+    close(archive_, false);
+}
+
+void
+TxIndex::insert(uint256 const& txID, Entry const& entry)
+{
+    try
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (current_)
+            {
+                insert(*current_, txID, entry);
+                return;
+            }
+        }
+
+        std::unique_lock lock(mutex_);
+        if (!current_)
+        {
+            current_ = open(
+                dir_ / std::to_string(entry.ledgerSeq), entry.ledgerSeq);
+        }
+        insert(*current_, txID, entry);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.warn()) << "Unable to index transaction " << txID << ": "
+                        << e.what();
+    }
+}
+
+std::optional<TxIndex::Entry>
+TxIndex::fetch(uint256 const& txID) const
+{
+    std::shared_lock lock(mutex_);
+
+    std::optional<Entry> entry;
+    if (current_)
+        entry = fetch(*current_, txID);
+    if (!entry && archive_)
+        entry = fetch(*archive_, txID);
+
+    if (entry && entry->ledgerSeq < minSeq_)
+        return std::nullopt;
+    return entry;
+}
+
+void
+TxIndex::deleteBefore(LedgerIndex ledgerSeq)
+{
+    std::unique_lock lock(mutex_);
+
+    minSeq_ = std::max(minSeq_, ledgerSeq);
+    if (!current_ || current_->firstSeq > ledgerSeq)
+        return;
+
+    // Every ledger in the archive is older than the ledgers in the
+    // current database, so the archive holds no ledger still in use.
+    // The next transaction indexed starts a new database.
+    close(archive_, true);
+    archive_ = std::move(current_);
+}
+
+std::unique_ptr<TxIndex::Generation>
+TxIndex::open(boost::filesystem::path const& path, LedgerIndex firstSeq)
+{
+    auto gen = std::make_unique<Generation>();
+    gen->firstSeq = firstSeq;
+    gen->path = path;
+
+    auto const dp = (path / "nudb.dat").string();
+    auto const kp = (path / "nudb.key").string();
+    auto const lp = (path / "nudb.log").string();
+    nudb::error_code ec;
+    boost::filesystem::create_directories(path);
+    nudb::create<nudb::xxhasher>(
+        dp,
+        kp,
+        lp,
+        txIndexAppType,
+        nudb::make_uid(),
+        nudb::make_salt(),
+        uint256::size(),
+        nudb::block_size(kp),
+        0.50,
+        ec);
+    if (ec == nudb::errc::file_exists)
+        ec = {};
+    if (ec)
+        Throw<nudb::system_error>(ec);
+
+    gen->db.open(dp, kp, lp, ec);
+    if (ec)
+        Throw<nudb::system_error>(ec);
+    if (gen->db.appnum() != txIndexAppType)
+        Throw<std::runtime_error>("TxIndex: unknown appnum");
+
+    JLOG(j_.debug()) << "Opened transaction index " << path.string();
+    return gen;
+}
+
+void
+TxIndex::close(std::unique_ptr<Generation>& gen, bool remove)
+{
+    if (!gen)
+        return;
+
+    nudb::error_code ec;
+    gen->db.close(ec);
+    if (ec)
+    {
+        JLOG(j_.error()) << "Unable to close transaction index "
+                         << gen->path.string() << ": " << ec.message();
+    }
+
+    if (remove)
+    {
+        boost::filesystem::remove_all(gen->path, ec);
+        if (ec)
+        {
+            JLOG(j_.error()) << "Unable to remove transaction index "
+                             << gen->path.string() << ": " << ec.message();
+        }
+    }
+
+    gen.reset();
+}
+
+void
+TxIndex::insert(Generation& gen, uint256 const& txID, Entry const& entry)
+{
+    std::array<std::uint8_t, valueBytes> value;
+    value[0] = static_cast<std::uint8_t>(entry.ledgerSeq >> 24);
+    value[1] = static_cast<std::uint8_t>(entry.ledgerSeq >> 16);
+    value[2] = static_cast<std::uint8_t>(entry.ledgerSeq >> 8);
+    value[3] = static_cast<std::uint8_t>(entry.ledgerSeq);
+    std::memcpy(value.data() + 4, entry.nodeKey.data(), uint256::size());
+
+    nudb::error_code ec;
+    gen.db.insert(txID.data(), value.data(), value.size(), ec);
+    if (ec && ec != nudb::error::key_exists)
+        Throw<nudb::system_error>(ec);
+}
+
+std::optional<TxIndex::Entry>
+TxIndex::fetch(Generation& gen, uint256 const& txID)
+{
+    std::optional<Entry> entry;
+    nudb::error_code ec;
+    gen.db.fetch(
+        txID.data(),
+        [&entry](void const* data, std::size_t size) {
+            if (size != valueBytes)
+                return;
+            auto const p = static_cast<std::uint8_t const*>(data);
+            Entry e;
+            e.ledgerSeq = (static_cast<LedgerIndex>(p[0]) << 24) |
+                (static_cast<LedgerIndex>(p[1]) << 16) |
+                (static_cast<LedgerIndex>(p[2]) << 8) | p[3];
+            std::memcpy(e.nodeKey.data(), p + 4, uint256::size());
+            entry = e;
+        },
+        ec);
+    return entry;
+}
+
+}  // namespace ripple
@@ -25,6 +25,7 @@
 #include <ripple/protocol/STArray.h>
 #include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/nftPageMask.h>
+#include <algorithm>
 #include <functional>
 #include <memory>
 
@@ -32,6 +33,45 @@ namespace ripple {
 
 namespace nft {
 
+static bool
+compareTokens(uint256 const& a, uint256 const& b)
+{
+    // The sort of NFTokens needs to be fully deterministic, but the sort
+    // is weird because we sort on the low 96-bits first. But if the low
+    // 96-bits are identical we still need a fully deterministic sort.
+    // So we sort on the low 96-bits first. If those are equal we sort on
+    // the whole thing.
+    if (auto const lowBitsCmp = compare(a & nft::pageMask, b & nft::pageMask);
+        lowBitsCmp != 0)
+        return lowBitsCmp < 0;
+
+    return a < b;
+}
+
+/** Find a token in a page.
+
+    The tokens in a page are always kept sorted by compareTokens, so the
+    token is found with a binary search.
+
+    @return An iterator to the token, or `arr.end()` if it is not there.
+*/
+template <class Array>
+static auto
+findInPage(Array& arr, uint256 const& nftokenID)
+{
+    auto const iter = std::lower_bound(
+        arr.begin(),
+        arr.end(),
+        nftokenID,
+        [](STObject const& obj, uint256 const& id) {
+            return compareTokens(obj.getFieldH256(sfNFTokenID), id);
+        });
+
+    if (iter != arr.end() && iter->getFieldH256(sfNFTokenID) == nftokenID)
+        return iter;
+    return arr.end();
+}
+
 static std::shared_ptr<SLE const>
 locatePage(ReadView const& view, AccountID owner, uint256 const& id)
 {
@@ -89,7 +129,8 @@ getPageForToken(
         return cp;
     }
 
-    STArray narr = cp->getFieldArray(sfNFTokens);
+    // Modify the tokens in place, rather than copying the whole page.
+    STArray& narr = cp->peekFieldArray(sfNFTokens);
 
     // The right page still has space: we're good.
     if (narr.size() != dirMaxTokensPerPage)
@@ -166,7 +207,9 @@ getPageForToken(
 
     view.insert(np);
 
-    cp->setFieldArray(sfNFTokens, carr);
+    // Swap rather than assign, which keeps the field name of narr. narr
+    // must not be used after fields are added to cp.
+    narr.swap(carr);
     cp->setFieldH256(sfPreviousPageMin, np->key());
     view.update(cp);
 
@@ -175,21 +218,6 @@ getPageForToken(
     return (first.key <= np->key()) ? np : cp;
 }
 
-static bool
-compareTokens(uint256 const& a, uint256 const& b)
-{
-    // The sort of NFTokens needs to be fully deterministic, but the sort
-    // is weird because we sort on the low 96-bits first. But if the low
-    // 96-bits are identical we still need a fully deterministic sort.
-    // So we sort on the low 96-bits first. If those are equal we sort on
-    // the whole thing.
-    if (auto const lowBitsCmp = compare(a & nft::pageMask, b & nft::pageMask);
-        lowBitsCmp != 0)
-        return lowBitsCmp < 0;
-
-    return a < b;
-}
-
 /** Insert the token in the owner's token directory. */
 TER
 insertToken(ApplyView& view, AccountID owner, STObject&& nft)
@@ -215,15 +243,17 @@ insertToken(ApplyView& view, AccountID owner, STObject&& nft)
         return tecNO_SUITABLE_NFTOKEN_PAGE;
 
     {
-        auto arr = page->getFieldArray(sfNFTokens);
-        arr.push_back(std::move(nft));
-
-        arr.sort([](STObject const& o1, STObject const& o2) {
-            return compareTokens(
-                o1.getFieldH256(sfNFTokenID), o2.getFieldH256(sfNFTokenID));
-        });
-
-        page->setFieldArray(sfNFTokens, arr);
+        // The page is sorted, so insert the token in its place rather than
+        // copying the page to sort it.
+        STArray& arr = page->peekFieldArray(sfNFTokens);
+        auto const pos = std::upper_bound(
+            arr.begin(),
+            arr.end(),
+            nft.getFieldH256(sfNFTokenID),
+            [](uint256 const& id, STObject const& obj) {
+                return compareTokens(id, obj.getFieldH256(sfNFTokenID));
+            });
+        arr.insert(pos, std::move(nft));
     }
 
     view.update(page);
@@ -318,18 +348,20 @@ removeToken(
     std::shared_ptr<SLE>&& curr)
 {
     // We found a page, but the given NFT may not be in it.
-    auto arr = curr->getFieldArray(sfNFTokens);
+    STArray& arr = curr->peekFieldArray(sfNFTokens);
+    bool emptied = false;
 
     {
-        auto x = std::find_if(
-            arr.begin(), arr.end(), [&nftokenID](STObject const& obj) {
-                return (obj[sfNFTokenID] == nftokenID);
-            });
+        auto x = findInPage(arr, nftokenID);
 
         if (x == arr.end())
             return tecNO_ENTRY;
 
-        arr.erase(x);
+        // A page left empty is erased as it is, so its final fields in the
+        // metadata still hold the token.
+        emptied = arr.size() == 1;
+        if (!emptied)
+            arr.erase(x);
     }
 
     // Page management:
@@ -354,12 +386,11 @@ removeToken(
     auto const prev = loadPage(curr, sfPreviousPageMin);
     auto const next = loadPage(curr, sfNextPageMin);
 
-    if (!arr.empty())
+    if (!emptied)
     {
         // The current page isn't empty. Update it and then try to consolidate
         // pages. Note that this consolidation attempt may actually merge three
         // pages into one!
-        curr->setFieldArray(sfNFTokens, arr);
         view.update(curr);
 
         int cnt = 0;
@@ -444,11 +475,9 @@ findToken(
         return std::nullopt;
 
     // We found a candidate page, but the given NFT may not be in it.
-    for (auto const& t : page->getFieldArray(sfNFTokens))
-    {
-        if (t[sfNFTokenID] == nftokenID)
-            return t;
-    }
+    auto const& arr = page->getFieldArray(sfNFTokens);
+    if (auto const t = findInPage(arr, nftokenID); t != arr.end())
+        return *t;
 
     return std::nullopt;
 }
@@ -466,13 +495,10 @@ findTokenAndPage(
         return std::nullopt;
 
     // We found a candidate page, but the given NFT may not be in it.
-    for (auto const& t : page->getFieldArray(sfNFTokens))
-    {
-        if (t[sfNFTokenID] == nftokenID)
-            // This std::optional constructor is explicit, so it is spelled out.
-            return std::optional<TokenAndPage>(
-                std::in_place, t, std::move(page));
-    }
+    auto const& arr = page->getFieldArray(sfNFTokens);
+    if (auto const t = findInPage(arr, nftokenID); t != arr.end())
+        // This std::optional constructor is explicit, so it is spelled out.
+        return std::optional<TokenAndPage>(std::in_place, *t, std::move(page));
     return std::nullopt;
 }
 void
@@ -20,6 +20,7 @@
 #ifndef RIPPLED_COMPRESSIONALGORITHMS_H_INCLUDED
 #define RIPPLED_COMPRESSIONALGORITHMS_H_INCLUDED
 
+#include <ripple/basics/Slice.h>
 #include <ripple/basics/contract.h>
 #include <algorithm>
 #include <cstdint>
@@ -37,11 +38,18 @@ namespace compression_algorithms {
  * @param in Data to compress
  * @param inSize Size of the data
  * @param bf Compressed buffer allocator
+ * @param dictionary Data the compressor may refer to as if it preceded the
+ *     input. The same dictionary must be used to decompress. At most the
+ *     last 64KB are used.
  * @return Size of compressed data, or zero if failed to compress
  */
 template <typename BufferFactory>
 std::size_t
-lz4Compress(void const* in, std::size_t inSize, BufferFactory&& bf)
+lz4Compress(
+    void const* in,
+    std::size_t inSize,
+    BufferFactory&& bf,
+    Slice dictionary = {})
 {
     if (inSize > UINT32_MAX)
         Throw<std::runtime_error>("lz4 compress: invalid size");
@@ -52,11 +60,31 @@ lz4Compress(void const* in, std::size_t inSize, BufferFactory&& bf)
     // data
     auto compressed = bf(outCapacity);
 
-    auto compressedSize = LZ4_compress_default(
-        reinterpret_cast<const char*>(in),
-        reinterpret_cast<char*>(compressed),
-        inSize,
-        outCapacity);
+    int compressedSize = 0;
+    if (dictionary.empty())
+    {
+        compressedSize = LZ4_compress_default(
+            reinterpret_cast<const char*>(in),
+            reinterpret_cast<char*>(compressed),
+            inSize,
+            outCapacity);
+    }
+    else
+    {
+        LZ4_stream_t stream;
+        LZ4_initStream(&stream, sizeof(stream));
+        LZ4_loadDict(
+            &stream,
+            reinterpret_cast<const char*>(dictionary.data()),
+            static_cast<int>(dictionary.size()));
+        compressedSize = LZ4_compress_fast_continue(
+            &stream,
+            reinterpret_cast<const char*>(in),
+            reinterpret_cast<char*>(compressed),
+            inSize,
+            outCapacity,
+            1);
+    }
     if (compressedSize == 0)
         Throw<std::runtime_error>("lz4 compress: failed");
 
@@ -68,6 +96,7 @@ lz4Compress(void const* in, std::size_t inSize, BufferFactory&& bf)
  * @param inSizeUnchecked Size of compressed data
  * @param decompressed Buffer to hold decompressed data
  * @param decompressedSizeUnchecked Size of the decompressed buffer
+ * @param dictionary Dictionary the data was compressed with, if any
  * @return size of the decompressed data
  */
 inline std::size_t
@@ -75,7 +104,8 @@ lz4Decompress(
     std::uint8_t const* in,
     std::size_t inSizeUnchecked,
     std::uint8_t* decompressed,
-    std::size_t decompressedSizeUnchecked)
+    std::size_t decompressedSizeUnchecked,
+    Slice dictionary = {})
 {
     int const inSize = static_cast<int>(inSizeUnchecked);
     int const decompressedSize = static_cast<int>(decompressedSizeUnchecked);
@@ -86,11 +116,20 @@ lz4Decompress(
     if (decompressedSize <= 0)
         Throw<std::runtime_error>("lz4Decompress: integer overflow (output)");
 
-    if (LZ4_decompress_safe(
-            reinterpret_cast<const char*>(in),
-            reinterpret_cast<char*>(decompressed),
-            inSize,
-            decompressedSize) != decompressedSize)
+    auto const size = dictionary.empty()
+        ? LZ4_decompress_safe(
+              reinterpret_cast<const char*>(in),
+              reinterpret_cast<char*>(decompressed),
+              inSize,
+              decompressedSize)
+        : LZ4_decompress_safe_usingDict(
+              reinterpret_cast<const char*>(in),
+              reinterpret_cast<char*>(decompressed),
+              inSize,
+              decompressedSize,
+              reinterpret_cast<const char*>(dictionary.data()),
+              static_cast<int>(dictionary.size()));
+    if (size != decompressedSize)
         Throw<std::runtime_error>("lz4Decompress: failed");
 
     return decompressedSize;
@@ -102,6 +141,7 @@ lz4Decompress(
  * @param inSize Size of compressed data
  * @param decompressed Buffer to hold decompressed data
  * @param decompressedSize Size of the decompressed buffer
+ * @param dictionary Dictionary the data was compressed with, if any
  * @return size of the decompressed data
  */
 template <typename InputStream>
@@ -110,7 +150,8 @@ lz4Decompress(
     InputStream& in,
     std::size_t inSize,
     std::uint8_t* decompressed,
-    std::size_t decompressedSize)
+    std::size_t decompressedSize,
+    Slice dictionary = {})
 {
     std::vector<std::uint8_t> compressed;
     std::uint8_t const* chunk = nullptr;
@@ -156,7 +197,8 @@ lz4Decompress(
         (copiedInSize > 0 && copiedInSize != inSize))
         Throw<std::runtime_error>("lz4 decompress: insufficient input size");
 
-    return lz4Decompress(chunk, inSize, decompressed, decompressedSize);
+    return lz4Decompress(
+        chunk, inSize, decompressed, decompressedSize, dictionary);
 }
 
 }  // namespace compression_algorithms
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_BASICS_WORKERPOOL_H_INCLUDED
+#define RIPPLE_BASICS_WORKERPOOL_H_INCLUDED
+
+#include <boost/asio/thread_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace ripple {
+
+/** A fixed set of threads shared by code which splits its work into parts.
+
+    The pool is created on first use, with one thread per core, and is
+    shared by the whole process. Callers never create threads of their
+    own, so the number of threads stays bounded however many callers
+    split their work at the same time.
+*/
+class WorkerPool
+{
+public:
+    /** Returns the pool shared by the whole process. */
+    static WorkerPool&
+    instance();
+
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool&
+    operator=(WorkerPool const&) = delete;
+
+    /** Returns the number of threads in the pool. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** Call `f(i)` for every `i` in [0, n).
+
+        The calls are made on the calling thread and on up to `helpers`
+        threads of the pool, and this returns once all of them have
+        returned. The calling thread takes part in the work, so this
+        also completes when every thread in the pool is busy, including
+        when it is called from a thread of the pool.
+
+        @note If any call throws, the first exception is rethrown once
+              all of the calls have returned.
+    */
+    template <class F>
+    void
+    forEach(std::size_t n, std::size_t helpers, F const& f);
+
+private:
+    explicit WorkerPool(std::size_t threads);
+
+    void
+    post(std::function<void()> task);
+
+    std::size_t const size_;
+    boost::asio::thread_pool pool_;
+};
+
+template <class F>
+void
+WorkerPool::forEach(std::size_t n, std::size_t helpers, F const& f)
+{
+    // Helpers may start after all of the parts are done, and after this
+    // has returned, so they only share this state with the caller. They
+    // only call `f` for a part they claimed, which this waits for.
+    struct State
+    {
+        std::function<void(std::size_t)> work;
+        std::size_t const n;
+        std::atomic<std::size_t> next{0};
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        std::exception_ptr error;
+
+        State(F const& f, std::size_t n) : work(std::cref(f)), n(n)
+        {
+        }
+
+        void
+        run()
+        {
+            for (auto i = next++; i < n; i = next++)
+            {
+                std::exception_ptr e;
+                try
+                {
+                    work(i);
+                }
+                catch (...)
+                {
+                    e = std::current_exception();
+                }
+
+                std::lock_guard lock(mutex);
+                if (e && !error)
+                    error = e;
+                if (++done == n)
+                    cv.notify_all();
+            }
+        }
+    };
+
+    if (n == 0)
+        return;
+
+    auto const state = std::make_shared<State>(f, n);
+
+    helpers = std::min({helpers, n - 1, size_});
+    for (std::size_t i = 0; i < helpers; ++i)
+        post([state] { state->run(); });
+
+    state->run();
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == n; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+}  // namespace ripple
+
+#endif
@@ -1,7 +1,7 @@
 //------------------------------------------------------------------------------
 /*
     This file is part of rippled: https://github.com/ripple/rippled
-    Copyright (c) 2012, 2013 Ripple Labs Inc.
+    Copyright (c) 2022 Ripple Labs Inc.
 
     Permission to use, copy, modify, and/or distribute this software for any
     purpose  with  or without fee is hereby granted, provided that the above
@@ -17,33 +17,29 @@
 */
 //==============================================================================
 
-#include <ripple/basics/strHex.h>
-#include <array>
+#include <ripple/basics/WorkerPool.h>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <thread>
 
 namespace ripple {
 
-int
-charUnHex(unsigned char c)
+WorkerPool::WorkerPool(std::size_t threads) : size_(threads), pool_(threads)
 {
-    static constexpr std::array<int, 256> const xtab = []() {
-        std::array<int, 256> t{};
-
-        for (auto& x : t)
-            x = -1;
-
-        for (int i = 0; i < 10; ++i)
-            t['0' + i] = i;
-
-        for (int i = 0; i < 6; ++i)
-        {
-            t['A' + i] = 10 + i;
-            t['a' + i] = 10 + i;
-        }
+}
 
-        return t;
-    }();
+WorkerPool&
+WorkerPool::instance()
+{
+    static WorkerPool pool(
+        std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    return pool;
+}
 
-    return xtab[c];
+void
+WorkerPool::post(std::function<void()> task)
+{
+    boost::asio::post(pool_, std::move(task));
 }
 
 }  // namespace ripple
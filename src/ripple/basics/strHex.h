@@ -22,16 +22,60 @@
 
 #include <boost/algorithm/hex.hpp>
 #include <boost/endian/conversion.hpp>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <string>
 
 namespace ripple {
 
+namespace detail {
+
+// The two hex digits of each byte value
+inline constexpr std::array<char, 512> hexPairs = []() {
+    constexpr char digits[] = "0123456789ABCDEF";
+    std::array<char, 512> t{};
+
+    for (int i = 0; i < 256; ++i)
+    {
+        t[2 * i] = digits[i >> 4];
+        t[2 * i + 1] = digits[i & 15];
+    }
+
+    return t;
+}();
+
+// The value of each hex digit, or -1
+inline constexpr std::array<int, 256> hexValues = []() {
+    std::array<int, 256> t{};
+
+    for (auto& x : t)
+        x = -1;
+
+    for (int i = 0; i < 10; ++i)
+        t['0' + i] = i;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        t['A' + i] = 10 + i;
+        t['a' + i] = 10 + i;
+    }
+
+    return t;
+}();
+
+}  // namespace detail
+
 /** @{ */
 /** Converts a hex digit to the corresponding integer
     @param cDigit one of '0'-'9', 'A'-'F' or 'a'-'f'
     @return an integer from 0 to 15 on success; -1 on failure.
 */
-int
-charUnHex(unsigned char c);
+inline int
+charUnHex(unsigned char c)
+{
+    return detail::hexValues[c];
+}
 
 inline int
 charUnHex(char c)
@@ -50,8 +94,22 @@ strHex(FwdIt begin, FwdIt end)
             std::forward_iterator_tag>::value,
         "FwdIt must be a forward iterator");
     std::string result;
-    result.reserve(2 * std::distance(begin, end));
-    boost::algorithm::hex(begin, end, std::back_inserter(result));
+    if constexpr (
+        sizeof(typename std::iterator_traits<FwdIt>::value_type) == 1)
+    {
+        // Copy the two digits of each byte from a table
+        result.resize(2 * std::distance(begin, end));
+        for (auto out = result.data(); begin != end; ++begin, out += 2)
+        {
+            auto const c = static_cast<unsigned char>(*begin);
+            std::memcpy(out, detail::hexPairs.data() + 2 * c, 2);
+        }
+    }
+    else
+    {
+        result.reserve(2 * std::distance(begin, end));
+        boost::algorithm::hex(begin, end, std::back_inserter(result));
+    }
     return result;
 }
 
@@ -57,7 +57,9 @@ enum class SizedItem : std::size_t {
     lgrDBCache,
     openFinalLimit,
     burstSize,
-    ramSizeGB
+    ramSizeGB,
+    ledgerHeaders,
+    ledgerFragmentCache
 };
 
 //  This entire derived class is deprecated.
@@ -109,6 +111,9 @@ private:
 
     bool USE_TX_TABLES = true;
 
+    // Index validated transactions by hash outside the transaction database
+    bool USE_TX_INDEX = false;
+
     /** Determines if the server will sign a tx, given an account's secret seed.
 
         In the past, this was allowed, but this functionality can have security
@@ -145,6 +150,9 @@ public:
     // Minimum number of nodes to consider the network present
     std::size_t NETWORK_QUORUM = 1;
 
+    // The network this server belongs to, if configured
+    std::optional<std::uint32_t> NETWORK_ID;
+
     // Peer networking parameters
     // 1 = relay, 0 = do not relay (but process), -1 = drop completely (do NOT
     // process)
@@ -179,6 +187,10 @@ public:
     int PATH_SEARCH_FAST = 2;
     int PATH_SEARCH_MAX = 3;
 
+    // The time allowed to find and rank the paths of one path request.
+    // Zero means no limit.
+    std::chrono::milliseconds PATH_SEARCH_TIME{0};
+
     // Validation
     std::optional<std::size_t>
         VALIDATION_QUORUM;  // validations to consider ledger authoritative
@@ -206,6 +218,12 @@ public:
     // Enable the experimental Ledger Replay functionality
     bool LEDGER_REPLAY = false;
 
+    // Bytes of RPC results for validated ledgers to keep (0 = disabled)
+    std::size_t RPC_RESPONSE_CACHE = 0;
+
+    // Issuers whose obligations are kept up to date (0 = disabled)
+    std::size_t GATEWAY_BALANCES_INDEX = 0;
+
     // Work queue limits
     int MAX_TRANSACTIONS = 250;
     static constexpr int MAX_JOB_QUEUE_TX = 1000;
@@ -218,6 +236,7 @@ public:
     int WORKERS = 0;           // jobqueue thread count. default: upto 6
     int IO_WORKERS = 0;        // io svc thread count. default: 2
     int PREFETCH_WORKERS = 0;  // prefetch thread count. default: 4
+    int APPLY_WORKERS = 0;     // ledger build thread count. default: 1
 
     // Can only be set in code, specifically unit tests
     bool FORCE_MULTI_THREAD = false;
@@ -324,6 +343,12 @@ public:
         return USE_TX_TABLES;
     }
 
+    bool
+    useTxIndex() const
+    {
+        return USE_TX_INDEX;
+    }
+
     bool
     reportingReadOnly() const
     {
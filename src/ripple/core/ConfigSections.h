@@ -63,6 +63,7 @@ struct ConfigSection
 #define SECTION_IPS_FIXED "ips_fixed"
 #define SECTION_LEDGER_HISTORY "ledger_history"
 #define SECTION_MAX_TRANSACTIONS "max_transactions"
+#define SECTION_NETWORK_ID "network_id"
 #define SECTION_NETWORK_QUORUM "network_quorum"
 #define SECTION_NODE_SEED "node_seed"
 #define SECTION_NODE_SIZE "node_size"
@@ -71,6 +72,7 @@ struct ConfigSection
 #define SECTION_PATH_SEARCH "path_search"
 #define SECTION_PATH_SEARCH_FAST "path_search_fast"
 #define SECTION_PATH_SEARCH_MAX "path_search_max"
+#define SECTION_PATH_SEARCH_TIME "path_search_time"
 #define SECTION_PEER_PRIVATE "peer_private"
 #define SECTION_PEERS_MAX "peers_max"
 #define SECTION_PEERS_IN_MAX "peers_in_max"
@@ -98,9 +100,12 @@ struct ConfigSection
 #define SECTION_WORKERS "workers"
 #define SECTION_IO_WORKERS "io_workers"
 #define SECTION_PREFETCH_WORKERS "prefetch_workers"
+#define SECTION_APPLY_WORKERS "apply_workers"
 #define SECTION_LEDGER_REPLAY "ledger_replay"
 #define SECTION_BETA_RPC_API "beta_rpc_api"
 #define SECTION_SWEEP_INTERVAL "sweep_interval"
+#define SECTION_RPC_RESPONSE_CACHE "rpc_response_cache"
+#define SECTION_GATEWAY_BALANCES_INDEX "gateway_balances_index"
 
 }  // namespace ripple
 
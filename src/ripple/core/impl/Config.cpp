@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/FileUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
@@ -108,7 +109,7 @@ namespace ripple {
 
 // clang-format off
 // The configurable node sizes are "tiny", "small", "medium", "large", "huge"
-inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 12>
+inline constexpr std::array<std::pair<SizedItem, std::array<int, 5>>, 14>
 sizedItems
 {{
     // FIXME: We should document each of these items, explaining exactly
@@ -128,6 +129,8 @@ sizedItems
     {SizedItem::openFinalLimit,  {{      8,      16,      32,      64,     128 }}},
     {SizedItem::burstSize,       {{      4,       8,      16,      32,      48 }}},
     {SizedItem::ramSizeGB,       {{      8,      12,      16,      24,      32 }}},
+    {SizedItem::ledgerHeaders,   {{   1024,    2048,    4096,    8192,   16384 }}},
+    {SizedItem::ledgerFragmentCache, {{  8,      16,      32,      64,     128 }}},
 }};
 
 // Ensure that the order of entries in the table corresponds to the
@@ -424,8 +427,6 @@ Config::setup(
         LEDGER_HISTORY = 0;
 
     std::string ledgerTxDbType;
-    Section ledgerTxTablesSection = section("ledger_tx_tables");
-    get_if_exists(ledgerTxTablesSection, "use_tx_tables", USE_TX_TABLES);
 
     Section& nodeDbSection{section(ConfigSection::nodeDatabase())};
     get_if_exists(nodeDbSection, "fast_load", FAST_LOAD);
@@ -586,6 +587,24 @@ Config::loadFromString(std::string const& fileContents)
                                   "] and [" SECTION_VALIDATOR_TOKEN
                                   "] config sections");
 
+    if (getSingleSection(secConfig, SECTION_NETWORK_ID, strTemp, j_))
+    {
+        if (strTemp == "main")
+            strTemp = "0";
+        else if (strTemp == "testnet")
+            strTemp = "1";
+        else if (strTemp == "devnet")
+            strTemp = "2";
+
+        std::uint32_t networkID;
+        if (!beast::lexicalCastChecked(networkID, strTemp))
+            Throw<std::runtime_error>(
+                "Configured [" SECTION_NETWORK_ID
+                "] section is invalid: must be a number or one of the "
+                "strings 'main', 'testnet' or 'devnet'.");
+        NETWORK_ID = networkID;
+    }
+
     if (getSingleSection(secConfig, SECTION_NETWORK_QUORUM, strTemp, j_))
         NETWORK_QUORUM = beast::lexicalCastThrow<std::size_t>(strTemp);
 
@@ -635,6 +654,11 @@ Config::loadFromString(std::string const& fileContents)
         PATH_SEARCH_FAST = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX = beast::lexicalCastThrow<int>(strTemp);
+    if (getSingleSection(secConfig, SECTION_PATH_SEARCH_TIME, strTemp, j_))
+    {
+        PATH_SEARCH_TIME = std::chrono::milliseconds(
+            beast::lexicalCastThrow<std::uint32_t>(strTemp));
+    }
 
     if (getSingleSection(secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE = strTemp;
@@ -678,12 +702,51 @@ Config::loadFromString(std::string const& fileContents)
                 ": must be between 1 and 1024 inclusive.");
     }
 
+    if (getSingleSection(secConfig, SECTION_APPLY_WORKERS, strTemp, j_))
+    {
+        APPLY_WORKERS = beast::lexicalCastThrow<int>(strTemp);
+
+        if (APPLY_WORKERS < 1 || APPLY_WORKERS > 1024)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_APPLY_WORKERS
+                ": must be between 1 and 1024 inclusive.");
+    }
+
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
     if (getSingleSection(secConfig, SECTION_LEDGER_REPLAY, strTemp, j_))
         LEDGER_REPLAY = beast::lexicalCastThrow<bool>(strTemp);
 
+    if (getSingleSection(secConfig, SECTION_RPC_RESPONSE_CACHE, strTemp, j_))
+    {
+        auto const mb = beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (mb > 65536)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_RPC_RESPONSE_CACHE
+                ": must be between 0 and 65536 inclusive.");
+        RPC_RESPONSE_CACHE = megabytes(mb);
+    }
+
+    if (getSingleSection(
+            secConfig, SECTION_GATEWAY_BALANCES_INDEX, strTemp, j_))
+    {
+        GATEWAY_BALANCES_INDEX =
+            beast::lexicalCastThrow<std::size_t>(strTemp);
+
+        if (GATEWAY_BALANCES_INDEX > 65536)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_GATEWAY_BALANCES_INDEX
+                ": must be between 0 and 65536 inclusive.");
+    }
+
+    {
+        Section const& ledgerTxTables = section("ledger_tx_tables");
+        get_if_exists(ledgerTxTables, "use_tx_tables", USE_TX_TABLES);
+        get_if_exists(ledgerTxTables, "use_tx_index", USE_TX_INDEX);
+    }
+
     if (exists(SECTION_REDUCE_RELAY))
     {
         auto sec = section(SECTION_REDUCE_RELAY);
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_RECORDINGVIEW_H_INCLUDED
+#define RIPPLE_LEDGER_RECORDINGVIEW_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** ReadView that records what is read through it.
+
+    Every state key passed to read or exists, every
+    range of keys examined by succ and every transaction
+    looked up with txExists is remembered, so that a
+    caller which later changes the underlying view can
+    tell whether the result of a computation performed
+    against this view may have changed.
+
+    Reads which cannot be summarized as a set of keys,
+    such as iterating the state or transaction maps,
+    mark the record as incomplete.
+
+    @note A RecordingView is not thread safe; each
+          concurrent reader needs its own instance.
+*/
+class RecordingView final : public ReadView
+{
+private:
+    ReadView const& base_;
+    std::set<key_type> mutable keys_;
+    std::set<key_type> mutable txKeys_;
+    // Half-open key ranges (first, second] examined by succ
+    std::vector<std::pair<key_type, std::optional<key_type>>> mutable ranges_;
+    bool mutable complete_ = true;
+
+public:
+    RecordingView() = delete;
+    RecordingView(RecordingView const&) = delete;
+    RecordingView&
+    operator=(RecordingView const&) = delete;
+
+    explicit RecordingView(ReadView const& base) : base_(base)
+    {
+    }
+
+    /** Returns `true` if every read has been recorded. */
+    bool
+    complete() const
+    {
+        return complete_;
+    }
+
+    /** Returns `true` if a recorded read may be affected.
+
+        @param changed State keys which were modified.
+        @param inserted Transactions which were added.
+    */
+    bool
+    conflicts(
+        std::set<key_type> const& changed,
+        std::set<key_type> const& inserted) const;
+
+    //
+    // ReadView
+    //
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override;
+
+    std::optional<key_type>
+    succ(
+        key_type const& key,
+        std::optional<key_type> const& last = std::nullopt) const override;
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override;
+
+    STAmount
+    balanceHook(
+        AccountID const& account,
+        AccountID const& issuer,
+        STAmount const& amount) const override
+    {
+        return base_.balanceHook(account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook(AccountID const& account, std::uint32_t count)
+        const override
+    {
+        return base_.ownerCountHook(account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override;
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override;
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override;
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override;
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override;
+
+    bool
+    txExists(key_type const& key) const override;
+
+    tx_type
+    txRead(key_type const& key) const override;
+};
+
+}  // namespace ripple
+
+#endif
@@ -59,10 +59,10 @@ ApplyView::dirAdd(
             LogicError("Directory chain: root back-pointer broken.");
     }
 
-    auto indexes = node->getFieldV256(sfIndexes);
-
-    // If there's space, we use it:
-    if (indexes.size() < dirNodeMaxEntries)
+    // If there's space, we use it. The entries are updated in place,
+    // rather than copied out of the page and back in.
+    if (auto& indexes = node->peekFieldV256(sfIndexes);
+        indexes.size() < dirNodeMaxEntries)
     {
         if (preserveOrder)
         {
@@ -75,8 +75,9 @@ ApplyView::dirAdd(
         {
             // We can't be sure if this page is already sorted because
             // it may be a legacy page we haven't yet touched. Take
-            // the time to sort it.
-            std::sort(indexes.begin(), indexes.end());
+            // the time to sort it if it isn't.
+            if (!std::is_sorted(indexes.begin(), indexes.end()))
+                std::sort(indexes.begin(), indexes.end());
 
             auto pos = std::lower_bound(indexes.begin(), indexes.end(), key);
 
@@ -86,7 +87,6 @@ ApplyView::dirAdd(
             indexes.insert(pos, key);
         }
 
-        node->setFieldV256(sfIndexes, indexes);
         update(node);
         return page;
     }
@@ -104,7 +104,7 @@ ApplyView::dirAdd(
     update(root);
 
     // Insert the new key:
-    indexes.clear();
+    STVector256 indexes;
     indexes.push_back(key);
 
     node = std::make_shared<SLE>(keylet::page(directory, page));
@@ -200,7 +200,7 @@ ApplyView::dirRemove(
     std::uint64_t constexpr rootPage = 0;
 
     {
-        auto entries = node->getFieldV256(sfIndexes);
+        auto& entries = node->peekFieldV256(sfIndexes);
 
         auto it = std::find(entries.begin(), entries.end(), key);
 
@@ -210,7 +210,6 @@ ApplyView::dirRemove(
         // We always preserve the relative order when we remove.
         entries.erase(it);
 
-        node->setFieldV256(sfIndexes, entries);
         update(node);
 
         if (!entries.empty())
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/ledger/RecordingView.h>
+
+namespace ripple {
+
+bool
+RecordingView::conflicts(
+    std::set<key_type> const& changed,
+    std::set<key_type> const& inserted) const
+{
+    if (!complete_)
+        return true;
+
+    for (auto const& key : txKeys_)
+        if (inserted.count(key))
+            return true;
+
+    if (changed.empty())
+        return false;
+
+    for (auto const& key : keys_)
+        if (changed.count(key))
+            return true;
+
+    for (auto const& [first, last] : ranges_)
+    {
+        auto const iter = changed.upper_bound(first);
+        if (iter != changed.end() && (!last || *iter <= *last))
+            return true;
+    }
+
+    return false;
+}
+
+bool
+RecordingView::exists(Keylet const& k) const
+{
+    keys_.insert(k.key);
+    return base_.exists(k);
+}
+
+auto
+RecordingView::succ(key_type const& key, std::optional<key_type> const& last)
+    const -> std::optional<key_type>
+{
+    auto const next = base_.succ(key, last);
+    // Any change between key and the answer (or the limit, if there
+    // was no answer) could have produced a different answer.
+    ranges_.emplace_back(key, next ? next : last);
+    return next;
+}
+
+std::shared_ptr<SLE const>
+RecordingView::read(Keylet const& k) const
+{
+    keys_.insert(k.key);
+    return base_.read(k);
+}
+
+auto
+RecordingView::slesBegin() const -> std::unique_ptr<sles_type::iter_base>
+{
+    complete_ = false;
+    return base_.slesBegin();
+}
+
+auto
+RecordingView::slesEnd() const -> std::unique_ptr<sles_type::iter_base>
+{
+    complete_ = false;
+    return base_.slesEnd();
+}
+
+auto
+RecordingView::slesUpperBound(key_type const& key) const
+    -> std::unique_ptr<sles_type::iter_base>
+{
+    complete_ = false;
+    return base_.slesUpperBound(key);
+}
+
+auto
+RecordingView::txsBegin() const -> std::unique_ptr<txs_type::iter_base>
+{
+    complete_ = false;
+    return base_.txsBegin();
+}
+
+auto
+RecordingView::txsEnd() const -> std::unique_ptr<txs_type::iter_base>
+{
+    complete_ = false;
+    return base_.txsEnd();
+}
+
+bool
+RecordingView::txExists(key_type const& key) const
+{
+    txKeys_.insert(key);
+    return base_.txExists(key);
+}
+
+auto
+RecordingView::txRead(key_type const& key) const -> tx_type
+{
+    txKeys_.insert(key);
+    return base_.txRead(key);
+}
+
+}  // namespace ripple
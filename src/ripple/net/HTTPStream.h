@@ -36,6 +36,8 @@ class HTTPStream
 {
 public:
     using request = boost::beast::http::request<boost::beast::http::empty_body>;
+    using post_request =
+        boost::beast::http::request<boost::beast::http::string_body>;
     using parser = boost::beast::http::basic_parser<false>;
 
     virtual ~HTTPStream() = default;
@@ -56,6 +58,12 @@ public:
         boost::asio::yield_context& yield,
         boost::system::error_code& ec) = 0;
 
+    virtual void
+    asyncWrite(
+        post_request& req,
+        boost::asio::yield_context& yield,
+        boost::system::error_code& ec) = 0;
+
     virtual void
     asyncRead(
         boost::beast::flat_buffer& buf,
@@ -97,6 +105,12 @@ public:
         boost::asio::yield_context& yield,
         boost::system::error_code& ec) override;
 
+    void
+    asyncWrite(
+        post_request& req,
+        boost::asio::yield_context& yield,
+        boost::system::error_code& ec) override;
+
     void
     asyncRead(
         boost::beast::flat_buffer& buf,
@@ -141,6 +155,12 @@ public:
         boost::asio::yield_context& yield,
         boost::system::error_code& ec) override;
 
+    void
+    asyncWrite(
+        post_request& req,
+        boost::asio::yield_context& yield,
+        boost::system::error_code& ec) override;
+
     void
     asyncRead(
         boost::beast::flat_buffer& buf,
@@ -65,6 +65,14 @@ fromNetwork(
     std::unordered_map<std::string, std::string> headers = {});
 }  // namespace RPCCall
 
+/** Returns the body of a JSON-RPC request.
+ */
+std::string
+JSONRPCRequest(
+    std::string const& strMethod,
+    Json::Value const& params,
+    Json::Value const& id);
+
 /** Given a rippled command line, return the corresponding JSON.
  */
 Json::Value
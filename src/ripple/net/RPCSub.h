@@ -20,7 +20,7 @@
 #ifndef RIPPLE_NET_RPCSUB_H_INCLUDED
 #define RIPPLE_NET_RPCSUB_H_INCLUDED
 
-#include <ripple/core/JobQueue.h>
+#include <ripple/core/Config.h>
 #include <ripple/net/InfoSub.h>
 #include <boost/asio/io_service.hpp>
 
@@ -35,6 +35,10 @@ public:
     virtual void
     setPassword(std::string const& strPassword) = 0;
 
+    /** Returns the number of events dropped because the queue was full. */
+    virtual std::uint64_t
+    dropped() const = 0;
+
 protected:
     explicit RPCSub(InfoSub::Source& source);
 };
@@ -44,7 +48,7 @@ std::shared_ptr<RPCSub>
 make_RPCSub(
     InfoSub::Source& source,
     boost::asio::io_service& io_service,
-    JobQueue& jobQueue,
+    Config const& config,
     std::string const& strUrl,
     std::string const& strUsername,
     std::string const& strPassword,
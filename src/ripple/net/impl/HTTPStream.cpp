@@ -99,6 +99,15 @@ SSLStream::asyncWrite(
     boost::beast::http::async_write(*stream_, req, yield[ec]);
 }
 
+void
+SSLStream::asyncWrite(
+    post_request& req,
+    boost::asio::yield_context& yield,
+    boost::system::error_code& ec)
+{
+    boost::beast::http::async_write(*stream_, req, yield[ec]);
+}
+
 void
 SSLStream::asyncRead(
     boost::beast::flat_buffer& buf,
@@ -180,6 +189,15 @@ RawStream::asyncWrite(
     boost::beast::http::async_write(*stream_, req, yield[ec]);
 }
 
+void
+RawStream::asyncWrite(
+    post_request& req,
+    boost::asio::yield_context& yield,
+    boost::system::error_code& ec)
+{
+    boost::beast::http::async_write(*stream_, req, yield[ec]);
+}
+
 void
 RawStream::asyncRead(
     boost::beast::flat_buffer& buf,
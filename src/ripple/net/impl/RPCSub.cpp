@@ -17,38 +17,55 @@
 */
 //==============================================================================
 
+#include <ripple/basics/ByteUtilities.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/base64.h>
 #include <ripple/basics/contract.h>
 #include <ripple/json/to_string.h>
+#include <ripple/net/HTTPStream.h>
 #include <ripple/net/RPCCall.h>
 #include <ripple/net/RPCSub.h>
+#include <ripple/protocol/SystemParameters.h>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <atomic>
 #include <deque>
 
 namespace ripple {
 
 // Subscription object for JSON-RPC
-class RPCSubImp : public RPCSub
+//
+// Events are posted in order over a connection which is kept alive between
+// events. Up to maxInFlight requests are written before their replies are
+// read (HTTP/1.1 pipelining), so a receiver with real latency still sees
+// more than one event per round trip. Events wait in a queue bounded by
+// size; when it is full, the oldest events are dropped.
+class RPCSubImp : public RPCSub,
+                  public std::enable_shared_from_this<RPCSubImp>
 {
 public:
     RPCSubImp(
         InfoSub::Source& source,
         boost::asio::io_service& io_service,
-        JobQueue& jobQueue,
+        Config const& config,
         std::string const& strUrl,
         std::string const& strUsername,
         std::string const& strPassword,
         Logs& logs)
         : RPCSub(source)
-        , m_io_service(io_service)
-        , m_jobQueue(jobQueue)
+        , m_strand(io_service)
+        , m_timer(io_service)
+        , m_config(config)
         , mUrl(strUrl)
         , mSSL(false)
         , mUsername(strUsername)
         , mPassword(strPassword)
         , mSending(false)
+        , mQueuedBytes(0)
+        , mDropped(0)
         , j_(logs.journal("RPCSub"))
-        , logs_(logs)
     {
         parsedURL pUrl;
 
@@ -63,7 +80,7 @@ public:
 
         mIp = pUrl.domain;
         mPort = (!pUrl.port) ? (mSSL ? 443 : 80) : *pUrl.port;
-        mPath = pUrl.path;
+        mPath = pUrl.path.empty() ? "/" : pUrl.path;
 
         JLOG(j_.info()) << "RPCCall::fromNetwork sub: ip=" << mIp
                         << " port=" << mPort
@@ -76,28 +93,47 @@ public:
     void
     send(Json::Value const& jvObj, bool broadcast) override
     {
-        std::lock_guard sl(mLock);
+        bool start = false;
 
-        if (mDeque.size() >= eventQueueMax)
         {
-            // Drop the previous event.
-            JLOG(j_.warn()) << "RPCCall::fromNetwork drop";
-            mDeque.pop_back();
-        }
+            std::lock_guard sl(mLock);
 
-        auto jm = broadcast ? j_.debug() : j_.info();
-        JLOG(jm) << "RPCCall::fromNetwork push: " << jvObj;
+            auto jm = broadcast ? j_.debug() : j_.info();
+            JLOG(jm) << "RPCCall::fromNetwork push: " << jvObj;
 
-        mDeque.push_back(std::make_pair(mSeq++, jvObj));
+            Json::Value jvEvent = jvObj;
+            jvEvent["seq"] = mSeq++;
+            auto body = JSONRPCRequest("event", jvEvent, Json::Value(1));
 
-        if (!mSending)
-        {
-            // Start a sending thread.
-            JLOG(j_.info()) << "RPCCall::fromNetwork start";
+            while (!mDeque.empty() &&
+                   mQueuedBytes + body.size() > eventQueueMaxBytes)
+            {
+                // Drop the oldest event.
+                ++mDropped;
+                JLOG(j_.warn()) << "RPCCall::fromNetwork drop: " << mDropped
+                                << " events dropped";
+                mQueuedBytes -= mDeque.front().size();
+                mDeque.pop_front();
+            }
 
-            mSending = m_jobQueue.addJob(
-                jtCLIENT_SUBSCRIBE, "RPCSub::sendThread", [this]() {
-                    sendThread();
+            mQueuedBytes += body.size();
+            mDeque.push_back(std::move(body));
+
+            if (!mSending)
+            {
+                JLOG(j_.info()) << "RPCCall::fromNetwork start";
+                mSending = true;
+                start = true;
+            }
+        }
+
+        // Start sending outside of the lock.
+        if (start)
+        {
+            boost::asio::spawn(
+                m_strand,
+                [self = shared_from_this()](boost::asio::yield_context yield) {
+                    self->sendEvents(yield);
                 });
         }
     }
@@ -118,74 +154,222 @@ public:
         mPassword = strPassword;
     }
 
+    std::uint64_t
+    dropped() const override
+    {
+        return mDropped;
+    }
+
 private:
-    // XXX Could probably create a bunch of send jobs in a single get of the
-    // lock.
+    // Posts the queued events until the queue is empty. Runs on the strand.
     void
-    sendThread()
+    sendEvents(boost::asio::yield_context yield)
     {
-        Json::Value jvEvent;
-        bool bSend;
+        // Requests written or about to be written, oldest first
+        std::deque<HTTPStream::post_request> pending;
 
-        do
+        for (;;)
         {
             {
                 // Obtain the lock to manipulate the queue and change sending.
                 std::lock_guard sl(mLock);
 
-                if (mDeque.empty())
-                {
-                    mSending = false;
-                    bSend = false;
-                }
-                else
+                while (pending.size() < maxInFlight && !mDeque.empty())
                 {
-                    auto const [seq, env] = mDeque.front();
-
+                    pending.push_back(makeRequest(std::move(mDeque.front())));
+                    mQueuedBytes -= pending.back().body().size();
                     mDeque.pop_front();
+                }
 
-                    jvEvent = env;
-                    jvEvent["seq"] = seq;
-
-                    bSend = true;
+                if (pending.empty())
+                {
+                    mSending = false;
+                    return;
                 }
             }
 
-            // Send outside of the lock.
-            if (bSend)
+            // Send outside of the lock. A connection which was kept alive
+            // may have been closed by the other side, and a receiver which
+            // closes the connection after a reply leaves the rest of the
+            // pipeline unanswered. Either way the remaining requests are
+            // sent again on a new connection. They are lost only if a new
+            // connection delivers none of them.
+            try
             {
-                // XXX Might not need this in a try.
-                try
+                bool const reused = m_stream != nullptr;
+                if (!reused && !connect(yield))
                 {
-                    JLOG(j_.info()) << "RPCCall::fromNetwork: " << mIp;
-
-                    RPCCall::fromNetwork(
-                        m_io_service,
-                        mIp,
-                        mPort,
-                        mUsername,
-                        mPassword,
-                        mPath,
-                        "event",
-                        jvEvent,
-                        mSSL,
-                        true,
-                        logs_);
+                    lose(pending);
+                    continue;
                 }
-                catch (const std::exception& e)
+
+                if (post(pending, yield) == 0 && !reused)
+                    lose(pending);
+            }
+            catch (std::exception const& e)
+            {
+                // Setting up TLS can throw. The events are lost, but the
+                // queue must keep draining.
+                JLOG(j_.info())
+                    << "RPCCall::fromNetwork exception: " << e.what();
+                close();
+                lose(pending);
+            }
+        }
+    }
+
+    void
+    lose(std::deque<HTTPStream::post_request>& pending)
+    {
+        JLOG(j_.info()) << "RPCCall::fromNetwork lost: " << pending.size()
+                        << " events";
+        pending.clear();
+    }
+
+    // Requires the lock.
+    HTTPStream::post_request
+    makeRequest(std::string body) const
+    {
+        namespace http = boost::beast::http;
+
+        HTTPStream::post_request req{http::verb::post, mPath, 11};
+        req.set(http::field::host, mIp);
+        req.set(http::field::user_agent, systemName() + "-json-rpc/v1");
+        req.set(http::field::content_type, "application/json");
+        req.set(http::field::accept, "application/json");
+        req.set(
+            http::field::authorization,
+            "Basic " + base64_encode(mUsername + ":" + mPassword));
+        req.keep_alive(true);
+        req.body() = std::move(body);
+        req.prepare_payload();
+        return req;
+    }
+
+    bool
+    connect(boost::asio::yield_context& yield)
+    {
+        JLOG(j_.info()) << "RPCCall::fromNetwork: " << mIp;
+
+        if (mSSL)
+            m_stream = std::make_unique<SSLStream>(m_config, m_strand, j_);
+        else
+            m_stream = std::make_unique<RawStream>(m_strand);
+
+        std::string error;
+        if (!m_stream->connect(error, mIp, std::to_string(mPort), yield))
+        {
+            JLOG(j_.info()) << "RPCCall::fromNetwork connect: " << error;
+            m_stream.reset();
+            return false;
+        }
+
+        m_buffer.clear();
+        return true;
+    }
+
+    // Writes the pending requests and then reads their replies in order.
+    // Removes each request that got a reply and returns how many did.
+    std::size_t
+    post(
+        std::deque<HTTPStream::post_request>& pending,
+        boost::asio::yield_context& yield)
+    {
+        namespace http = boost::beast::http;
+
+        // Close the connection if the other side stops responding
+        m_timer.expires_after(requestTimeout);
+        m_timer.async_wait(m_strand.wrap(
+            [wp = weak_from_this()](boost::system::error_code const& ec) {
+                auto const self = wp.lock();
+                if (!ec && self && self->m_stream &&
+                    self->m_timer.expiry() <=
+                        boost::asio::steady_timer::clock_type::now())
                 {
-                    JLOG(j_.info())
-                        << "RPCCall::fromNetwork exception: " << e.what();
+                    boost::system::error_code ignored;
+                    self->m_stream->getStream().close(ignored);
                 }
+            }));
+
+        // The replies to the requests written before an error may still
+        // be read.
+        boost::system::error_code ec;
+        std::size_t written = 0;
+        for (auto& req : pending)
+        {
+            m_stream->asyncWrite(req, yield, ec);
+            if (ec)
+                break;
+            ++written;
+        }
+
+        std::size_t delivered = 0;
+        bool keepAlive = true;
+        while (delivered < written && keepAlive)
+        {
+            boost::system::error_code readEc;
+            http::response_parser<http::string_body> parser;
+            parser.body_limit(responseMaxBytes);
+
+            m_stream->asyncRead(m_buffer, parser, yield, readEc);
+            if (readEc)
+            {
+                ec = readEc;
+                break;
             }
-        } while (bSend);
+
+            JLOG(j_.debug()) << "RPCCall::fromNetwork reply: "
+                             << parser.get().result_int() << " "
+                             << parser.get().body();
+
+            keepAlive = parser.get().keep_alive();
+            pending.pop_front();
+            ++delivered;
+        }
+        m_timer.cancel();
+
+        if (ec)
+            JLOG(j_.info()) << "RPCCall::fromNetwork exception: "
+                            << ec.message();
+
+        if (ec || !keepAlive)
+            close();
+        return delivered;
+    }
+
+    void
+    close()
+    {
+        if (!m_stream)
+            return;
+
+        boost::system::error_code ec;
+        m_stream->getStream().shutdown(
+            boost::asio::socket_base::shutdown_both, ec);
+        m_stream->getStream().close(ec);
+        m_stream.reset();
     }
 
 private:
-    enum { eventQueueMax = 32 };
+    // The most bytes of events to hold while a post is in progress.
+    static constexpr std::size_t eventQueueMaxBytes = megabytes(16);
+
+    // The most requests written on a connection before their replies
+    // are read.
+    static constexpr std::size_t maxInFlight = 16;
+
+    // The most bytes to read in a reply.
+    static constexpr std::size_t responseMaxBytes = kilobytes(64);
+
+    static constexpr std::chrono::seconds requestTimeout{60};
+
+    boost::asio::io_service::strand m_strand;
+    boost::asio::steady_timer m_timer;
+    Config const& m_config;
 
-    boost::asio::io_service& m_io_service;
-    JobQueue& m_jobQueue;
+    // Only used on the strand.
+    std::unique_ptr<HTTPStream> m_stream;
+    boost::beast::flat_buffer m_buffer;
 
     std::string mUrl;
     std::string mIp;
@@ -197,12 +381,13 @@ private:
 
     int mSeq;  // Next id to allocate.
 
-    bool mSending;  // Sending threead is active.
+    bool mSending;  // Sending coroutine is active.
 
-    std::deque<std::pair<int, Json::Value>> mDeque;
+    std::deque<std::string> mDeque;
+    std::size_t mQueuedBytes;  // The bytes of the events in mDeque.
+    std::atomic<std::uint64_t> mDropped;
 
     beast::Journal const j_;
-    Logs& logs_;
 };
 
 //------------------------------------------------------------------------------
@@ -215,7 +400,7 @@ std::shared_ptr<RPCSub>
 make_RPCSub(
     InfoSub::Source& source,
     boost::asio::io_service& io_service,
-    JobQueue& jobQueue,
+    Config const& config,
     std::string const& strUrl,
     std::string const& strUsername,
     std::string const& strPassword,
@@ -224,7 +409,7 @@ make_RPCSub(
     return std::make_shared<RPCSubImp>(
         std::ref(source),
         std::ref(io_service),
-        std::ref(jobQueue),
+        std::cref(config),
         strUrl,
         strUsername,
         strPassword,
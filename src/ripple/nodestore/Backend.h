@@ -52,6 +52,8 @@ public:
             , writesDelayed(other.writesDelayed)
             , readRetries(other.readRetries)
             , readErrors(other.readErrors)
+            , filteredReads(other.filteredReads)
+            , filterFalsePositives(other.filterFalsePositives)
         {
         }
 
@@ -60,6 +62,11 @@ public:
         T writesDelayed = {};
         T readRetries = {};
         T readErrors = {};
+
+        // Reads answered by a Bloom filter without reading the database
+        T filteredReads = {};
+        // Reads the Bloom filter let through that found nothing
+        T filterFalsePositives = {};
     };
 
     /** Destroy the backend.
@@ -134,8 +141,10 @@ public:
     store(std::shared_ptr<NodeObject> const& object) = 0;
 
     /** Store a group of objects.
-        @note This function will not be called concurrently with
-              itself or @ref store.
+        Implementations should write the group as a single operation
+        where the underlying database supports it.
+        @note This will be called concurrently.
+        @param batch The objects to store.
     */
     virtual void
     storeBatch(Batch const& batch) = 0;
@@ -152,6 +161,22 @@ public:
     virtual void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) = 0;
 
+    /** Visit the key of every object in the database
+        Unlike for_each, this does not close or reopen the backend. It
+        may be called before the backend is opened and while it is in
+        use; a backend which can't list its keys in its current state
+        returns `false`. NuDB lists them while closed or open, the other
+        backends only while open. Objects stored concurrently, or since
+        a NuDB database was opened, may or may not be visited.
+        @param f Called with each key. Returning `false` stops the visit.
+        @return `true` if every key was visited.
+    */
+    virtual bool
+    visitKeys(std::function<bool(void const* key)> const& f)
+    {
+        return false;
+    }
+
     /** Estimate the number of write operations pending. */
     virtual int
     getWriteLoad() = 0;
@@ -177,8 +202,8 @@ public:
 
     /** Returns read and write stats.
 
-        @note The Counters struct is specific to and only used
-              by CassandraBackend.
+        @note The Counters struct is only used by CassandraBackend
+              and by backends with a Bloom filter.
     */
     virtual std::optional<Counters<std::uint64_t>>
     counters() const
@@ -108,6 +108,20 @@ public:
         uint256 const& hash,
         std::uint32_t ledgerSeq) = 0;
 
+    /** Store a group of objects.
+
+        This is equivalent to calling store for each object in
+        the batch, but the objects are handed to the backend in a
+        single write, which avoids per-object locking and lets
+        the backend combine the writes.
+
+        @note This can be called concurrently.
+        @param batch The objects to store.
+        @param ledgerSeq The sequence of the ledger the objects belong to.
+    */
+    virtual void
+    storeBatch(Batch const& batch, std::uint32_t ledgerSeq) = 0;
+
     /* Check if two ledgers are in the same database
 
         If these two sequence numbers map to the same database,
@@ -388,8 +402,8 @@ private:
 
     /** Retrieve backend read and write stats.
 
-        @note The Counters struct is specific to and only used
-              by CassandraBackend.
+        @note The Counters struct is only used by CassandraBackend
+              and by backends with a Bloom filter.
     */
     virtual std::optional<Backend::Counters<std::uint64_t>>
     getCounters() const
@@ -240,6 +240,72 @@ public:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback) = 0;
 
+    /**
+     * @brief queryLedgerSQLsForward Runs a query on the ledger databases of
+     *        all shards in ascending order starting from given shard index.
+     *        Queries on several shards run concurrently, each passed the
+     *        shard index and a session with the database. Once the query on
+     *        a shard has completed, merge is called on the calling thread
+     *        with the shard index, in ascending order. No more queries are
+     *        started once merge returns false.
+     * @param minShardIndex Start shard index to visit or none if all shards
+     *        should be visited.
+     * @param query Callback function to call concurrently.
+     * @param merge Callback function to call in shard order.
+     * @return True if each merge function returns true, false otherwise.
+     */
+    virtual bool
+    queryLedgerSQLsForward(
+        std::optional<std::uint32_t> minShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) = 0;
+
+    /**
+     * @brief queryTransactionSQLsForward Runs a query on the transaction
+     *        databases of all shards in ascending order starting from given
+     *        shard index. Queries on several shards run concurrently, each
+     *        passed the shard index and a session with the database. Once
+     *        the query on a shard has completed, merge is called on the
+     *        calling thread with the shard index, in ascending order. No
+     *        more queries are started once merge returns false.
+     * @param minShardIndex Start shard index to visit or none if all shards
+     *        should be visited.
+     * @param query Callback function to call concurrently.
+     * @param merge Callback function to call in shard order.
+     * @return True if each merge function returns true, false otherwise.
+     */
+    virtual bool
+    queryTransactionSQLsForward(
+        std::optional<std::uint32_t> minShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) = 0;
+
+    /**
+     * @brief queryTransactionSQLsBack Runs a query on the transaction
+     *        databases of all shards in descending order starting from given
+     *        shard index. Queries on several shards run concurrently, each
+     *        passed the shard index and a session with the database. Once
+     *        the query on a shard has completed, merge is called on the
+     *        calling thread with the shard index, in descending order. No
+     *        more queries are started once merge returns false.
+     * @param maxShardIndex Start shard index to visit or none if all shards
+     *        should be visited.
+     * @param query Callback function to call concurrently.
+     * @param merge Callback function to call in shard order.
+     * @return True if each merge function returns true, false otherwise.
+     */
+    virtual bool
+    queryTransactionSQLsBack(
+        std::optional<std::uint32_t> maxShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) = 0;
+
     /** Query information about shards held
 
         @return Information about shards held by this node
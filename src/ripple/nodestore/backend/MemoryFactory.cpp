@@ -175,8 +175,10 @@ public:
     void
     storeBatch(Batch const& batch) override
     {
+        assert(db_);
+        std::lock_guard _(db_->mutex);
         for (auto const& e : batch)
-            store(e);
+            db_->table.emplace(e->getHash(), e);
     }
 
     void
@@ -192,6 +194,21 @@ public:
             f(e.second);
     }
 
+    bool
+    visitKeys(std::function<bool(void const* key)> const& f) override
+    {
+        if (!db_)
+            return false;
+
+        std::lock_guard _(db_->mutex);
+        for (auto const& e : db_->table)
+        {
+            if (!f(e.first.data()))
+                return false;
+        }
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
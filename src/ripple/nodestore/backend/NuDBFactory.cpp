@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <exception>
+#include <limits>
 #include <memory>
 #include <nudb/nudb.hpp>
 
@@ -51,6 +52,8 @@ public:
     nudb::store db_;
     std::atomic<bool> deletePath_;
     Scheduler& scheduler_;
+    // The size of the data file when the database was opened
+    std::uint64_t openDataBytes_ = 0;
 
     NuDBBackend(
         size_t keyBytes,
@@ -148,6 +151,7 @@ public:
         db_.open(dp, kp, lp, ec);
         if (ec)
             Throw<nudb::system_error>(ec);
+        openDataBytes_ = file_size(dp);
 
         /** Old value currentType is accepted for appnum in traditional
          *  databases, new value is used for deterministic shard databases.
@@ -327,6 +331,43 @@ public:
             Throw<nudb::system_error>(ec);
     }
 
+    bool
+    visitKeys(std::function<bool(void const* key)> const& f) override
+    {
+        auto const dp = (boost::filesystem::path(name_) / "nudb.dat").string();
+        // A database which doesn't exist yet holds no keys
+        if (!boost::filesystem::exists(dp))
+            return true;
+
+        // While the database is open, records are appended to the data
+        // file and the last one may be incomplete when it is read. Only
+        // the records that were in the file when it was opened need to be
+        // read in full.
+        std::uint64_t const needed = db_.is_open()
+            ? openDataBytes_
+            : std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t read = 0;
+        bool stopped = false;
+        nudb::error_code ec;
+        nudb::visit(
+            dp,
+            [&](void const* key,
+                std::size_t key_bytes,
+                void const*,
+                std::size_t,
+                nudb::error_code& vec) {
+                if (key_bytes != keyBytes_ || !f(key))
+                {
+                    stopped = true;
+                    vec = make_error_code(
+                        boost::system::errc::operation_canceled);
+                }
+            },
+            [&](std::uint64_t amount, std::uint64_t) { read = amount; },
+            ec);
+        return !stopped && (!ec || read >= needed);
+    }
+
     int
     getWriteLoad() override
     {
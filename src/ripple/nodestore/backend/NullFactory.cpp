@@ -86,6 +86,12 @@ public:
     {
     }
 
+    bool
+    visitKeys(std::function<bool(void const* key)> const& f) override
+    {
+        return true;
+    }
+
     int
     getWriteLoad() override
     {
@@ -413,6 +413,26 @@ public:
         }
     }
 
+    bool
+    visitKeys(std::function<bool(void const* key)> const& f) override
+    {
+        if (!m_db)
+            return false;
+
+        // Don't push the objects being read out of the cache
+        rocksdb::ReadOptions options;
+        options.fill_cache = false;
+
+        std::unique_ptr<rocksdb::Iterator> it(m_db->NewIterator(options));
+
+        for (it->SeekToFirst(); it->Valid(); it->Next())
+        {
+            if (it->key().size() == m_keyBytes && !f(it->key().data()))
+                return false;
+        }
+        return it->status().ok();
+    }
+
     int
     getWriteLoad() override
     {
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+#define RIPPLE_NODESTORE_BLOOMFILTER_H_INCLUDED
+
+#include <ripple/nodestore/NodeObject.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A blocked Bloom filter of node object keys.
+
+    Each key selects one 32 byte block and sets one bit in each of the
+    block's eight words, so a lookup reads a single cache line. With
+    the default of 12 bits per expected key the false positive rate is
+    about 0.5%.
+
+    Keys are the hashes of the objects they identify, so their bits are
+    used directly rather than being hashed again.
+
+    @note Keys can be inserted and looked up concurrently.
+*/
+class BloomFilter
+{
+public:
+    static constexpr std::size_t bitsPerKey = 12;
+
+    /** Create an empty filter.
+        @param keys The number of keys the filter is sized for.
+    */
+    explicit BloomFilter(std::size_t keys)
+        : blocks_(std::max<std::size_t>(
+              1,
+              (keys * bitsPerKey + blockBits - 1) / blockBits))
+        , words_(new std::atomic<std::uint32_t>[blocks_ * blockWords])
+    {
+        for (std::size_t i = 0; i < blocks_ * blockWords; ++i)
+            words_[i].store(0, std::memory_order_relaxed);
+    }
+
+    BloomFilter(BloomFilter const&) = delete;
+    BloomFilter&
+    operator=(BloomFilter const&) = delete;
+
+    /** Add a key of NodeObject::keyBytes bytes. */
+    void
+    insert(void const* key)
+    {
+        std::uint64_t bits;
+        auto const block = locate(key, bits);
+        for (std::size_t i = 0; i < blockWords; ++i, bits >>= 5)
+        {
+            block[i].fetch_or(
+                std::uint32_t{1} << (bits & 31), std::memory_order_relaxed);
+        }
+    }
+
+    /** Returns `false` if the key was certainly never inserted. */
+    bool
+    mayContain(void const* key) const
+    {
+        std::uint64_t bits;
+        auto const block = locate(key, bits);
+        for (std::size_t i = 0; i < blockWords; ++i, bits >>= 5)
+        {
+            auto const mask = std::uint32_t{1} << (bits & 31);
+            if ((block[i].load(std::memory_order_relaxed) & mask) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    /** Returns the size of the filter in bytes. */
+    std::size_t
+    size() const
+    {
+        return blocks_ * blockWords * sizeof(std::uint32_t);
+    }
+
+private:
+    static constexpr std::size_t blockWords = 8;
+    static constexpr std::size_t blockBits = blockWords * 32;
+
+    static_assert(NodeObject::keyBytes >= 2 * sizeof(std::uint64_t));
+
+    // Returns the block for the key, and the bits to set in it
+    std::atomic<std::uint32_t>*
+    locate(void const* key, std::uint64_t& bits) const
+    {
+        // Use the end of the key, since some keys have fixed prefixes
+        auto const p = static_cast<std::uint8_t const*>(key) +
+            NodeObject::keyBytes - 2 * sizeof(std::uint64_t);
+        std::uint64_t index;
+        std::memcpy(&index, p, sizeof(index));
+        std::memcpy(&bits, p + sizeof(index), sizeof(bits));
+        return &words_[(index % blocks_) * blockWords];
+    }
+
+    std::size_t const blocks_;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> words_;
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
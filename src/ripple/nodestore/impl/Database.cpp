@@ -354,6 +354,9 @@ Database::getCountsJson(Json::Value& obj)
         obj[jss::node_write_retries] = std::to_string(c->writeRetries);
         obj[jss::node_writes_delayed] = std::to_string(c->writesDelayed);
         obj[jss::node_writes_duration_us] = std::to_string(c->writeDurationUs);
+        obj[jss::node_reads_filtered] = std::to_string(c->filteredReads);
+        obj[jss::node_reads_filter_false_positives] =
+            std::to_string(c->filterFalsePositives);
     }
 }
 
@@ -115,6 +115,25 @@ DatabaseRotatingImp::store(
     storeStats(1, nObj->getData().size());
 }
 
+void
+DatabaseRotatingImp::storeBatch(Batch const& batch, std::uint32_t)
+{
+    if (batch.empty())
+        return;
+
+    auto const backend = [&] {
+        std::lock_guard lock(mutex_);
+        return writableBackend_;
+    }();
+
+    backend->storeBatch(batch);
+
+    std::uint64_t sz{0};
+    for (auto const& obj : batch)
+        sz += obj->getData().size();
+    storeStats(batch.size(), sz);
+}
+
 void
 DatabaseRotatingImp::sweep()
 {
@@ -207,5 +226,29 @@ DatabaseRotatingImp::for_each(
     archive->for_each(f);
 }
 
+std::optional<Backend::Counters<std::uint64_t>>
+DatabaseRotatingImp::getCounters() const
+{
+    auto [writable, archive] = [&] {
+        std::lock_guard lock(mutex_);
+        return std::make_pair(writableBackend_, archiveBackend_);
+    }();
+
+    auto counters = writable->counters();
+    if (auto const c = archive->counters())
+    {
+        if (!counters)
+            return c;
+        counters->writeDurationUs += c->writeDurationUs;
+        counters->writeRetries += c->writeRetries;
+        counters->writesDelayed += c->writesDelayed;
+        counters->readRetries += c->readRetries;
+        counters->readErrors += c->readErrors;
+        counters->filteredReads += c->filteredReads;
+        counters->filterFalsePositives += c->filterFalsePositives;
+    }
+    return counters;
+}
+
 }  // namespace NodeStore
 }  // namespace ripple
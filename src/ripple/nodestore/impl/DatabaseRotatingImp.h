@@ -70,6 +70,9 @@ public:
     store(NodeObjectType type, Blob&& data, uint256 const& hash, std::uint32_t)
         override;
 
+    void
+    storeBatch(Batch const& batch, std::uint32_t) override;
+
     void
     sync() override;
 
@@ -93,6 +96,9 @@ private:
 
     void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override;
+
+    std::optional<Backend::Counters<std::uint64_t>>
+    getCounters() const override;
 };
 
 }  // namespace NodeStore
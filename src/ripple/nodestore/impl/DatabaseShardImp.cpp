@@ -35,6 +35,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <condition_variable>
+#include <exception>
+
 #if BOOST_OS_LINUX
 #include <sys/statvfs.h>
 #endif
@@ -712,6 +715,7 @@ DatabaseShardImp::stop()
         shards_.clear();
     }
     taskQueue_.stop();
+    queryQueue_.stop();
 
     // All shards should be expired at this point
     for (auto const& wptr : shards)
@@ -1134,6 +1138,42 @@ DatabaseShardImp::store(
         storeStats(1, nodeObject->getData().size());
 }
 
+void
+DatabaseShardImp::storeBatch(Batch const& batch, std::uint32_t ledgerSeq)
+{
+    if (batch.empty())
+        return;
+
+    auto const shardIndex{seqToShardIndex(ledgerSeq)};
+    std::shared_ptr<Shard> shard;
+    {
+        std::lock_guard lock(mutex_);
+        if (shardIndex != acquireIndex_)
+        {
+            JLOG(j_.trace())
+                << "shard " << shardIndex << " is not being acquired";
+            return;
+        }
+
+        auto const it{shards_.find(shardIndex)};
+        if (it == shards_.end())
+        {
+            JLOG(j_.error())
+                << "shard " << shardIndex << " is not being acquired";
+            return;
+        }
+        shard = it->second;
+    }
+
+    if (shard->storeNodeObjects(batch))
+    {
+        std::uint64_t sz{0};
+        for (auto const& obj : batch)
+            sz += obj->getData().size();
+        storeStats(batch.size(), sz);
+    }
+}
+
 bool
 DatabaseShardImp::storeLedger(std::shared_ptr<Ledger const> const& srcLedger)
 {
@@ -2034,13 +2074,15 @@ DatabaseShardImp::callForLedgerSQLByShardIndex(
     const uint32_t shardIndex,
     std::function<bool(soci::session& session)> const& callback)
 {
-    std::lock_guard lock(mutex_);
-
-    auto const it{shards_.find(shardIndex)};
+    std::shared_ptr<Shard> shard;
+    {
+        std::lock_guard lock(mutex_);
+        if (auto const it{shards_.find(shardIndex)}; it != shards_.end())
+            shard = it->second;
+    }
 
-    return it != shards_.end() &&
-        it->second->getState() == ShardState::finalized &&
-        it->second->callForLedgerSQL(callback);
+    return shard && shard->getState() == ShardState::finalized &&
+        shard->callForLedgerSQL(callback);
 }
 
 bool
@@ -2057,13 +2099,15 @@ DatabaseShardImp::callForTransactionSQLByShardIndex(
     std::uint32_t const shardIndex,
     std::function<bool(soci::session& session)> const& callback)
 {
-    std::lock_guard lock(mutex_);
-
-    auto const it{shards_.find(shardIndex)};
+    std::shared_ptr<Shard> shard;
+    {
+        std::lock_guard lock(mutex_);
+        if (auto const it{shards_.find(shardIndex)}; it != shards_.end())
+            shard = it->second;
+    }
 
-    return it != shards_.end() &&
-        it->second->getState() == ShardState::finalized &&
-        it->second->callForTransactionSQL(callback);
+    return shard && shard->getState() == ShardState::finalized &&
+        shard->callForTransactionSQL(callback);
 }
 
 bool
@@ -2071,27 +2115,10 @@ DatabaseShardImp::iterateShardsForward(
     std::optional<std::uint32_t> minShardIndex,
     std::function<bool(Shard& shard)> const& visit)
 {
-    std::lock_guard lock(mutex_);
-
-    std::map<std::uint32_t, std::shared_ptr<Shard>>::iterator it, eit;
-
-    if (!minShardIndex)
-        it = shards_.begin();
-    else
-        it = shards_.lower_bound(*minShardIndex);
-
-    eit = shards_.end();
-
-    for (; it != eit; it++)
-    {
-        if (it->second->getState() == ShardState::finalized)
-        {
-            if (!visit(*it->second))
-                return false;
-        }
-    }
-
-    return true;
+    return visitShards(
+        finalShards(minShardIndex, true),
+        [](Shard& shard) { return shard.tryOpen(); },
+        visit);
 }
 
 bool
@@ -2123,28 +2150,10 @@ DatabaseShardImp::iterateShardsBack(
     std::optional<std::uint32_t> maxShardIndex,
     std::function<bool(Shard& shard)> const& visit)
 {
-    std::lock_guard lock(mutex_);
-
-    std::map<std::uint32_t, std::shared_ptr<Shard>>::reverse_iterator it, eit;
-
-    if (!maxShardIndex)
-        it = shards_.rbegin();
-    else
-        it = std::make_reverse_iterator(shards_.upper_bound(*maxShardIndex));
-
-    eit = shards_.rend();
-
-    for (; it != eit; it++)
-    {
-        if (it->second->getState() == ShardState::finalized &&
-            (!maxShardIndex || it->first <= *maxShardIndex))
-        {
-            if (!visit(*it->second))
-                return false;
-        }
-    }
-
-    return true;
+    return visitShards(
+        finalShards(maxShardIndex, false),
+        [](Shard& shard) { return shard.tryOpen(); },
+        visit);
 }
 
 bool
@@ -2169,6 +2178,224 @@ DatabaseShardImp::iterateTransactionSQLsBack(
     });
 }
 
+bool
+DatabaseShardImp::queryLedgerSQLsForward(
+    std::optional<std::uint32_t> minShardIndex,
+    std::function<void(soci::session& session, std::uint32_t shardIndex)> const&
+        query,
+    std::function<bool(std::uint32_t shardIndex)> const& merge)
+{
+    std::function<bool(soci::session& session, std::uint32_t shardIndex)> const
+        callback{[&query](soci::session& session, std::uint32_t shardIndex) {
+            query(session, shardIndex);
+            return true;
+        }};
+
+    return visitShards(
+        finalShards(minShardIndex, true),
+        [&callback](Shard& shard) { return shard.callForLedgerSQL(callback); },
+        [&merge](Shard& shard) { return merge(shard.index()); });
+}
+
+bool
+DatabaseShardImp::queryTransactionSQLsForward(
+    std::optional<std::uint32_t> minShardIndex,
+    std::function<void(soci::session& session, std::uint32_t shardIndex)> const&
+        query,
+    std::function<bool(std::uint32_t shardIndex)> const& merge)
+{
+    std::function<bool(soci::session& session, std::uint32_t shardIndex)> const
+        callback{[&query](soci::session& session, std::uint32_t shardIndex) {
+            query(session, shardIndex);
+            return true;
+        }};
+
+    return visitShards(
+        finalShards(minShardIndex, true),
+        [&callback](Shard& shard) {
+            return shard.callForTransactionSQL(callback);
+        },
+        [&merge](Shard& shard) { return merge(shard.index()); });
+}
+
+bool
+DatabaseShardImp::queryTransactionSQLsBack(
+    std::optional<std::uint32_t> maxShardIndex,
+    std::function<void(soci::session& session, std::uint32_t shardIndex)> const&
+        query,
+    std::function<bool(std::uint32_t shardIndex)> const& merge)
+{
+    std::function<bool(soci::session& session, std::uint32_t shardIndex)> const
+        callback{[&query](soci::session& session, std::uint32_t shardIndex) {
+            query(session, shardIndex);
+            return true;
+        }};
+
+    return visitShards(
+        finalShards(maxShardIndex, false),
+        [&callback](Shard& shard) {
+            return shard.callForTransactionSQL(callback);
+        },
+        [&merge](Shard& shard) { return merge(shard.index()); });
+}
+
+std::vector<std::shared_ptr<Shard>>
+DatabaseShardImp::finalShards(
+    std::optional<std::uint32_t> firstShardIndex,
+    bool ascending) const
+{
+    std::vector<std::shared_ptr<Shard>> shards;
+    auto const add = [&shards](auto it, auto const end) {
+        for (; it != end; ++it)
+        {
+            if (it->second->getState() == ShardState::finalized)
+                shards.push_back(it->second);
+        }
+    };
+
+    std::lock_guard lock(mutex_);
+
+    if (ascending)
+    {
+        add(firstShardIndex ? shards_.lower_bound(*firstShardIndex)
+                            : shards_.begin(),
+            shards_.end());
+    }
+    else if (firstShardIndex)
+    {
+        add(std::make_reverse_iterator(shards_.upper_bound(*firstShardIndex)),
+            shards_.rend());
+    }
+    else
+        add(shards_.rbegin(), shards_.rend());
+
+    return shards;
+}
+
+bool
+DatabaseShardImp::visitShards(
+    std::vector<std::shared_ptr<Shard>> const& shards,
+    std::function<bool(Shard& shard)> const& prepare,
+    std::function<bool(Shard& shard)> const& visit)
+{
+    enum class Step { pending, running, succeeded, failed, cancelled };
+
+    // Shared with the tasks, which may run after this function returns
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<Step> steps;
+        std::vector<std::exception_ptr> errors;
+        int running{0};
+    };
+
+    auto const state{std::make_shared<State>()};
+    state->steps.resize(shards.size(), Step::pending);
+    state->errors.resize(shards.size());
+
+    // Reopening shards may leave more open than the limit
+    bool const reopening{
+        std::any_of(shards.begin(), shards.end(), [](auto const& shard) {
+            return !shard->isOpen();
+        })};
+
+    // Prepare a shard unless it was already started or cancelled.
+    // The prepare function is only referenced while the task runs,
+    // and this function waits for all running tasks before returning.
+    auto const run = [state, &prepare](std::size_t i, Shard& shard) {
+        {
+            std::lock_guard lock(state->mutex);
+            if (state->steps[i] != Step::pending)
+                return;
+            state->steps[i] = Step::running;
+            ++state->running;
+        }
+
+        auto step{Step::failed};
+        std::exception_ptr error;
+        try
+        {
+            if (prepare(shard))
+                step = Step::succeeded;
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock(state->mutex);
+        state->steps[i] = step;
+        state->errors[i] = error;
+        --state->running;
+        state->cv.notify_all();
+    };
+
+    auto const finish = [&state] {
+        std::unique_lock lock(state->mutex);
+        for (auto& step : state->steps)
+        {
+            if (step == Step::pending)
+                step = Step::cancelled;
+        }
+        state->cv.wait(lock, [&state] { return state->running == 0; });
+    };
+
+    bool result{true};
+    try
+    {
+        std::size_t scheduled{0};
+        for (std::size_t i = 0; i < shards.size(); ++i)
+        {
+            // Prepare the shards that follow this one in the background
+            for (scheduled = std::max(scheduled, i + 1);
+                 scheduled < shards.size() && scheduled <= i + queryThreads_;
+                 ++scheduled)
+            {
+                queryQueue_.addTask(
+                    [run, i = scheduled, shard = shards[scheduled]]() {
+                        run(i, *shard);
+                    });
+            }
+
+            // Prepare this shard unless a task already has
+            run(i, *shards[i]);
+
+            std::unique_lock lock(state->mutex);
+            state->cv.wait(
+                lock, [&] { return state->steps[i] != Step::running; });
+
+            if (auto const error{state->errors[i]})
+                std::rethrow_exception(error);
+
+            if (state->steps[i] != Step::succeeded)
+            {
+                result = false;
+                break;
+            }
+
+            lock.unlock();
+            if (!visit(*shards[i]))
+            {
+                result = false;
+                break;
+            }
+        }
+    }
+    catch (...)
+    {
+        finish();
+        throw;
+    }
+
+    finish();
+
+    if (reopening)
+        sweep();
+
+    return result;
+}
+
 std::unique_ptr<ShardInfo>
 DatabaseShardImp::getShardInfo(std::lock_guard<std::mutex> const&) const
 {
@@ -123,6 +123,9 @@ public:
         uint256 const& hash,
         std::uint32_t ledgerSeq) override;
 
+    void
+    storeBatch(Batch const& batch, std::uint32_t ledgerSeq) override;
+
     void
     sync() override{};
 
@@ -192,6 +195,30 @@ public:
             bool(soci::session& session, std::uint32_t shardIndex)> const&
             callback) override;
 
+    bool
+    queryLedgerSQLsForward(
+        std::optional<std::uint32_t> minShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) override;
+
+    bool
+    queryTransactionSQLsForward(
+        std::optional<std::uint32_t> minShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) override;
+
+    bool
+    queryTransactionSQLsBack(
+        std::optional<std::uint32_t> maxShardIndex,
+        std::function<
+            void(soci::session& session, std::uint32_t shardIndex)> const&
+            query,
+        std::function<bool(std::uint32_t shardIndex)> const& merge) override;
+
 private:
     enum class PathDesignation : uint8_t {
         none,       // No path specified
@@ -239,6 +266,12 @@ private:
     // Queue of background tasks to be performed
     TaskQueue taskQueue_;
 
+    // The number of shards prepared concurrently when visiting shards
+    static constexpr int queryThreads_ = 4;
+
+    // Queue of shards being prepared for a visit
+    TaskQueue queryQueue_{"Shard store queries", queryThreads_};
+
     // Shards held by this server
     std::map<std::uint32_t, std::shared_ptr<Shard>> shards_;
 
@@ -408,6 +441,36 @@ private:
         std::optional<std::uint32_t> maxShardIndex,
         std::function<bool(Shard& shard)> const& visit);
 
+    /**
+     * @brief finalShards Returns the finalized shards starting from given
+     *        shard index in ascending or descending order.
+     * @param firstShardIndex Start shard index or none if all shards
+     *        should be returned.
+     * @param ascending True for ascending order, false for descending.
+     * @return The shards.
+     */
+    std::vector<std::shared_ptr<Shard>>
+    finalShards(std::optional<std::uint32_t> firstShardIndex, bool ascending)
+        const;
+
+    /**
+     * @brief visitShards Visits shards in order and calls given callback
+     *        function to each of them on the calling thread. Before a shard
+     *        is visited, it is prepared by another callback function, which
+     *        runs concurrently for several of the shards that follow the
+     *        one being visited.
+     * @param shards The shards to visit.
+     * @param prepare Callback function to call concurrently. Returns false
+     *        if the shard can't be visited.
+     * @param visit Callback function to call in order.
+     * @return True if each callback function returned true, false otherwise.
+     */
+    bool
+    visitShards(
+        std::vector<std::shared_ptr<Shard>> const& shards,
+        std::function<bool(Shard& shard)> const& prepare,
+        std::function<bool(Shard& shard)> const& visit);
+
     bool
     checkHistoricalPaths(std::lock_guard<std::mutex> const&) const;
 
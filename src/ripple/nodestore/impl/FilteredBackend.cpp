@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/Log.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/nodestore/impl/FilteredBackend.h>
+
+namespace ripple {
+namespace NodeStore {
+
+FilteredBackend::FilteredBackend(
+    std::unique_ptr<Backend> backend,
+    std::size_t keys,
+    beast::Journal j)
+    : backend_(std::move(backend)), filter_(keys), j_(j)
+{
+    JLOG(j_.debug()) << backend_->getName() << " Bloom filter uses "
+                     << filter_.size() << " bytes";
+}
+
+FilteredBackend::~FilteredBackend()
+{
+    stopLoading();
+}
+
+void
+FilteredBackend::open(bool createIfMissing)
+{
+    stopLoading();
+    ready_ = false;
+    backend_->open(createIfMissing);
+    startLoading();
+}
+
+void
+FilteredBackend::open(
+    bool createIfMissing,
+    uint64_t appType,
+    uint64_t uid,
+    uint64_t salt)
+{
+    stopLoading();
+    ready_ = false;
+    backend_->open(createIfMissing, appType, uid, salt);
+    startLoading();
+}
+
+void
+FilteredBackend::close()
+{
+    stopLoading();
+    ready_ = false;
+    backend_->close();
+}
+
+Status
+FilteredBackend::fetch(void const* key, std::shared_ptr<NodeObject>* pObject)
+{
+    bool const ready = ready_.load(std::memory_order_acquire);
+    if (ready && !filter_.mayContain(key))
+    {
+        ++filteredReads_;
+        pObject->reset();
+        return notFound;
+    }
+
+    auto const status = backend_->fetch(key, pObject);
+    if (ready && status == notFound)
+        ++falsePositives_;
+    return status;
+}
+
+std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+FilteredBackend::fetchBatch(std::vector<uint256 const*> const& hashes)
+{
+    if (!ready_.load(std::memory_order_acquire))
+        return backend_->fetchBatch(hashes);
+
+    // Only ask the backend for the keys that may be present
+    std::vector<std::size_t> indexes;
+    std::vector<uint256 const*> found;
+    indexes.reserve(hashes.size());
+    found.reserve(hashes.size());
+    for (std::size_t i = 0; i < hashes.size(); ++i)
+    {
+        if (filter_.mayContain(hashes[i]->data()))
+        {
+            indexes.push_back(i);
+            found.push_back(hashes[i]);
+        }
+    }
+
+    filteredReads_ += hashes.size() - found.size();
+
+    std::vector<std::shared_ptr<NodeObject>> results(hashes.size());
+    if (found.empty())
+        return {std::move(results), ok};
+
+    auto [objects, status] = backend_->fetchBatch(found);
+    for (std::size_t i = 0; i < objects.size() && i < indexes.size(); ++i)
+    {
+        if (objects[i])
+            results[indexes[i]] = std::move(objects[i]);
+        else if (status == ok)
+            ++falsePositives_;
+    }
+    return {std::move(results), status};
+}
+
+void
+FilteredBackend::store(std::shared_ptr<NodeObject> const& object)
+{
+    // Add the key first, so a concurrent fetch never misses the object
+    filter_.insert(object->getHash().data());
+    backend_->store(object);
+}
+
+void
+FilteredBackend::storeBatch(Batch const& batch)
+{
+    for (auto const& object : batch)
+        filter_.insert(object->getHash().data());
+    backend_->storeBatch(batch);
+}
+
+std::optional<Backend::Counters<std::uint64_t>>
+FilteredBackend::counters() const
+{
+    auto counters = backend_->counters().value_or(Counters<std::uint64_t>{});
+    counters.filteredReads += filteredReads_.load();
+    counters.filterFalsePositives += falsePositives_.load();
+    return counters;
+}
+
+bool
+FilteredBackend::fill()
+{
+    std::size_t count = 0;
+    bool const complete = backend_->visitKeys([&](void const* key) {
+        filter_.insert(key);
+        ++count;
+        return !stopping_.load(std::memory_order_relaxed);
+    });
+
+    if (!complete || stopping_)
+        return false;
+
+    ready_.store(true, std::memory_order_release);
+    JLOG(j_.info()) << backend_->getName() << " Bloom filter loaded " << count
+                    << " keys";
+    return true;
+}
+
+void
+FilteredBackend::startLoading()
+{
+    stopping_ = false;
+    loader_ = std::thread([this] {
+        beast::setCurrentThreadName("prog #filter");
+
+        try
+        {
+            if (!fill() && !stopping_)
+            {
+                JLOG(j_.warn()) << backend_->getName()
+                                << " Bloom filter disabled: unable to read "
+                                   "the keys in the database";
+            }
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << backend_->getName()
+                            << " Bloom filter disabled: " << e.what();
+        }
+    });
+}
+
+void
+FilteredBackend::stopLoading()
+{
+    stopping_ = true;
+    if (loader_.joinable())
+        loader_.join();
+}
+
+}  // namespace NodeStore
+}  // namespace ripple
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_FILTEREDBACKEND_H_INCLUDED
+#define RIPPLE_NODESTORE_FILTEREDBACKEND_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/nodestore/Backend.h>
+#include <ripple/nodestore/impl/BloomFilter.h>
+#include <atomic>
+#include <thread>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A backend which answers lookups of missing objects from memory.
+
+    Every key stored in the wrapped backend is added to a Bloom filter,
+    and a fetch of a key the filter has never seen reports the object
+    as not found without reading the database.
+
+    The keys already in the backend are added to the filter by a
+    background thread after it is opened, so opening it doesn't wait for
+    the database to be read. Until that completes, or if the keys can't
+    be listed, every fetch goes to the database.
+*/
+class FilteredBackend : public Backend
+{
+private:
+    std::unique_ptr<Backend> const backend_;
+    BloomFilter filter_;
+    beast::Journal const j_;
+
+    std::atomic<bool> ready_{false};
+    std::atomic<bool> stopping_{false};
+    std::thread loader_;
+
+    std::atomic<std::uint64_t> filteredReads_{0};
+    std::atomic<std::uint64_t> falsePositives_{0};
+
+public:
+    /** Create a filter in front of a backend.
+        @param backend The backend to wrap, which must not be open.
+        @param keys The number of keys to size the filter for.
+    */
+    FilteredBackend(
+        std::unique_ptr<Backend> backend,
+        std::size_t keys,
+        beast::Journal j);
+
+    ~FilteredBackend() override;
+
+    std::string
+    getName() override
+    {
+        return backend_->getName();
+    }
+
+    void
+    open(bool createIfMissing) override;
+
+    void
+    open(bool createIfMissing, uint64_t appType, uint64_t uid, uint64_t salt)
+        override;
+
+    bool
+    isOpen() override
+    {
+        return backend_->isOpen();
+    }
+
+    void
+    close() override;
+
+    Status
+    fetch(void const* key, std::shared_ptr<NodeObject>* pObject) override;
+
+    std::pair<std::vector<std::shared_ptr<NodeObject>>, Status>
+    fetchBatch(std::vector<uint256 const*> const& hashes) override;
+
+    void
+    store(std::shared_ptr<NodeObject> const& object) override;
+
+    void
+    storeBatch(Batch const& batch) override;
+
+    void
+    sync() override
+    {
+        backend_->sync();
+    }
+
+    void
+    for_each(std::function<void(std::shared_ptr<NodeObject>)> f) override
+    {
+        backend_->for_each(f);
+    }
+
+    bool
+    visitKeys(std::function<bool(void const* key)> const& f) override
+    {
+        return backend_->visitKeys(f);
+    }
+
+    int
+    getWriteLoad() override
+    {
+        return backend_->getWriteLoad();
+    }
+
+    void
+    setDeletePath() override
+    {
+        backend_->setDeletePath();
+    }
+
+    void
+    verify() override
+    {
+        backend_->verify();
+    }
+
+    int
+    fdRequired() const override
+    {
+        return backend_->fdRequired();
+    }
+
+    std::optional<Counters<std::uint64_t>>
+    counters() const override;
+
+private:
+    // Add the keys in the backend to the filter, returns `true` if all
+    // of them were added
+    bool
+    fill();
+
+    // Start adding the keys to the filter in the background
+    void
+    startLoading();
+
+    // Wait for the keys to stop being added
+    void
+    stopLoading();
+};
+
+}  // namespace NodeStore
+}  // namespace ripple
+
+#endif
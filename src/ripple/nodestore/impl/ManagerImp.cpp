@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/nodestore/impl/DatabaseNodeImp.h>
+#include <ripple/nodestore/impl/FilteredBackend.h>
 #include <ripple/nodestore/impl/ManagerImp.h>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -64,8 +65,16 @@ ManagerImp::make_Backend(
         missing_backend();
     }
 
-    return factory->createInstance(
+    auto backend = factory->createInstance(
         NodeObject::keyBytes, parameters, burstSize, scheduler, journal);
+
+    if (auto const keys = get<std::size_t>(parameters, "bloom_filter_items", 0))
+    {
+        return std::make_unique<FilteredBackend>(
+            std::move(backend), keys, journal);
+    }
+
+    return backend;
 }
 
 std::unique_ptr<Database>
@@ -184,6 +184,12 @@ Shard::tryClose()
     return true;
 }
 
+bool
+Shard::tryOpen()
+{
+    return static_cast<bool>(makeBackendCount());
+}
+
 std::optional<std::uint32_t>
 Shard::prepare()
 {
@@ -240,6 +246,37 @@ Shard::storeNodeObject(std::shared_ptr<NodeObject> const& nodeObject)
     return true;
 }
 
+bool
+Shard::storeNodeObjects(Batch const& batch)
+{
+    if (state_ != ShardState::acquire)
+    {
+        // Let storeNodeObject sort out the import node store exception
+        bool stored{false};
+        for (auto const& nodeObject : batch)
+            stored = storeNodeObject(nodeObject) || stored;
+        return stored;
+    }
+
+    auto const scopedCount{makeBackendCount()};
+    if (!scopedCount)
+        return false;
+
+    try
+    {
+        backend_->storeBatch(batch);
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j_.fatal()) << "shard " << index_
+                         << ". Exception caught in function " << __func__
+                         << ". Error: " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
 std::shared_ptr<NodeObject>
 Shard::fetchNodeObject(uint256 const& hash, FetchReport& fetchReport)
 {
@@ -103,6 +103,13 @@ public:
     bool
     tryClose();
 
+    /** Open databases closed by tryClose.
+
+        @return true if the databases are open.
+     */
+    bool
+    tryOpen();
+
     /** Notify shard to prepare for shutdown.
      */
     void
@@ -117,6 +124,9 @@ public:
     [[nodiscard]] bool
     storeNodeObject(std::shared_ptr<NodeObject> const& nodeObject);
 
+    [[nodiscard]] bool
+    storeNodeObjects(Batch const& batch);
+
     [[nodiscard]] std::shared_ptr<NodeObject>
     fetchNodeObject(uint256 const& hash, FetchReport& fetchReport);
 
@@ -225,7 +235,7 @@ public:
     bool
     callForLedgerSQL(std::function<bool(Args... args)> const& callback)
     {
-        return callForSQL(callback, lgrSQLiteDB_->checkoutDb());
+        return callForSQL(callback, lgrSQLiteDB_);
     }
 
     /** Invoke a callback on the transaction SQLite db
@@ -237,7 +247,7 @@ public:
     bool
     callForTransactionSQL(std::function<bool(Args... args)> const& callback)
     {
-        return callForSQL(callback, txSQLiteDB_->checkoutDb());
+        return callForSQL(callback, txSQLiteDB_);
     }
 
     // Current shard version
@@ -392,18 +402,19 @@ private:
     [[nodiscard]] Shard::Count
     makeBackendCount();
 
-    // Invoke a callback on the supplied session parameter
+    // Invoke a callback on a session with the supplied database.
+    // The database is only valid once the shard has been opened.
     template <typename... Args>
     bool
     callForSQL(
         std::function<bool(Args... args)> const& callback,
-        LockedSociSession&& db)
+        std::unique_ptr<DatabaseCon> const& db)
     {
         auto const scopedCount{makeBackendCount()};
         if (!scopedCount)
             return false;
 
-        return doCallForSQL(callback, std::move(db));
+        return doCallForSQL(callback, db->checkoutDb());
     }
 
     // Invoke a callback that accepts a SQLite session parameter
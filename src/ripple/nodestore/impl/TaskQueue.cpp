@@ -24,7 +24,12 @@
 namespace ripple {
 namespace NodeStore {
 
-TaskQueue::TaskQueue() : workers_(*this, nullptr, "Shard store taskQueue", 1)
+TaskQueue::TaskQueue() : TaskQueue("Shard store taskQueue", 1)
+{
+}
+
+TaskQueue::TaskQueue(std::string const& threadNames, int numberOfThreads)
+    : workers_(*this, nullptr, threadNames, numberOfThreads)
 {
 }
 
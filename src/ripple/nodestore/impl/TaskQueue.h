@@ -33,6 +33,13 @@ class TaskQueue : private Workers::Callback
 public:
     TaskQueue();
 
+    /** Create a queue whose tasks are performed concurrently
+
+        @param threadNames The name of the threads performing tasks
+        @param numberOfThreads The number of threads performing tasks
+    */
+    TaskQueue(std::string const& threadNames, int numberOfThreads);
+
     void
     stop();
 
@@ -31,12 +31,28 @@ namespace compression {
 std::size_t constexpr headerBytes = 6;
 std::size_t constexpr headerBytesCompressed = 10;
 
+// The largest message compressed with the dictionary. Larger messages
+// repeat enough of their own content that the dictionary no longer makes
+// them smaller, while loading it still costs time.
+std::size_t constexpr lz4DictMaxBytes = 2048;
+
 // All values other than 'none' must have the high bit. The low order four bits
 // must be 0.
-enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90 };
+enum class Algorithm : std::uint8_t { None = 0x00, LZ4 = 0x90, LZ4Dict = 0xA0 };
 
 enum class Compressed : std::uint8_t { On, Off };
 
+/** The dictionary that LZ4Dict compression primes LZ4 with.
+
+    It holds byte sequences common to serialized transactions, metadata,
+    ledger entries and SHAMap nodes, which lets small messages refer to
+    them instead of spelling them out. Peers that negotiate LZ4Dict must
+    use the same dictionary, so its contents may only change along with
+    the name the algorithm is negotiated under.
+*/
+Slice
+lz4Dictionary();
+
 /** Decompress input stream.
  * @tparam InputStream ZeroCopyInputStream
  * @param in Input source stream
@@ -59,6 +75,9 @@ decompress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Decompress(
                 in, inSize, decompressed, decompressedSize);
+        else if (algorithm == Algorithm::LZ4Dict)
+            return ripple::compression_algorithms::lz4Decompress(
+                in, inSize, decompressed, decompressedSize, lz4Dictionary());
         else
         {
             JLOG(debugLog().warn())
@@ -95,6 +114,9 @@ compress(
         if (algorithm == Algorithm::LZ4)
             return ripple::compression_algorithms::lz4Compress(
                 in, inSize, std::forward<BufferFactory>(bf));
+        else if (algorithm == Algorithm::LZ4Dict)
+            return ripple::compression_algorithms::lz4Compress(
+                in, inSize, std::forward<BufferFactory>(bf), lz4Dictionary());
         else
         {
             JLOG(debugLog().warn()) << "compress: invalid compression algorithm"
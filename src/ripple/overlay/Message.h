@@ -53,9 +53,10 @@ constexpr std::size_t maximiumMessageSize = megabytes(64);
 class Message : public std::enable_shared_from_this<Message>
 {
     using Compressed = compression::Compressed;
-    using Algorithm = compression::Algorithm;
 
 public:
+    using Algorithm = compression::Algorithm;
+
     /** Constructor
      * @param message Protocol message to serialize
      * @param type Protocol message type
@@ -81,10 +82,13 @@ public:
      * the message is not compressible then the uncompressed buffer is returned.
      * @param compressed Request compressed (Compress::On) or
      *     uncompressed (Compress::Off) payload buffer
+     * @param algorithm The best compression algorithm the peer accepts.
+     *     The message may be compressed with plain LZ4 instead, depending
+     *     on its type.
      * @return Payload buffer
      */
     std::vector<uint8_t> const&
-    getBuffer(Compressed tryCompressed);
+    getBuffer(Compressed tryCompressed, Algorithm algorithm = Algorithm::LZ4);
 
     /** Get the traffic category */
     std::size_t
@@ -103,16 +107,18 @@ public:
 private:
     std::vector<uint8_t> buffer_;
     std::vector<uint8_t> bufferCompressed_;
+    std::vector<uint8_t> bufferCompressedDict_;
     std::size_t category_;
     std::once_flag once_flag_;
+    std::once_flag onceFlagDict_;
     std::optional<PublicKey> validatorKey_;
 
     /** Set the payload header
      * @param in Pointer to the payload
      * @param payloadBytes Size of the payload excluding the header size
      * @param type Protocol message type
-     * @param compression Compression algorithm used in compression,
-     *   currently LZ4 only. If None then the message is uncompressed.
+     * @param compression Compression algorithm used in compression.
+     *   If None then the message is uncompressed.
      * @param uncompressedBytes Size of the uncompressed message
      */
     void
@@ -124,11 +130,14 @@ private:
         std::uint32_t uncompressedBytes);
 
     /** Try to compress the payload.
-     * Can be called concurrently by multiple peers but is compressed once.
-     * If the message is not compressible then the serialized buffer_ is used.
+     * Called once for each algorithm, even if multiple peers request it
+     * concurrently. If the message does not compress then the compressed
+     * buffer is left empty and the serialized buffer_ is used.
+     * @param algorithm Compression algorithm
+     * @param compressed Buffer to hold the header and compressed payload
      */
     void
-    compress();
+    compress(Algorithm algorithm, std::vector<uint8_t>& compressed);
 
     /** Get the message type from the payload header.
      * First four bytes are the compression/algorithm flag and the payload size.
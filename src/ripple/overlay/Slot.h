@@ -37,6 +37,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace ripple {
 
@@ -113,7 +114,8 @@ private:
      * @param handler Squelch/Unsquelch implementation
      */
     Slot(SquelchHandler const& handler, beast::Journal journal)
-        : reachedThreshold_(0)
+        : consideredSize_(0)
+        , reachedThreshold_(0)
         , lastSelected_(clock_type::now())
         , state_(SlotState::Counting)
         , handler_(handler)
@@ -214,18 +216,37 @@ private:
     void
     initCounting();
 
-    /** Data maintained for each peer */
-    struct PeerInfo
-    {
-        PeerState state;         // peer's state
-        std::size_t count;       // message count
-        time_point expire;       // squelch expiration time
-        time_point lastMessage;  // time last message received
-    };
-    std::unordered_map<id_t, PeerInfo> peers_;  // peer's data
-    // pool of peers considered as the source of messages
-    // from validator - peers that reached MIN_MESSAGE_THRESHOLD
-    std::unordered_set<id_t> considered_;
+    /** Return the index of the peer, or the number of peers if the
+     * peer is not in the slot */
+    std::size_t
+    find(id_t id) const;
+
+    /** Add a peer in Counting state, return its index */
+    std::size_t
+    addPeer(id_t id, time_point now);
+
+    /** Remove the peer at the index */
+    void
+    erasePeer(std::size_t i);
+
+    /** Remove the peer at the index from the considered pool */
+    void
+    unconsider(std::size_t i);
+
+    // Peers' data, one array per field, indexed by the peer's position in
+    // ids_. ids_ is sorted, so a peer is found with a binary search, and the
+    // per-message update and the scans over all peers only touch the
+    // fields they need. A slot has one entry per connected peer.
+    std::vector<id_t> ids_;                 // peer's id
+    std::vector<PeerState> states_;         // peer's state
+    std::vector<std::size_t> counts_;       // message count
+    std::vector<time_point> expires_;       // squelch expiration time
+    std::vector<time_point> lastMessages_;  // time last message received
+    // whether the peer is in the pool of peers considered as the source of
+    // messages from validator - peers that reached MIN_MESSAGE_THRESHOLD
+    std::vector<std::uint8_t> considered_;
+    // number of peers in the considered pool
+    std::size_t consideredSize_;
     // number of peers that reached MAX_MESSAGE_THRESHOLD
     std::uint16_t reachedThreshold_;
     // last time peers were selected, used to age the slot
@@ -241,19 +262,17 @@ Slot<clock_type>::deleteIdlePeer(PublicKey const& validator)
 {
     using namespace std::chrono;
     auto now = clock_type::now();
-    for (auto it = peers_.begin(); it != peers_.end();)
+    // The peers are not erased, so the indexes stay valid
+    for (std::size_t i = 0; i < ids_.size(); ++i)
     {
-        auto& peer = it->second;
-        auto id = it->first;
-        ++it;
-        if (now - peer.lastMessage > IDLED)
+        if (now - lastMessages_[i] > IDLED)
         {
             JLOG(journal_.trace())
-                << "deleteIdlePeer: " << Slice(validator) << " " << id
+                << "deleteIdlePeer: " << Slice(validator) << " " << ids_[i]
                 << " idled "
-                << duration_cast<seconds>(now - peer.lastMessage).count()
-                << " selected " << (peer.state == PeerState::Selected);
-            deletePeer(validator, id, false);
+                << duration_cast<seconds>(now - lastMessages_[i]).count()
+                << " selected " << (states_[i] == PeerState::Selected);
+            deletePeer(validator, ids_[i], false);
         }
     }
 }
@@ -267,46 +286,46 @@ Slot<clock_type>::update(
 {
     using namespace std::chrono;
     auto now = clock_type::now();
-    auto it = peers_.find(id);
+    auto const i = find(id);
     // First message from this peer
-    if (it == peers_.end())
+    if (i == ids_.size())
     {
         JLOG(journal_.trace())
             << "update: adding peer " << Slice(validator) << " " << id;
-        peers_.emplace(
-            std::make_pair(id, PeerInfo{PeerState::Counting, 0, now, now}));
+        addPeer(id, now);
         initCounting();
         return;
     }
     // Message from a peer with expired squelch
-    if (it->second.state == PeerState::Squelched && now > it->second.expire)
+    if (states_[i] == PeerState::Squelched && now > expires_[i])
     {
         JLOG(journal_.trace())
             << "update: squelch expired " << Slice(validator) << " " << id;
-        it->second.state = PeerState::Counting;
-        it->second.lastMessage = now;
+        states_[i] = PeerState::Counting;
+        lastMessages_[i] = now;
         initCounting();
         return;
     }
 
-    auto& peer = it->second;
-
     JLOG(journal_.trace())
         << "update: existing peer " << Slice(validator) << " " << id
         << " slot state " << static_cast<int>(state_) << " peer state "
-        << static_cast<int>(peer.state) << " count " << peer.count << " last "
-        << duration_cast<milliseconds>(now - peer.lastMessage).count()
-        << " pool " << considered_.size() << " threshold " << reachedThreshold_
+        << static_cast<int>(states_[i]) << " count " << counts_[i] << " last "
+        << duration_cast<milliseconds>(now - lastMessages_[i]).count()
+        << " pool " << consideredSize_ << " threshold " << reachedThreshold_
         << " " << (type == protocol::mtVALIDATION ? "validation" : "proposal");
 
-    peer.lastMessage = now;
+    lastMessages_[i] = now;
 
-    if (state_ != SlotState::Counting || peer.state == PeerState::Squelched)
+    if (state_ != SlotState::Counting || states_[i] == PeerState::Squelched)
         return;
 
-    if (++peer.count > MIN_MESSAGE_THRESHOLD)
-        considered_.insert(id);
-    if (peer.count == (MAX_MESSAGE_THRESHOLD + 1))
+    if (++counts_[i] > MIN_MESSAGE_THRESHOLD && !considered_[i])
+    {
+        considered_[i] = true;
+        ++consideredSize_;
+    }
+    if (counts_[i] == (MAX_MESSAGE_THRESHOLD + 1))
         ++reachedThreshold_;
 
     if (now - lastSelected_ > 2 * MAX_UNSQUELCH_EXPIRE_DEFAULT)
@@ -326,24 +345,24 @@ Slot<clock_type>::update(
         // If number of remaining peers != MAX_SELECTED_PEERS
         // then reset the Counting state and let deleteIdlePeer() handle
         // idled peers.
-        std::unordered_set<id_t> selected;
-        auto const consideredPoolSize = considered_.size();
-        while (selected.size() != MAX_SELECTED_PEERS && considered_.size() != 0)
+        std::vector<std::size_t> pool;
+        pool.reserve(consideredSize_);
+        for (std::size_t j = 0; j < ids_.size(); ++j)
         {
-            auto i =
-                considered_.size() == 1 ? 0 : rand_int(considered_.size() - 1);
-            auto it = std::next(considered_.begin(), i);
-            auto id = *it;
-            considered_.erase(it);
-            auto const& itpeers = peers_.find(id);
-            if (itpeers == peers_.end())
-            {
-                JLOG(journal_.error()) << "update: peer not found "
-                                       << Slice(validator) << " " << id;
-                continue;
-            }
-            if (now - itpeers->second.lastMessage < IDLED)
-                selected.insert(id);
+            if (considered_[j])
+                pool.push_back(j);
+        }
+
+        std::vector<std::size_t> selected;
+        auto const consideredPoolSize = pool.size();
+        while (selected.size() != MAX_SELECTED_PEERS && pool.size() != 0)
+        {
+            auto k = pool.size() == 1 ? 0 : rand_int(pool.size() - 1);
+            auto const j = pool[k];
+            pool[k] = pool.back();
+            pool.pop_back();
+            if (now - lastMessages_[j] < IDLED)
+                selected.push_back(j);
         }
 
         if (selected.size() != MAX_SELECTED_PEERS)
@@ -356,37 +375,38 @@ Slot<clock_type>::update(
 
         lastSelected_ = now;
 
-        auto s = selected.begin();
         JLOG(journal_.trace())
             << "update: " << Slice(validator) << " " << id << " pool size "
-            << consideredPoolSize << " selected " << *s << " "
-            << *std::next(s, 1) << " " << *std::next(s, 2);
+            << consideredPoolSize << " selected " << ids_[selected[0]] << " "
+            << ids_[selected[1]] << " " << ids_[selected[2]];
 
-        assert(peers_.size() >= MAX_SELECTED_PEERS);
+        assert(ids_.size() >= MAX_SELECTED_PEERS);
 
         // squelch peers which are not selected and
         // not already squelched
         std::stringstream str;
-        for (auto& [k, v] : peers_)
+        for (std::size_t j = 0; j < ids_.size(); ++j)
         {
-            v.count = 0;
+            counts_[j] = 0;
 
-            if (selected.find(k) != selected.end())
-                v.state = PeerState::Selected;
-            else if (v.state != PeerState::Squelched)
+            if (std::find(selected.begin(), selected.end(), j) !=
+                selected.end())
+                states_[j] = PeerState::Selected;
+            else if (states_[j] != PeerState::Squelched)
             {
                 if (journal_.trace())
-                    str << k << " ";
-                v.state = PeerState::Squelched;
+                    str << ids_[j] << " ";
+                states_[j] = PeerState::Squelched;
                 std::chrono::seconds duration =
-                    getSquelchDuration(peers_.size() - MAX_SELECTED_PEERS);
-                v.expire = now + duration;
-                handler_.squelch(validator, k, duration.count());
+                    getSquelchDuration(ids_.size() - MAX_SELECTED_PEERS);
+                expires_[j] = now + duration;
+                handler_.squelch(validator, ids_[j], duration.count());
             }
         }
         JLOG(journal_.trace()) << "update: squelching " << Slice(validator)
                                << " " << id << " " << str.str();
-        considered_.clear();
+        std::fill(considered_.begin(), considered_.end(), false);
+        consideredSize_ = 0;
         reachedThreshold_ = 0;
         state_ = SlotState::Selected;
     }
@@ -412,42 +432,42 @@ template <typename clock_type>
 void
 Slot<clock_type>::deletePeer(PublicKey const& validator, id_t id, bool erase)
 {
-    auto it = peers_.find(id);
-    if (it != peers_.end())
+    auto const i = find(id);
+    if (i != ids_.size())
     {
         JLOG(journal_.trace())
             << "deletePeer: " << Slice(validator) << " " << id << " selected "
-            << (it->second.state == PeerState::Selected) << " considered "
-            << (considered_.find(id) != considered_.end()) << " erase "
-            << erase;
+            << (states_[i] == PeerState::Selected) << " considered "
+            << static_cast<bool>(considered_[i]) << " erase " << erase;
         auto now = clock_type::now();
-        if (it->second.state == PeerState::Selected)
+        if (states_[i] == PeerState::Selected)
         {
-            for (auto& [k, v] : peers_)
+            for (std::size_t j = 0; j < ids_.size(); ++j)
             {
-                if (v.state == PeerState::Squelched)
-                    handler_.unsquelch(validator, k);
-                v.state = PeerState::Counting;
-                v.count = 0;
-                v.expire = now;
+                if (states_[j] == PeerState::Squelched)
+                    handler_.unsquelch(validator, ids_[j]);
+                states_[j] = PeerState::Counting;
+                counts_[j] = 0;
+                expires_[j] = now;
             }
 
-            considered_.clear();
+            std::fill(considered_.begin(), considered_.end(), false);
+            consideredSize_ = 0;
             reachedThreshold_ = 0;
             state_ = SlotState::Counting;
         }
-        else if (considered_.find(id) != considered_.end())
+        else if (considered_[i])
         {
-            if (it->second.count > MAX_MESSAGE_THRESHOLD)
+            if (counts_[i] > MAX_MESSAGE_THRESHOLD)
                 --reachedThreshold_;
-            considered_.erase(id);
+            unconsider(i);
         }
 
-        it->second.lastMessage = now;
-        it->second.count = 0;
+        lastMessages_[i] = now;
+        counts_[i] = 0;
 
         if (erase)
-            peers_.erase(it);
+            erasePeer(i);
     }
 }
 
@@ -455,11 +475,7 @@ template <typename clock_type>
 void
 Slot<clock_type>::resetCounts()
 {
-    for (auto& [_, peer] : peers_)
-    {
-        (void)_;
-        peer.count = 0;
-    }
+    std::fill(counts_.begin(), counts_.end(), 0);
 }
 
 template <typename clock_type>
@@ -467,43 +483,86 @@ void
 Slot<clock_type>::initCounting()
 {
     state_ = SlotState::Counting;
-    considered_.clear();
+    std::fill(considered_.begin(), considered_.end(), false);
+    consideredSize_ = 0;
     reachedThreshold_ = 0;
     resetCounts();
 }
 
+template <typename clock_type>
+std::size_t
+Slot<clock_type>::find(id_t id) const
+{
+    auto const it = std::lower_bound(ids_.begin(), ids_.end(), id);
+    if (it != ids_.end() && *it == id)
+        return it - ids_.begin();
+    return ids_.size();
+}
+
+template <typename clock_type>
+std::size_t
+Slot<clock_type>::addPeer(id_t id, time_point now)
+{
+    auto const i = static_cast<std::size_t>(
+        std::lower_bound(ids_.begin(), ids_.end(), id) - ids_.begin());
+    ids_.insert(ids_.begin() + i, id);
+    states_.insert(states_.begin() + i, PeerState::Counting);
+    counts_.insert(counts_.begin() + i, 0);
+    expires_.insert(expires_.begin() + i, now);
+    lastMessages_.insert(lastMessages_.begin() + i, now);
+    considered_.insert(considered_.begin() + i, false);
+    return i;
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::erasePeer(std::size_t i)
+{
+    unconsider(i);
+    ids_.erase(ids_.begin() + i);
+    states_.erase(states_.begin() + i);
+    counts_.erase(counts_.begin() + i);
+    expires_.erase(expires_.begin() + i);
+    lastMessages_.erase(lastMessages_.begin() + i);
+    considered_.erase(considered_.begin() + i);
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::unconsider(std::size_t i)
+{
+    if (considered_[i])
+    {
+        considered_[i] = false;
+        --consideredSize_;
+    }
+}
+
 template <typename clock_type>
 std::uint16_t
 Slot<clock_type>::inState(PeerState state) const
 {
-    return std::count_if(peers_.begin(), peers_.end(), [&](auto const& it) {
-        return (it.second.state == state);
-    });
+    return std::count(states_.begin(), states_.end(), state);
 }
 
 template <typename clock_type>
 std::uint16_t
 Slot<clock_type>::notInState(PeerState state) const
 {
-    return std::count_if(peers_.begin(), peers_.end(), [&](auto const& it) {
-        return (it.second.state != state);
-    });
+    return states_.size() - inState(state);
 }
 
 template <typename clock_type>
 std::set<typename Peer::id_t>
 Slot<clock_type>::getSelected() const
 {
-    std::set<id_t> init;
-    return std::accumulate(
-        peers_.begin(), peers_.end(), init, [](auto& init, auto const& it) {
-            if (it.second.state == PeerState::Selected)
-            {
-                init.insert(it.first);
-                return init;
-            }
-            return init;
-        });
+    std::set<id_t> selected;
+    for (std::size_t i = 0; i < ids_.size(); ++i)
+    {
+        if (states_[i] == PeerState::Selected)
+            selected.insert(ids_[i]);
+    }
+    return selected;
 }
 
 template <typename clock_type>
@@ -513,20 +572,21 @@ std::unordered_map<
 Slot<clock_type>::getPeers() const
 {
     using namespace std::chrono;
-    auto init = std::unordered_map<
+    std::unordered_map<
         id_t,
-        std::tuple<PeerState, std::uint16_t, std::uint32_t, std::uint32_t>>();
-    return std::accumulate(
-        peers_.begin(), peers_.end(), init, [](auto& init, auto const& it) {
-            init.emplace(std::make_pair(
-                it.first,
-                std::move(std::make_tuple(
-                    it.second.state,
-                    it.second.count,
-                    epoch<milliseconds>(it.second.expire).count(),
-                    epoch<milliseconds>(it.second.lastMessage).count()))));
-            return init;
-        });
+        std::tuple<PeerState, std::uint16_t, std::uint32_t, std::uint32_t>>
+        peers;
+    for (std::size_t i = 0; i < ids_.size(); ++i)
+    {
+        peers.emplace(
+            ids_[i],
+            std::make_tuple(
+                states_[i],
+                counts_[i],
+                epoch<milliseconds>(expires_[i]).count(),
+                epoch<milliseconds>(lastMessages_[i]).count()));
+    }
+    return peers;
 }
 
 /** Slots is a container for validator's Slot and handles Slot update
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/Compression.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/SField.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFlags.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
+#include <initializer_list>
+
+namespace ripple {
+namespace compression {
+
+namespace {
+
+// The byte sequences that recur across serialized objects are field
+// headers along with their most common values. The compressor only
+// refers to sequences of four or more bytes, so a header is of use
+// together with the bytes around it.
+Blob
+makeLZ4Dictionary()
+{
+    Serializer s;
+    auto field = [&s](SField const& f) {
+        s.addFieldID(f.fieldType, f.fieldValue);
+    };
+    auto endObject = [&s] { s.addFieldID(STI_OBJECT, 1); };
+    auto endArray = [&s] { s.addFieldID(STI_ARRAY, 1); };
+    auto bytes = [&s](std::initializer_list<std::uint8_t> b) {
+        s.addRaw(b.begin(), b.size());
+    };
+
+    // Fetch packs carry SHAMap nodes with their hash prefix
+    for (auto const prefix :
+         {HashPrefix::innerNode, HashPrefix::leafNode, HashPrefix::txNode})
+        s.add32(prefix);
+
+    // Currency codes of issued amounts
+    for (auto const code : {"USD", "EUR", "BTC", "ETH", "CNY", "JPY", "XAU"})
+        s.addBitString(to_currency(code));
+
+    // Ledger entries start with their type and flags
+    for (auto const type : {ltACCOUNT_ROOT, ltOFFER, ltDIR_NODE})
+    {
+        field(sfLedgerEntryType);
+        s.add16(type);
+        field(sfFlags);
+        s.add32(0);
+    }
+    for (std::uint32_t const flags : {lsfLowReserve, lsfHighReserve})
+    {
+        field(sfLedgerEntryType);
+        s.add16(ltRIPPLE_STATE);
+        field(sfFlags);
+        s.add32(flags);
+    }
+
+    // Transactions start with their type, flags and sequence
+    for (auto const type :
+         {ttPAYMENT,
+          ttOFFER_CREATE,
+          ttOFFER_CANCEL,
+          ttTRUST_SET,
+          ttACCOUNT_SET})
+    {
+        field(sfTransactionType);
+        s.add16(type);
+        field(sfFlags);
+        s.add32(tfFullyCanonicalSig);
+        field(sfSequence);
+    }
+
+    // The fee is followed by the signing key
+    for (std::uint64_t const fee : {10, 12, 15, 20, 100})
+    {
+        field(sfFee);
+        s.add64(STAmount::cPosNative | fee);
+        field(sfSigningPubKey);
+        s.add8(33);
+    }
+
+    // DER encoded signatures
+    field(sfTxnSignature);
+    bytes({0x46, 0x30, 0x44, 0x02, 0x20});
+    field(sfTxnSignature);
+    bytes({0x47, 0x30, 0x45, 0x02, 0x21, 0x00});
+    field(sfTxnSignature);
+    bytes({0x47, 0x30, 0x45, 0x02, 0x20});
+    bytes({0x02, 0x20});
+    bytes({0x02, 0x21, 0x00});
+
+    field(sfAccount);
+    s.add8(20);
+    field(sfDestination);
+    s.add8(20);
+
+    // Metadata lists the entries a transaction changed, then its result
+    field(sfAffectedNodes);
+    for (auto const type : {ltACCOUNT_ROOT, ltRIPPLE_STATE, ltOFFER})
+    {
+        field(sfModifiedNode);
+        field(sfLedgerEntryType);
+        s.add16(type);
+        field(sfPreviousTxnLgrSeq);
+        field(sfCreatedNode);
+        field(sfLedgerEntryType);
+        s.add16(type);
+        field(sfLedgerIndex);
+        field(sfDeletedNode);
+        field(sfLedgerEntryType);
+        s.add16(type);
+        field(sfLedgerIndex);
+    }
+    field(sfFinalFields);
+    field(sfFlags);
+    s.add32(0);
+    field(sfSequence);
+    field(sfPreviousFields);
+    field(sfBalance);
+    s.add32(STAmount::cPosNative >> 32);
+    endObject();
+    endObject();
+    endArray();
+    field(sfTransactionResult);
+    s.add8(tesSUCCESS);
+
+    return s.getData();
+}
+
+}  // namespace
+
+Slice
+lz4Dictionary()
+{
+    static Blob const dictionary = makeLZ4Dictionary();
+    return makeSlice(dictionary);
+}
+
+}  // namespace compression
+}  // namespace ripple
@@ -79,7 +79,8 @@ makeFeaturesRequestHeader(
 {
     std::stringstream str;
     if (comprEnabled)
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+        str << FEATURE_COMPR << "=lz4" << DELIM_VALUE << COMPR_LZ4_DICT
+            << DELIM_FEATURE;
     if (ledgerReplayEnabled)
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled)
@@ -99,7 +100,12 @@ makeFeaturesResponseHeader(
 {
     std::stringstream str;
     if (comprEnabled && isFeatureValue(headers, FEATURE_COMPR, "lz4"))
-        str << FEATURE_COMPR << "=lz4" << DELIM_FEATURE;
+    {
+        str << FEATURE_COMPR << "=lz4";
+        if (isFeatureValue(headers, FEATURE_COMPR, COMPR_LZ4_DICT))
+            str << DELIM_VALUE << COMPR_LZ4_DICT;
+        str << DELIM_FEATURE;
+    }
     if (ledgerReplayEnabled && featureEnabled(headers, FEATURE_LEDGER_REPLAY))
         str << FEATURE_LEDGER_REPLAY << "=1" << DELIM_FEATURE;
     if (txReduceRelayEnabled && featureEnabled(headers, FEATURE_TXRR))
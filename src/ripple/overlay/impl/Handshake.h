@@ -140,6 +140,8 @@ makeResponse(
 
 // compression feature
 static constexpr char FEATURE_COMPR[] = "compr";
+// compression feature value for lz4 primed with compression::lz4Dictionary()
+static constexpr char COMPR_LZ4_DICT[] = "lz4dict";
 // validation/proposal reduce-relay feature
 static constexpr char FEATURE_VPRR[] = "vprr";
 // transaction reduce-relay feature
@@ -64,75 +64,93 @@ Message::totalSize(::google::protobuf::Message const& message)
     return messageSize(message) + compression::headerBytes;
 }
 
+/** Returns the algorithm to compress a message with.
+
+    Small messages, and those made mostly of keys, hashes and signatures,
+    are not worth compressing. The dictionary only holds fragments of
+    serialized ledger entries and transactions, so it is only used for the
+    messages that carry them, and only while they are small; the rest use
+    plain LZ4.
+
+    @param type Protocol message type
+    @param messageBytes Size of the uncompressed message
+    @param algorithm The best algorithm the peer accepts
+*/
+static Message::Algorithm
+compressionAlgorithm(
+    int type,
+    std::size_t messageBytes,
+    Message::Algorithm algorithm)
+{
+    using namespace ripple::compression;
+
+    if (messageBytes <= 70)
+        return Algorithm::None;
+
+    switch (type)
+    {
+        case protocol::mtTRANSACTION:
+        case protocol::mtTRANSACTIONS:
+        case protocol::mtLEDGER_DATA:
+        case protocol::mtGET_OBJECTS:
+        case protocol::mtREPLAY_DELTA_RESPONSE:
+            if (algorithm == Algorithm::LZ4Dict &&
+                messageBytes > lz4DictMaxBytes)
+                return Algorithm::LZ4;
+            return algorithm;
+        case protocol::mtMANIFESTS:
+        case protocol::mtENDPOINTS:
+        case protocol::mtGET_LEDGER:
+        case protocol::mtVALIDATORLIST:
+        case protocol::mtVALIDATORLISTCOLLECTION:
+            return Algorithm::LZ4;
+        case protocol::mtPING:
+        case protocol::mtCLUSTER:
+        case protocol::mtPROPOSE_LEDGER:
+        case protocol::mtSTATUS_CHANGE:
+        case protocol::mtHAVE_SET:
+        case protocol::mtVALIDATION:
+        case protocol::mtGET_PEER_SHARD_INFO:
+        case protocol::mtPEER_SHARD_INFO:
+        case protocol::mtPROOF_PATH_REQ:
+        case protocol::mtPROOF_PATH_RESPONSE:
+        case protocol::mtREPLAY_DELTA_REQ:
+        case protocol::mtGET_PEER_SHARD_INFO_V2:
+        case protocol::mtPEER_SHARD_INFO_V2:
+        case protocol::mtHAVE_TRANSACTIONS:
+            break;
+    }
+    return Algorithm::None;
+}
+
 void
-Message::compress()
+Message::compress(Algorithm algorithm, std::vector<uint8_t>& compressed)
 {
     using namespace ripple::compression;
     auto const messageBytes = buffer_.size() - headerBytes;
 
     auto type = getType(buffer_.data());
 
-    bool const compressible = [&] {
-        if (messageBytes <= 70)
-            return false;
-        switch (type)
-        {
-            case protocol::mtMANIFESTS:
-            case protocol::mtENDPOINTS:
-            case protocol::mtTRANSACTION:
-            case protocol::mtGET_LEDGER:
-            case protocol::mtLEDGER_DATA:
-            case protocol::mtGET_OBJECTS:
-            case protocol::mtVALIDATORLIST:
-            case protocol::mtVALIDATORLISTCOLLECTION:
-            case protocol::mtREPLAY_DELTA_RESPONSE:
-            case protocol::mtTRANSACTIONS:
-                return true;
-            case protocol::mtPING:
-            case protocol::mtCLUSTER:
-            case protocol::mtPROPOSE_LEDGER:
-            case protocol::mtSTATUS_CHANGE:
-            case protocol::mtHAVE_SET:
-            case protocol::mtVALIDATION:
-            case protocol::mtGET_PEER_SHARD_INFO:
-            case protocol::mtPEER_SHARD_INFO:
-            case protocol::mtPROOF_PATH_REQ:
-            case protocol::mtPROOF_PATH_RESPONSE:
-            case protocol::mtREPLAY_DELTA_REQ:
-            case protocol::mtGET_PEER_SHARD_INFO_V2:
-            case protocol::mtPEER_SHARD_INFO_V2:
-            case protocol::mtHAVE_TRANSACTIONS:
-                break;
-        }
-        return false;
-    }();
-
-    if (compressible)
+    auto payload = static_cast<void const*>(buffer_.data() + headerBytes);
+
+    auto compressedSize = ripple::compression::compress(
+        payload,
+        messageBytes,
+        [&](std::size_t inSize) {  // size of required compressed buffer
+            compressed.resize(inSize + headerBytesCompressed);
+            return (compressed.data() + headerBytesCompressed);
+        },
+        algorithm);
+
+    if (compressedSize != 0 &&
+        compressedSize < (messageBytes - (headerBytesCompressed - headerBytes)))
     {
-        auto payload = static_cast<void const*>(buffer_.data() + headerBytes);
-
-        auto compressedSize = ripple::compression::compress(
-            payload,
-            messageBytes,
-            [&](std::size_t inSize) {  // size of required compressed buffer
-                bufferCompressed_.resize(inSize + headerBytesCompressed);
-                return (bufferCompressed_.data() + headerBytesCompressed);
-            });
-
-        if (compressedSize <
-            (messageBytes - (headerBytesCompressed - headerBytes)))
-        {
-            bufferCompressed_.resize(headerBytesCompressed + compressedSize);
-            setHeader(
-                bufferCompressed_.data(),
-                compressedSize,
-                type,
-                Algorithm::LZ4,
-                messageBytes);
-        }
-        else
-            bufferCompressed_.resize(0);
+        compressed.resize(headerBytesCompressed + compressedSize);
+        setHeader(
+            compressed.data(), compressedSize, type, algorithm, messageBytes);
     }
+    else
+        compressed.resize(0);
 }
 
 /** Set payload header
@@ -207,17 +225,34 @@ Message::getBufferSize()
 }
 
 std::vector<uint8_t> const&
-Message::getBuffer(Compressed tryCompressed)
+Message::getBuffer(Compressed tryCompressed, Algorithm algorithm)
 {
     if (tryCompressed == Compressed::Off)
         return buffer_;
 
-    std::call_once(once_flag_, &Message::compress, this);
+    algorithm = compressionAlgorithm(
+        getType(buffer_.data()),
+        buffer_.size() - compression::headerBytes,
+        algorithm);
 
-    if (bufferCompressed_.size() > 0)
-        return bufferCompressed_;
-    else
+    auto compressed = [&](std::once_flag& flag, std::vector<uint8_t>& buffer)
+        -> std::vector<uint8_t> const& {
+        std::call_once(flag, [&] { compress(algorithm, buffer); });
+        if (buffer.size() > 0)
+            return buffer;
         return buffer_;
+    };
+
+    switch (algorithm)
+    {
+        case Algorithm::LZ4:
+            return compressed(once_flag_, bufferCompressed_);
+        case Algorithm::LZ4Dict:
+            return compressed(onceFlagDict_, bufferCompressedDict_);
+        case Algorithm::None:
+            break;
+    }
+    return buffer_;
 }
 
 int
@@ -580,6 +580,7 @@ OverlayImpl::onWrite(beast::PropertyStream::Map& stream)
             item["messages_in"] = std::to_string(i.messagesIn.load());
             item["bytes_out"] = std::to_string(i.bytesOut.load());
             item["messages_out"] = std::to_string(i.messagesOut.load());
+            item["send_delay_us"] = std::to_string(i.sendDelay.load());
         }
     }
 }
@@ -683,6 +684,14 @@ OverlayImpl::reportTraffic(
     m_traffic.addCount(cat, isInbound, number);
 }
 
+void
+OverlayImpl::reportSendDelay(
+    TrafficCount::category cat,
+    std::chrono::microseconds delay)
+{
+    m_traffic.addSendDelay(cat, delay);
+}
+
 Json::Value
 OverlayImpl::crawlShards(bool includePublicKey, std::uint32_t relays)
 {
@@ -1487,15 +1496,15 @@ OverlayImpl::updateSlotAndSquelch(
     std::set<Peer::id_t>&& peers,
     protocol::MessageType type)
 {
-    if (!strand_.running_in_this_thread())
-        return post(
-            strand_,
-            [this, key, validator, peers = std::move(peers), type]() mutable {
-                updateSlotAndSquelch(key, validator, std::move(peers), type);
-            });
+    if (peers.empty())
+        return;
 
+    std::lock_guard lock(slotUpdatesLock_);
+    bool const idle = slotUpdates_.empty();
     for (auto id : peers)
-        slots_.updateSlotAndSquelch(key, validator, id, type);
+        slotUpdates_.push_back({key, validator, id, type});
+    if (idle)
+        post(strand_, std::bind(&OverlayImpl::applySlotUpdates, this));
 }
 
 void
@@ -1505,12 +1514,26 @@ OverlayImpl::updateSlotAndSquelch(
     Peer::id_t peer,
     protocol::MessageType type)
 {
-    if (!strand_.running_in_this_thread())
-        return post(strand_, [this, key, validator, peer, type]() {
-            updateSlotAndSquelch(key, validator, peer, type);
-        });
+    std::lock_guard lock(slotUpdatesLock_);
+    bool const idle = slotUpdates_.empty();
+    slotUpdates_.push_back({key, validator, peer, type});
+    if (idle)
+        post(strand_, std::bind(&OverlayImpl::applySlotUpdates, this));
+}
+
+void
+OverlayImpl::applySlotUpdates()
+{
+    assert(strand_.running_in_this_thread());
 
-    slots_.updateSlotAndSquelch(key, validator, peer, type);
+    std::vector<SlotUpdate> updates;
+    {
+        std::lock_guard lock(slotUpdatesLock_);
+        updates.swap(slotUpdates_);
+    }
+
+    for (auto const& u : updates)
+        slots_.updateSlotAndSquelch(u.key, u.validator, u.peer, u.type);
 }
 
 void
@@ -1534,7 +1557,7 @@ OverlayImpl::deleteIdlePeers()
 //------------------------------------------------------------------------------
 
 Overlay::Setup
-setup_Overlay(BasicConfig const& config)
+setup_Overlay(Config const& config)
 {
     Overlay::Setup setup;
 
@@ -1610,30 +1633,7 @@ setup_Overlay(BasicConfig const& config)
         set(setup.vlEnabled, "enabled", section);
     }
 
-    try
-    {
-        auto id = config.legacy("network_id");
-
-        if (!id.empty())
-        {
-            if (id == "main")
-                id = "0";
-
-            if (id == "testnet")
-                id = "1";
-
-            if (id == "devnet")
-                id = "2";
-
-            setup.networkID = beast::lexicalCastThrow<std::uint32_t>(id);
-        }
-    }
-    catch (...)
-    {
-        Throw<std::runtime_error>(
-            "Configured [network_id] section is invalid: must be a number "
-            "or one of the strings 'main', 'testnet' or 'devnet'.");
-    }
+    setup.networkID = config.NETWORK_ID;
 
     return setup;
 }
@@ -129,6 +129,21 @@ private:
 
     reduce_relay::Slots<UptimeClock> slots_;
 
+    // A message to count in the slot of its validator
+    struct SlotUpdate
+    {
+        uint256 key;
+        PublicKey validator;
+        Peer::id_t peer;
+        protocol::MessageType type;
+    };
+    // Messages waiting to be counted on the strand. They are counted in
+    // batches, so that a burst of validations and proposals posts to the
+    // strand once rather than once per message and peer.
+    std::vector<SlotUpdate> slotUpdates_;
+    // Protects slotUpdates_
+    std::mutex slotUpdatesLock_;
+
     // Transaction reduce-relay metrics
     metrics::TxMetrics txMetrics_;
 
@@ -352,6 +367,11 @@ public:
     void
     reportTraffic(TrafficCount::category cat, bool isInbound, int bytes);
 
+    void
+    reportSendDelay(
+        TrafficCount::category cat,
+        std::chrono::microseconds delay);
+
     void
     incJqTransOverflow() override
     {
@@ -572,6 +592,11 @@ private:
     void
     deleteIdlePeers();
 
+    /** Count the messages waiting in slotUpdates_. Must be called on the
+     * strand. */
+    void
+    applySlotUpdates();
+
 private:
     struct TrafficGauges
     {
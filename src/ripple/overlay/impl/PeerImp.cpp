@@ -108,6 +108,14 @@ PeerImp::PeerImp(
               app_.config().COMPRESSION)
               ? Compressed::On
               : Compressed::Off)
+    , compressionAlgorithm_(
+          peerFeatureEnabled(
+              headers_,
+              FEATURE_COMPR,
+              COMPR_LZ4_DICT,
+              app_.config().COMPRESSION)
+              ? Algorithm::LZ4Dict
+              : Algorithm::LZ4)
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
@@ -251,10 +259,12 @@ PeerImp::send(std::shared_ptr<Message> const& m)
     if (validator && !squelch_.expireSquelch(*validator))
         return;
 
+    auto const bytes =
+        m->getBuffer(compressionEnabled_, compressionAlgorithm_).size();
     overlay_.reportTraffic(
         safe_cast<TrafficCount::category>(m->getCategory()),
         false,
-        static_cast<int>(m->getBuffer(compressionEnabled_).size()));
+        static_cast<int>(bytes));
 
     auto sendq_size = send_queue_.size();
 
@@ -273,22 +283,12 @@ PeerImp::send(std::shared_ptr<Message> const& m)
              << " sendq: " << sendq_size;
     }
 
-    send_queue_.push(m);
+    send_queue_.push(m, bytes);
 
     if (sendq_size != 0)
         return;
 
-    boost::asio::async_write(
-        stream_,
-        boost::asio::buffer(
-            send_queue_.front()->getBuffer(compressionEnabled_)),
-        bind_executor(
-            strand_,
-            std::bind(
-                &PeerImp::onWriteMessage,
-                shared_from_this(),
-                std::placeholders::_1,
-                std::placeholders::_2)));
+    writeMessage();
 }
 
 void
@@ -490,6 +490,7 @@ PeerImp::json()
         std::to_string(metrics_.recv.average_bytes());
     ret[jss::metrics][jss::avg_bps_sent] =
         std::to_string(metrics_.sent.average_bytes());
+    ret[jss::metrics][jss::send_queue] = send_queue_.json();
 
     return ret;
 }
@@ -950,6 +951,30 @@ PeerImp::onReadMessage(error_code ec, std::size_t bytes_transferred)
                 std::placeholders::_2)));
 }
 
+void
+PeerImp::writeMessage()
+{
+    assert(strand_.running_in_this_thread());
+    auto const& m = send_queue_.front();
+    overlay_.reportSendDelay(
+        safe_cast<TrafficCount::category>(m->getCategory()),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            send_queue_.waited()));
+
+    // Timeout on writes only
+    boost::asio::async_write(
+        stream_,
+        boost::asio::buffer(
+            m->getBuffer(compressionEnabled_, compressionAlgorithm_)),
+        bind_executor(
+            strand_,
+            std::bind(
+                &PeerImp::onWriteMessage,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+}
+
 void
 PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
 {
@@ -972,20 +997,7 @@ PeerImp::onWriteMessage(error_code ec, std::size_t bytes_transferred)
     assert(!send_queue_.empty());
     send_queue_.pop();
     if (!send_queue_.empty())
-    {
-        // Timeout on writes only
-        return boost::asio::async_write(
-            stream_,
-            boost::asio::buffer(
-                send_queue_.front()->getBuffer(compressionEnabled_)),
-            bind_executor(
-                strand_,
-                std::bind(
-                    &PeerImp::onWriteMessage,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2)));
-    }
+        return writeMessage();
 
     if (gracefulClose_)
     {
@@ -3541,12 +3553,26 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
 
         std::vector<std::pair<SHAMapNodeID, Blob>> data;
 
+        // The nodes returned for a query are the same for every peer
+        // asking, so they are serialized once and shared
+        auto& cache = app_.getLedgerMaster().getFragmentCache();
+        auto const mapHash = map->getHash();
+
         for (int i = 0; i < m->nodeids_size() &&
              ledgerData.nodes_size() < Tuning::softMaxReplyNodes;
              ++i)
         {
             auto const shaMapNodeId{deserializeSHAMapNodeID(m->nodeids(i))};
 
+            auto const key = LedgerFragmentCache::nodeKey(
+                mapHash, *shaMapNodeId, queryDepth, fatLeaves);
+            if (auto const fragment = cache.fetch(key))
+            {
+                // The repeated nodes are appended to those already present
+                ledgerData.MergeFromString(*fragment);
+                continue;
+            }
+
             data.clear();
             data.reserve(Tuning::softMaxReplyNodes);
 
@@ -3558,12 +3584,18 @@ PeerImp::processLedgerRequest(std::shared_ptr<protocol::TMGetLedger> const& m)
                         << "processLedgerRequest: getNodeFat got "
                         << data.size() << " nodes";
 
+                    protocol::TMLedgerData nodes;
                     for (auto const& d : data)
                     {
-                        protocol::TMLedgerNode* node{ledgerData.add_nodes()};
+                        protocol::TMLedgerNode* node{nodes.add_nodes()};
                         node->set_nodeid(d.first.getRawString());
                         node->set_nodedata(d.second.data(), d.second.size());
                     }
+
+                    auto fragment = std::make_shared<std::string>();
+                    nodes.SerializePartialToString(fragment.get());
+                    ledgerData.mutable_nodes()->MergeFrom(nodes.nodes());
+                    cache.insert(key, std::move(fragment));
                 }
                 else
                 {
@@ -31,6 +31,7 @@
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
+#include <ripple/overlay/impl/SendQueue.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STTx.h>
@@ -42,7 +43,6 @@
 #include <boost/thread/shared_mutex.hpp>
 #include <cstdint>
 #include <optional>
-#include <queue>
 
 namespace ripple {
 
@@ -68,6 +68,7 @@ private:
     using waitable_timer =
         boost::asio::basic_waitable_timer<std::chrono::steady_clock>;
     using Compressed = compression::Compressed;
+    using Algorithm = compression::Algorithm;
 
     Application& app_;
     id_t const id_;
@@ -155,7 +156,7 @@ private:
     http_request_type request_;
     http_response_type response_;
     boost::beast::http::fields const& headers_;
-    std::queue<std::shared_ptr<Message>> send_queue_;
+    SendQueue send_queue_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     std::unique_ptr<LoadEvent> load_event_;
@@ -168,6 +169,8 @@ private:
     std::mutex mutable shardInfoMutex_;
 
     Compressed compressionEnabled_ = Compressed::Off;
+    // The best compression algorithm the peer accepts
+    Algorithm compressionAlgorithm_ = Algorithm::LZ4;
 
     // Queue of transactions' hashes that have not been
     // relayed. The hashes are sent once a second to a peer
@@ -479,6 +482,10 @@ private:
     void
     onReadMessage(error_code ec, std::size_t bytes_transferred);
 
+    // Writes the next message chosen by the send queue
+    void
+    writeMessage();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage(error_code ec, std::size_t bytes_transferred);
@@ -693,6 +700,14 @@ PeerImp::PeerImp(
               app_.config().COMPRESSION)
               ? Compressed::On
               : Compressed::Off)
+    , compressionAlgorithm_(
+          peerFeatureEnabled(
+              headers_,
+              FEATURE_COMPR,
+              COMPR_LZ4_DICT,
+              app_.config().COMPRESSION)
+              ? Algorithm::LZ4Dict
+              : Algorithm::LZ4)
     , txReduceRelayEnabled_(peerFeatureEnabled(
           headers_,
           FEATURE_TXRR,
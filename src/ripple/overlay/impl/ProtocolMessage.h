@@ -141,9 +141,9 @@ struct MessageHeader
     /** The type of the message. */
     std::uint16_t message_type = 0;
 
-    /** Indicates which compression algorithm the payload is compressed with.
-     * Currenly only lz4 is supported. If None then the message is not
-     * compressed.
+    /** Indicates which compression algorithm the payload is compressed with:
+     * lz4, with or without the shared dictionary. If None then the message
+     * is not compressed.
      */
     compression::Algorithm algorithm = compression::Algorithm::None;
 };
@@ -210,7 +210,8 @@ parseMessageHeader(
 
         hdr.algorithm = static_cast<compression::Algorithm>(*iter & 0xF0);
 
-        if (hdr.algorithm != compression::Algorithm::LZ4)
+        if (hdr.algorithm != compression::Algorithm::LZ4 &&
+            hdr.algorithm != compression::Algorithm::LZ4Dict)
         {
             ec = make_error_code(boost::system::errc::protocol_error);
             return std::nullopt;
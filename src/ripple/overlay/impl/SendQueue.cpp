@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/overlay/impl/Tuning.h>
+#include <ripple/protocol/jss.h>
+#include <cassert>
+
+namespace ripple {
+
+SendQueue::Class
+SendQueue::classify(TrafficCount::category category)
+{
+    using cat = TrafficCount::category;
+
+    switch (category)
+    {
+        // Pings and status changes are small, and their timing matters
+        case cat::base:
+        case cat::manifests:
+        case cat::proposal:
+        case cat::validation:
+        case cat::get_set:
+        case cat::share_set:
+        case cat::ld_tsc_get:
+        case cat::ld_tsc_share:
+        case cat::gl_tsc_share:
+        case cat::gl_tsc_get:
+            return consensus;
+
+        case cat::transaction:
+        case cat::share_hash_tx:
+        case cat::get_hash_tx:
+        case cat::get_transactions:
+        case cat::have_transactions:
+        case cat::requested_transactions:
+            return transactions;
+
+        case cat::ld_txn_get:
+        case cat::ld_txn_share:
+        case cat::ld_asn_get:
+        case cat::ld_asn_share:
+        case cat::ld_get:
+        case cat::ld_share:
+        case cat::gl_txn_share:
+        case cat::gl_txn_get:
+        case cat::gl_asn_share:
+        case cat::gl_asn_get:
+        case cat::gl_share:
+        case cat::gl_get:
+        case cat::share_hash_ledger:
+        case cat::get_hash_ledger:
+        case cat::share_hash_txnode:
+        case cat::get_hash_txnode:
+        case cat::share_hash_asnode:
+        case cat::get_hash_asnode:
+        case cat::share_cas_object:
+        case cat::get_cas_object:
+        case cat::share_fetch_pack:
+        case cat::get_fetch_pack:
+        case cat::share_hash:
+        case cat::get_hash:
+        case cat::proof_path_request:
+        case cat::proof_path_response:
+        case cat::replay_delta_request:
+        case cat::replay_delta_response:
+            return ledgerData;
+
+        default:
+            return maintenance;
+    }
+}
+
+char const*
+SendQueue::name(Class c)
+{
+    switch (c)
+    {
+        case consensus:
+            return "consensus";
+        case transactions:
+            return "transactions";
+        case ledgerData:
+            return "ledger_data";
+        case maintenance:
+            break;
+    }
+    return "maintenance";
+}
+
+std::size_t
+SendQueue::quantum(Class c)
+{
+    static constexpr std::array<std::size_t, classCount> weights{
+        {8, 4, 2, 1}};
+    return weights[c] * Tuning::sendQueueQuantum;
+}
+
+void
+SendQueue::push(
+    std::shared_ptr<Message> const& m,
+    std::size_t bytes,
+    clock_type::time_point now)
+{
+    auto const c =
+        classify(safe_cast<TrafficCount::category>(m->getCategory()));
+    queues_[c].entries.push_back({m, bytes, now});
+    ++stats_[c].queued;
+    ++size_;
+}
+
+std::shared_ptr<Message> const&
+SendQueue::front(clock_type::time_point now)
+{
+    assert(!empty());
+    if (current_)
+        return current_;
+
+    for (;;)
+    {
+        auto& q = queues_[cursor_];
+        if (q.entries.empty())
+        {
+            q.deficit = 0;
+        }
+        else
+        {
+            if (!earned_)
+            {
+                q.deficit += quantum(static_cast<Class>(cursor_));
+                earned_ = true;
+            }
+
+            if (auto& e = q.entries.front(); e.bytes <= q.deficit)
+            {
+                q.deficit -= e.bytes;
+                current_ = std::move(e.message);
+                waited_ = now - e.queued;
+                q.entries.pop_front();
+
+                using namespace std::chrono;
+                auto& s = stats_[cursor_];
+                --s.queued;
+                ++s.messages;
+                s.delay += duration_cast<microseconds>(waited_).count();
+                return current_;
+            }
+        }
+
+        cursor_ = (cursor_ + 1) % classCount;
+        earned_ = false;
+    }
+}
+
+void
+SendQueue::pop()
+{
+    assert(current_);
+    current_.reset();
+    --size_;
+}
+
+Json::Value
+SendQueue::json() const
+{
+    Json::Value ret(Json::objectValue);
+    for (std::size_t c = 0; c < classCount; ++c)
+    {
+        auto const& s = stats_[c];
+        auto const messages = s.messages.load();
+        Json::Value& jv =
+            (ret[name(static_cast<Class>(c))] = Json::objectValue);
+        jv[jss::queued] = Json::UInt(s.queued.load());
+        jv[jss::avg_delay_us] =
+            std::to_string(messages == 0 ? 0 : s.delay.load() / messages);
+    }
+    return ret;
+}
+
+}  // namespace ripple
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+#define RIPPLE_OVERLAY_SENDQUEUE_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <ripple/overlay/Message.h>
+#include <ripple/overlay/impl/TrafficCount.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+namespace ripple {
+
+/** The outgoing messages of a peer.
+
+    Messages are queued by class, and the classes share the connection
+    using deficit round robin: on each visit a class earns a byte quantum
+    in proportion to its weight, and writes messages for as long as its
+    earned bytes cover them. Small consensus messages therefore never
+    wait behind more than one large ledger data or fetch pack reply.
+
+    The queue is used from the peer's strand. The statistics may be read
+    from any thread.
+*/
+class SendQueue
+{
+public:
+    enum Class : std::size_t {
+        consensus,     // proposals, validations, manifests and tx sets
+        transactions,  // transactions and their relay
+        ledgerData,    // ledger and object requests and replies
+        maintenance,   // overlay, cluster, validator lists and shards
+    };
+
+    static constexpr std::size_t classCount = maintenance + 1;
+
+    using clock_type = std::chrono::steady_clock;
+
+    /** Returns the class of messages in a traffic category. */
+    static Class
+    classify(TrafficCount::category category);
+
+    /** Returns the name of a class, as reported in the peer's json. */
+    static char const*
+    name(Class c);
+
+    /** Returns how many bytes a class may write per round. */
+    static std::size_t
+    quantum(Class c);
+
+    /** Add a message to the queue.
+
+        @param m The message.
+        @param bytes The size of the message on the wire.
+    */
+    void
+    push(
+        std::shared_ptr<Message> const& m,
+        std::size_t bytes,
+        clock_type::time_point now = clock_type::now());
+
+    /** Returns the message being written.
+
+        If no message is being written, the next one is chosen. The
+        queue must not be empty.
+    */
+    std::shared_ptr<Message> const&
+    front(clock_type::time_point now = clock_type::now());
+
+    /** Returns how long the message being written was queued. */
+    clock_type::duration
+    waited() const
+    {
+        return waited_;
+    }
+
+    /** Remove the message being written. */
+    void
+    pop();
+
+    /** Returns the number of messages, including the one being written. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    /** Returns the number of messages queued in a class. */
+    std::size_t
+    size(Class c) const
+    {
+        return stats_[c].queued.load(std::memory_order_relaxed);
+    }
+
+    /** Returns the queue length and delay of each class. */
+    Json::Value
+    json() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<Message> message;
+        std::size_t bytes;
+        clock_type::time_point queued;
+    };
+
+    struct Queue
+    {
+        std::deque<Entry> entries;
+
+        // Bytes earned but not yet written
+        std::size_t deficit = 0;
+    };
+
+    struct Stats
+    {
+        std::atomic<std::size_t> queued{0};
+        std::atomic<std::uint64_t> messages{0};
+
+        // Total time spent queued, in microseconds
+        std::atomic<std::uint64_t> delay{0};
+    };
+
+    std::array<Queue, classCount> queues_;
+    std::array<Stats, classCount> stats_;
+    std::size_t size_ = 0;
+
+    // The class being visited, and whether it earned its quantum
+    std::size_t cursor_ = consensus;
+    bool earned_ = false;
+
+    std::shared_ptr<Message> current_;
+    clock_type::duration waited_{0};
+};
+
+}  // namespace ripple
+
+#endif
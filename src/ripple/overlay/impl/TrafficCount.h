@@ -25,6 +25,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 
 namespace ripple {
@@ -42,6 +43,9 @@ public:
         std::atomic<std::uint64_t> messagesIn{0};
         std::atomic<std::uint64_t> messagesOut{0};
 
+        // Time outgoing messages spent in send queues, in microseconds
+        std::atomic<std::uint64_t> sendDelay{0};
+
         TrafficStats(char const* n) : name(n)
         {
         }
@@ -52,6 +56,7 @@ public:
             , bytesOut(ts.bytesOut.load())
             , messagesIn(ts.messagesIn.load())
             , messagesOut(ts.messagesOut.load())
+            , sendDelay(ts.sendDelay.load())
         {
         }
 
@@ -186,6 +191,14 @@ public:
         }
     }
 
+    /** Account for the time an outgoing message spent queued */
+    void
+    addSendDelay(category cat, std::chrono::microseconds delay)
+    {
+        assert(cat <= category::unknown);
+        counts_[cat].sendDelay += delay.count();
+    }
+
     TrafficCount() = default;
 
     /** An up-to-date copy of all the counters
@@ -64,6 +64,9 @@ enum {
 /** Size of buffer used to read from the socket. */
 std::size_t constexpr readBufferBytes = 16384;
 
+/** Bytes each unit of send queue class weight may write per round. */
+std::size_t constexpr sendQueueQuantum = 16384;
+
 }  // namespace Tuning
 
 }  // namespace ripple
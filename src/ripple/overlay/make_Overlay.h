@@ -21,6 +21,7 @@
 #define RIPPLE_OVERLAY_MAKE_OVERLAY_H_INCLUDED
 
 #include <ripple/basics/Resolver.h>
+#include <ripple/core/Config.h>
 #include <ripple/overlay/Overlay.h>
 #include <ripple/resource/ResourceManager.h>
 #include <ripple/rpc/ServerHandler.h>
@@ -30,7 +31,7 @@
 namespace ripple {
 
 Overlay::Setup
-setup_Overlay(BasicConfig const& config);
+setup_Overlay(Config const& config);
 
 /** Creates the implementation of Overlay. */
 std::unique_ptr<Overlay>
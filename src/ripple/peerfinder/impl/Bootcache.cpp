@@ -31,12 +31,14 @@ Bootcache::Bootcache(Store& store, clock_type& clock, beast::Journal journal)
     , m_journal(journal)
     , m_whenUpdate(m_clock.now())
     , m_needsUpdate(false)
+    , m_needsRewrite(false)
 {
 }
 
 Bootcache::~Bootcache()
 {
-    update();
+    if (m_needsUpdate)
+        update().save(m_store);
 }
 
 bool
@@ -79,7 +81,9 @@ void
 Bootcache::clear()
 {
     m_map.clear();
+    m_changed.clear();
     m_needsUpdate = true;
+    m_needsRewrite = true;
 }
 
 //--------------------------------------------------------------------------
@@ -99,6 +103,10 @@ Bootcache::load()
             }
         }));
 
+    // The cache now matches the database
+    m_needsUpdate = false;
+    m_needsRewrite = false;
+
     if (n > 0)
     {
         JLOG(m_journal.info()) << beast::leftw(18) << "Bootcache loaded " << n
@@ -115,8 +123,8 @@ Bootcache::insert(beast::IP::Endpoint const& endpoint)
     {
         JLOG(m_journal.trace())
             << beast::leftw(18) << "Bootcache insert " << endpoint;
+        flagForUpdate(endpoint);
         prune();
-        flagForUpdate();
     }
     return result.second;
 }
@@ -137,8 +145,8 @@ Bootcache::insertStatic(beast::IP::Endpoint const& endpoint)
     {
         JLOG(m_journal.trace())
             << beast::leftw(18) << "Bootcache insert " << endpoint;
+        flagForUpdate(endpoint);
         prune();
-        flagForUpdate();
     }
     return result.second;
 }
@@ -147,6 +155,7 @@ void
 Bootcache::on_success(beast::IP::Endpoint const& endpoint)
 {
     auto result(m_map.insert(value_type(endpoint, 1)));
+    flagForUpdate(endpoint);
     if (result.second)
     {
         prune();
@@ -166,13 +175,13 @@ Bootcache::on_success(beast::IP::Endpoint const& endpoint)
                            << endpoint << " with " << entry.valence()
                            << ((entry.valence() > 1) ? " successes"
                                                      : " success");
-    flagForUpdate();
 }
 
 void
 Bootcache::on_failure(beast::IP::Endpoint const& endpoint)
 {
     auto result(m_map.insert(value_type(endpoint, -1)));
+    flagForUpdate(endpoint);
     if (result.second)
     {
         prune();
@@ -192,13 +201,14 @@ Bootcache::on_failure(beast::IP::Endpoint const& endpoint)
     JLOG(m_journal.debug())
         << beast::leftw(18) << "Bootcache failed " << endpoint << " with " << n
         << ((n > 1) ? " attempts" : " attempt");
-    flagForUpdate();
 }
 
-void
+std::optional<Bootcache::Changes>
 Bootcache::periodicActivity()
 {
-    checkUpdate();
+    if (!m_needsUpdate || m_whenUpdate >= m_clock.now())
+        return std::nullopt;
+    return update();
 }
 
 //--------------------------------------------------------------------------
@@ -239,6 +249,7 @@ Bootcache::prune()
         JLOG(m_journal.trace())
             << beast::leftw(18) << "Bootcache pruned" << endpoint
             << " at valence " << entry.valence();
+        flagForUpdate(endpoint);
         iter = m_map.right.erase(iter);
     }
 
@@ -246,41 +257,65 @@ Bootcache::prune()
                             << " entries total";
 }
 
-// Updates the Store with the current set of entries if needed.
-void
+// Collects the entries to write to the Store and restarts the cooldown.
+Bootcache::Changes
 Bootcache::update()
 {
-    if (!m_needsUpdate)
-        return;
-    std::vector<Store::Entry> list;
-    list.reserve(m_map.size());
-    for (auto const& e : m_map)
+    Changes changes;
+    changes.rewrite = m_needsRewrite;
+    if (m_needsRewrite)
+    {
+        changes.changed.reserve(m_map.size());
+        for (auto const& e : m_map)
+        {
+            Store::Entry se;
+            se.endpoint = e.get_left();
+            se.valence = e.get_right().valence();
+            changes.changed.push_back(se);
+        }
+    }
+    else
     {
-        Store::Entry se;
-        se.endpoint = e.get_left();
-        se.valence = e.get_right().valence();
-        list.push_back(se);
+        for (auto const& endpoint : m_changed)
+        {
+            auto const iter = m_map.left.find(endpoint);
+            if (iter == m_map.left.end())
+            {
+                changes.removed.push_back(endpoint);
+                continue;
+            }
+
+            Store::Entry se;
+            se.endpoint = endpoint;
+            se.valence = iter->second.valence();
+            changes.changed.push_back(se);
+        }
     }
-    m_store.save(list);
-    // Reset the flag and cooldown timer
+
+    // Reset the flags and cooldown timer
+    m_changed.clear();
     m_needsUpdate = false;
+    m_needsRewrite = false;
     m_whenUpdate = m_clock.now() + Tuning::bootcacheCooldownTime;
+    return changes;
 }
 
-// Checks the clock and calls update if we are off the cooldown.
+// Called when changes to an entry will affect the Store.
 void
-Bootcache::checkUpdate()
+Bootcache::flagForUpdate(beast::IP::Endpoint const& endpoint)
 {
-    if (m_needsUpdate && m_whenUpdate < m_clock.now())
-        update();
+    m_needsUpdate = true;
+    if (!m_needsRewrite)
+        m_changed.insert(endpoint);
 }
 
-// Called when changes to an entry will affect the Store.
 void
-Bootcache::flagForUpdate()
+Bootcache::Changes::save(Store& store) const
 {
-    m_needsUpdate = true;
-    checkUpdate();
+    if (rewrite)
+        store.save(changed);
+    else if (!changed.empty() || !removed.empty())
+        store.saveChanges(changed, removed);
 }
 
 }  // namespace PeerFinder
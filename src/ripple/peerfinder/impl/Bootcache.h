@@ -29,6 +29,9 @@
 #include <boost/bimap/multiset_of.hpp>
 #include <boost/bimap/unordered_set_of.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <optional>
+#include <set>
+#include <vector>
 
 namespace ripple {
 namespace PeerFinder {
@@ -126,9 +129,28 @@ private:
     // Set to true when a database update is needed
     bool m_needsUpdate;
 
+    // Set to true when the whole database must be rewritten
+    bool m_needsRewrite;
+
+    // The addresses whose entries changed since the last update
+    std::set<beast::IP::Endpoint> m_changed;
+
 public:
     static constexpr int staticValence = 32;
 
+    /** Changes to be written to the Store. */
+    struct Changes
+    {
+        // If set, `changed` holds every entry and replaces the stored ones
+        bool rewrite = false;
+        std::vector<Store::Entry> changed;
+        std::vector<beast::IP::Endpoint> removed;
+
+        /** Write the changes to the Store. */
+        void
+        save(Store& store) const;
+    };
+
     using iterator = boost::
         transform_iterator<Transform, map_type::right_map::const_iterator>;
 
@@ -180,8 +202,13 @@ public:
     void
     on_failure(beast::IP::Endpoint const& endpoint);
 
-    /** Stores the cache in the persistent database on a timer. */
-    void
+    /** Returns the changes to store in the persistent database.
+
+        Changes are collected at most once per cooldown period. The caller
+        writes them to the Store without holding any lock, so that the
+        database is never written from the paths that update the cache.
+    */
+    std::optional<Changes>
     periodicActivity();
 
     /** Write the cache state to the property stream. */
@@ -191,12 +218,10 @@ public:
 private:
     void
     prune();
-    void
+    Changes
     update();
     void
-    checkUpdate();
-    void
-    flagForUpdate();
+    flagForUpdate(beast::IP::Endpoint const& endpoint);
 };
 
 }  // namespace PeerFinder
@@ -671,19 +671,27 @@ public:
     void
     once_per_second()
     {
-        std::lock_guard _(lock_);
+        std::optional<Bootcache::Changes> changes;
+
+        {
+            std::lock_guard _(lock_);
 
-        // Expire the Livecache
-        livecache_.expire();
+            // Expire the Livecache
+            livecache_.expire();
 
-        // Expire the recent cache in each slot
-        for (auto const& entry : slots_)
-            entry.second->expire();
+            // Expire the recent cache in each slot
+            for (auto const& entry : slots_)
+                entry.second->expire();
 
-        // Expire the recent attempts table
-        beast::expire(m_squelches, Tuning::recentAttemptDuration);
+            // Expire the recent attempts table
+            beast::expire(m_squelches, Tuning::recentAttemptDuration);
+
+            changes = bootcache_.periodicActivity();
+        }
 
-        bootcache_.periodicActivity();
+        // Write the changed addresses without blocking the peers
+        if (changes)
+            changes->save(m_store);
     }
 
     //--------------------------------------------------------------------------
@@ -46,6 +46,12 @@ public:
     };
     virtual void
     save(std::vector<Entry> const& v) = 0;
+
+    // save the entries of the bootstrap cache that changed or were removed
+    virtual void
+    saveChanges(
+        std::vector<Entry> const& changed,
+        std::vector<beast::IP::Endpoint> const& removed) = 0;
 };
 
 }  // namespace PeerFinder
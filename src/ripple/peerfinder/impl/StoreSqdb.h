@@ -93,6 +93,16 @@ public:
         savePeerFinderDB(m_sqlDb, v);
     }
 
+    // Updates the stored entries that changed and deletes those removed.
+    //
+    void
+    saveChanges(
+        std::vector<Entry> const& changed,
+        std::vector<beast::IP::Endpoint> const& removed) override
+    {
+        savePeerFinderDBChanges(m_sqlDb, changed, removed);
+    }
+
     // Convert any existing entries from an older schema to the
     // current one, if appropriate.
     void
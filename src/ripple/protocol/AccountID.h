@@ -26,6 +26,7 @@
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/base_uint.h>
 #include <ripple/json/json_value.h>
+#include <array>
 #include <cstddef>
 #include <mutex>
 #include <optional>
@@ -118,10 +119,19 @@ operator<<(std::ostream& os, AccountID const& x)
 class AccountIDCache
 {
 private:
-    std::mutex mutable mutex_;
+    // The cache is split into shards, each with its own lock, so that
+    // threads rendering different accounts rarely wait for each other.
+    static constexpr std::size_t shardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        hash_map<AccountID, std::string> m0;
+        hash_map<AccountID, std::string> m1;
+    };
+
     std::size_t capacity_;
-    hash_map<AccountID, std::string> mutable m0_;
-    hash_map<AccountID, std::string> mutable m1_;
+    std::array<Shard, shardCount> mutable shards_;
 
 public:
     AccountIDCache(AccountIDCache const&) = delete;
@@ -136,6 +136,9 @@ public:
     bool
     operator!=(const STArray& s) const;
 
+    iterator
+    insert(const_iterator pos, STObject&& object);
+
     iterator
     erase(iterator pos);
 
@@ -286,6 +289,12 @@ STArray::operator!=(const STArray& s) const
     return v_ != s.v_;
 }
 
+inline STArray::iterator
+STArray::insert(const_iterator pos, STObject&& object)
+{
+    return v_.insert(pos, std::move(object));
+}
+
 inline STArray::iterator
 STArray::erase(iterator pos)
 {
@@ -376,6 +376,8 @@ public:
     peekFieldObject(SField const& field);
     STArray&
     peekFieldArray(SField const& field);
+    STVector256&
+    peekFieldV256(SField const& field);
 
     bool
     isFieldPresent(SField const& field) const;
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_SIGNATURECACHE_H_INCLUDED
+#define RIPPLE_PROTOCOL_SIGNATURECACHE_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/PublicKey.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ripple {
+
+/** A bounded cache of signature verification results.
+
+    Validations, proposals, manifests and transactions relayed by many
+    peers are often checked more than once. The cache remembers the
+    verdict for each (public key, message, signature) triple, so that a
+    repeated check costs a hash instead of a signature verification.
+
+    The entries are spread over a fixed number of shards, each with its
+    own lock and a ring of keys that evicts the oldest entry once the
+    shard is full.
+*/
+class SignatureCache
+{
+public:
+    static constexpr std::size_t shardCount = 16;
+    static constexpr std::size_t defaultCapacity = 65536;
+
+    explicit SignatureCache(std::size_t capacity = defaultCapacity);
+
+    SignatureCache(SignatureCache const&) = delete;
+    SignatureCache&
+    operator=(SignatureCache const&) = delete;
+
+    /** Verify a signature on a message, consulting the cache first.
+
+        @see ripple::verify
+    */
+    [[nodiscard]] bool
+    verify(
+        PublicKey const& publicKey,
+        Slice const& m,
+        Slice const& sig,
+        bool mustBeFullyCanonical = true);
+
+    /** Verify a signature on a digest, consulting the cache first.
+
+        @see ripple::verifyDigest
+    */
+    [[nodiscard]] bool
+    verifyDigest(
+        PublicKey const& publicKey,
+        uint256 const& digest,
+        Slice const& sig,
+        bool mustBeFullyCanonical = true);
+
+    /** Returns the number of cached verdicts. */
+    std::size_t
+    size() const;
+
+    /** Returns the maximum number of cached verdicts. */
+    std::size_t
+    capacity() const
+    {
+        return shardCapacity_ * shardCount;
+    }
+
+    std::uint64_t
+    hits() const
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t
+    misses() const
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    /** Returns the percentage of checks answered from the cache. */
+    double
+    getHitRate() const;
+
+    void
+    clear();
+
+private:
+    struct Shard
+    {
+        std::mutex mutable mutex;
+        hash_map<uint256, bool> verdicts;
+
+        // The keys in insertion order, used to evict the oldest
+        std::vector<uint256> ring;
+        std::size_t next = 0;
+    };
+
+    Shard&
+    shard(uint256 const& key);
+
+    std::optional<bool>
+    find(uint256 const& key);
+
+    void
+    insert(uint256 const& key, bool valid);
+
+    std::size_t const shardCapacity_;
+    std::array<Shard, shardCount> shards_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+};
+
+/** Returns the process-wide signature cache. */
+SignatureCache&
+signatureCache();
+
+}  // namespace ripple
+
+#endif
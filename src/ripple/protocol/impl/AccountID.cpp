@@ -125,38 +125,43 @@ to_issuer(AccountID& issuer, std::string const& s)
     the map.
 */
 
-AccountIDCache::AccountIDCache(std::size_t capacity) : capacity_(capacity)
+AccountIDCache::AccountIDCache(std::size_t capacity)
+    : capacity_((capacity + shardCount - 1) / shardCount)
 {
-    m1_.reserve(capacity_);
+    for (auto& shard : shards_)
+        shard.m1.reserve(capacity_);
 }
 
 std::string
 AccountIDCache::toBase58(AccountID const& id) const
 {
-    std::lock_guard lock(mutex_);
-    auto iter = m1_.find(id);
-    if (iter != m1_.end())
+    // AccountIDs are hashes, so any of their bytes picks a shard evenly
+    auto& shard = shards_[id.data()[0] % shardCount];
+
+    std::lock_guard lock(shard.mutex);
+    auto iter = shard.m1.find(id);
+    if (iter != shard.m1.end())
         return iter->second;
-    iter = m0_.find(id);
+    iter = shard.m0.find(id);
     std::string result;
-    if (iter != m0_.end())
+    if (iter != shard.m0.end())
     {
         result = iter->second;
         // Can use insert-only hash maps if
         // we didn't erase from here.
-        m0_.erase(iter);
+        shard.m0.erase(iter);
     }
     else
     {
         result = ripple::toBase58(id);
     }
-    if (m1_.size() >= capacity_)
+    if (shard.m1.size() >= capacity_)
     {
-        m0_ = std::move(m1_);
-        m1_.clear();
-        m1_.reserve(capacity_);
+        shard.m0 = std::move(shard.m1);
+        shard.m1.clear();
+        shard.m1.reserve(capacity_);
     }
-    m1_.emplace(id, result);
+    shard.m1.emplace(id, result);
     return result;
 }
 
@@ -447,6 +447,12 @@ STObject::peekFieldArray(SField const& field)
     return peekField<STArray>(field);
 }
 
+STVector256&
+STObject::peekFieldV256(SField const& field)
+{
+    return peekField<STVector256>(field);
+}
+
 bool
 STObject::setFlag(std::uint32_t f)
 {
@@ -30,6 +30,7 @@
 #include <ripple/protocol/STArray.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/Sign.h>
+#include <ripple/protocol/SignatureCache.h>
 #include <ripple/protocol/TxFlags.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
@@ -308,7 +309,7 @@ STTx::checkSingleSign(RequireFullyCanonicalSig requireCanonicalSig) const
             Blob const signature = getFieldVL(sfTxnSignature);
             Blob const data = getSigningData(*this);
 
-            validSig = verify(
+            validSig = signatureCache().verify(
                 PublicKey(makeSlice(spk)),
                 makeSlice(data),
                 makeSlice(signature),
@@ -392,7 +393,7 @@ STTx::checkMultiSign(RequireFullyCanonicalSig requireCanonicalSig) const
             {
                 Blob const signature = signer.getFieldVL(sfTxnSignature);
 
-                validSig = verify(
+                validSig = signatureCache().verify(
                     PublicKey(makeSlice(spk)),
                     s.slice(),
                     makeSlice(signature),
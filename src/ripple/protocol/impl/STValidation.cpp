@@ -22,6 +22,7 @@
 #include <ripple/json/to_string.h>
 #include <ripple/protocol/HashPrefix.h>
 #include <ripple/protocol/STValidation.h>
+#include <ripple/protocol/SignatureCache.h>
 
 namespace ripple {
 
@@ -104,7 +105,7 @@ STValidation::isValid() const noexcept
     {
         assert(publicKeyType(getSignerPublic()) == KeyType::secp256k1);
 
-        valid_ = verifyDigest(
+        valid_ = signatureCache().verifyDigest(
             getSignerPublic(),
             getSigningHash(),
             makeSlice(getFieldVL(sfSignature)),
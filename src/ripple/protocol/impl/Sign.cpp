@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/protocol/Sign.h>
+#include <ripple/protocol/SignatureCache.h>
 
 namespace ripple {
 
@@ -48,7 +49,7 @@ verify(
     Serializer ss;
     ss.add32(prefix);
     st.addWithoutSigningFields(ss);
-    return verify(
+    return signatureCache().verify(
         pk, Slice(ss.data(), ss.size()), Slice(sig->data(), sig->size()));
 }
 
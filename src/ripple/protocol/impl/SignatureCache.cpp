@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/protocol/SignatureCache.h>
+#include <ripple/protocol/digest.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+// Distinguishes a signature on a message from one on a digest
+enum class Signed : std::uint8_t { message, digest };
+
+uint256
+makeKey(
+    Signed what,
+    PublicKey const& publicKey,
+    Slice const& data,
+    Slice const& sig,
+    bool mustBeFullyCanonical)
+{
+    // The sizes are hashed so that no two inputs share a key
+    return sha512Half(
+        static_cast<std::uint8_t>(what),
+        publicKey.slice(),
+        static_cast<std::uint32_t>(data.size()),
+        data,
+        static_cast<std::uint32_t>(sig.size()),
+        sig,
+        mustBeFullyCanonical);
+}
+
+}  // namespace
+
+SignatureCache::SignatureCache(std::size_t capacity)
+    : shardCapacity_(std::max<std::size_t>(capacity / shardCount, 1))
+{
+    for (auto& s : shards_)
+        s.verdicts.reserve(shardCapacity_);
+}
+
+bool
+SignatureCache::verify(
+    PublicKey const& publicKey,
+    Slice const& m,
+    Slice const& sig,
+    bool mustBeFullyCanonical)
+{
+    auto const key =
+        makeKey(Signed::message, publicKey, m, sig, mustBeFullyCanonical);
+    if (auto const valid = find(key))
+        return *valid;
+
+    bool const valid = ripple::verify(publicKey, m, sig, mustBeFullyCanonical);
+    insert(key, valid);
+    return valid;
+}
+
+bool
+SignatureCache::verifyDigest(
+    PublicKey const& publicKey,
+    uint256 const& digest,
+    Slice const& sig,
+    bool mustBeFullyCanonical)
+{
+    auto const key = makeKey(
+        Signed::digest,
+        publicKey,
+        Slice(digest.data(), digest.size()),
+        sig,
+        mustBeFullyCanonical);
+    if (auto const valid = find(key))
+        return *valid;
+
+    bool const valid =
+        ripple::verifyDigest(publicKey, digest, sig, mustBeFullyCanonical);
+    insert(key, valid);
+    return valid;
+}
+
+std::size_t
+SignatureCache::size() const
+{
+    std::size_t n = 0;
+    for (auto& s : shards_)
+    {
+        std::lock_guard lock(s.mutex);
+        n += s.verdicts.size();
+    }
+    return n;
+}
+
+double
+SignatureCache::getHitRate() const
+{
+    auto const h = hits();
+    auto const total = h + misses();
+    return total == 0 ? 0.0 : h * 100.0 / total;
+}
+
+void
+SignatureCache::clear()
+{
+    for (auto& s : shards_)
+    {
+        std::lock_guard lock(s.mutex);
+        s.verdicts.clear();
+        s.ring.clear();
+        s.next = 0;
+    }
+    hits_ = 0;
+    misses_ = 0;
+}
+
+SignatureCache::Shard&
+SignatureCache::shard(uint256 const& key)
+{
+    // The key is a hash, so any of its bytes picks a shard evenly
+    return shards_[*key.begin() % shardCount];
+}
+
+std::optional<bool>
+SignatureCache::find(uint256 const& key)
+{
+    auto& s = shard(key);
+    {
+        std::lock_guard lock(s.mutex);
+        if (auto const it = s.verdicts.find(key); it != s.verdicts.end())
+        {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+void
+SignatureCache::insert(uint256 const& key, bool valid)
+{
+    auto& s = shard(key);
+    std::lock_guard lock(s.mutex);
+    if (!s.verdicts.emplace(key, valid).second)
+        return;
+
+    if (s.ring.size() < shardCapacity_)
+    {
+        s.ring.push_back(key);
+        return;
+    }
+
+    s.verdicts.erase(s.ring[s.next]);
+    s.ring[s.next] = key;
+    s.next = (s.next + 1) % shardCapacity_;
+}
+
+SignatureCache&
+signatureCache()
+{
+    static SignatureCache cache;
+    return cache;
+}
+
+}  // namespace ripple
@@ -21,8 +21,10 @@
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/tokens.h>
 #include <boost/container/small_vector.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -88,19 +90,23 @@ checksum(void* out, void const* message, std::size_t size)
 
 namespace detail {
 
-/* The base58 encoding & decoding routines in this namespace are taken from
- * Bitcoin but have been modified from the original.
+/* The base58 encoding & decoding routines in this namespace are based on
+ * those in Bitcoin but have been modified from the original.
  *
  * Copyright (c) 2014 The Bitcoin Core developers
  * Distributed under the MIT software license, see the accompanying
  * file COPYING or http://www.opensource.org/licenses/mit-license.php.
+ *
+ * Instead of one digit at a time, the big number arithmetic works on
+ * limbs of five base58 digits or four bytes, which a 64-bit integer can
+ * multiply and divide without overflowing.
  */
+
+// 58^5, the base of the limbs of an encoded number.
+static constexpr std::uint64_t b58Limb = 656356768;
+
 static std::string
-encodeBase58(
-    void const* message,
-    std::size_t size,
-    void* temp,
-    std::size_t temp_size)
+encodeBase58(void const* message, std::size_t size)
 {
     auto pbegin = reinterpret_cast<unsigned char const*>(message);
     auto const pend = pbegin + size;
@@ -113,36 +119,57 @@ encodeBase58(
         zeroes++;
     }
 
-    auto const b58begin = reinterpret_cast<unsigned char*>(temp);
-    auto const b58end = b58begin + temp_size;
-
-    std::fill(b58begin, b58end, 0);
+    // The base 58^5 limbs of the number, least significant first.
+    boost::container::small_vector<std::uint64_t, 16> b58;
+    b58.reserve((pend - pbegin) * 28 / 100 + 1);
 
     while (pbegin != pend)
     {
-        int carry = *pbegin;
-        // Apply "b58 = b58 * 256 + ch".
-        for (auto iter = b58end; iter != b58begin; --iter)
+        // Take up to four bytes at a time.
+        auto const n = std::min<std::ptrdiff_t>(4, pend - pbegin);
+        std::uint64_t carry = 0;
+        for (auto i = 0; i < n; ++i)
+            carry = (carry << 8) | *pbegin++;
+
+        // Apply "b58 = b58 * 256^n + carry".
+        auto const shift = 8 * n;
+        for (auto& limb : b58)
         {
-            carry += 256 * (iter[-1]);
-            iter[-1] = carry % 58;
-            carry /= 58;
+            carry += limb << shift;
+            limb = carry % b58Limb;
+            carry /= b58Limb;
+        }
+        while (carry != 0)
+        {
+            b58.push_back(carry % b58Limb);
+            carry /= b58Limb;
         }
-        assert(carry == 0);
-        pbegin++;
     }
 
-    // Skip leading zeroes in base58 result.
-    auto iter = b58begin;
-    while (iter != b58end && *iter == 0)
-        ++iter;
-
     // Translate the result into a string.
     std::string str;
-    str.reserve(zeroes + (b58end - iter));
+    str.reserve(zeroes + 5 * b58.size());
     str.assign(zeroes, alphabetForward[0]);
-    while (iter != b58end)
-        str += alphabetForward[*(iter++)];
+
+    for (auto iter = b58.rbegin(); iter != b58.rend(); ++iter)
+    {
+        char digits[5];
+        auto limb = *iter;
+        for (auto d = std::rbegin(digits); d != std::rend(digits); ++d)
+        {
+            *d = alphabetForward[limb % 58];
+            limb /= 58;
+        }
+
+        // Skip leading zeroes in base58 result.
+        auto first = std::begin(digits);
+        if (iter == b58.rbegin())
+        {
+            while (*first == alphabetForward[0])
+                ++first;
+        }
+        str.append(first, std::end(digits));
+    }
     return str;
 }
 
@@ -163,33 +190,54 @@ decodeBase58(std::string const& s)
     if (remain > 64)
         return {};
 
-    // Allocate enough space in big-endian base256 representation.
-    // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(remain * 733 / 1000 + 1);
+    // The base 256^4 limbs of the number, least significant first.
+    boost::container::small_vector<std::uint32_t, 16> b256;
+    b256.reserve(remain * 733 / 4000 + 1);
+
     while (remain > 0)
     {
-        auto carry = alphabetReverse[*psz];
-        if (carry == -1)
-            return {};
-        // Apply "b256 = b256 * 58 + carry".
-        for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+        // Take up to five digits at a time.
+        auto const n = std::min<std::size_t>(5, remain);
+        std::uint64_t carry = 0;
+        std::uint64_t base = 1;
+        for (std::size_t i = 0; i < n; ++i)
         {
-            carry += 58 * *iter;
-            *iter = carry % 256;
-            carry /= 256;
+            auto const digit = alphabetReverse[*psz++];
+            if (digit == -1)
+                return {};
+            carry = carry * 58 + digit;
+            base *= 58;
         }
-        assert(carry == 0);
-        ++psz;
-        --remain;
+        remain -= n;
+
+        // Apply "b256 = b256 * 58^n + carry".
+        for (auto& limb : b256)
+        {
+            carry += limb * base;
+            limb = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry != 0)
+            b256.push_back(static_cast<std::uint32_t>(carry));
     }
-    // Skip leading zeroes in b256.
-    auto iter = std::find_if(
-        b256.begin(), b256.end(), [](unsigned char c) { return c != 0; });
+
     std::string result;
-    result.reserve(zeroes + (b256.end() - iter));
+    result.reserve(zeroes + 4 * b256.size());
     result.assign(zeroes, 0x00);
-    while (iter != b256.end())
-        result.push_back(*(iter++));
+
+    bool leading = true;
+    for (auto iter = b256.rbegin(); iter != b256.rend(); ++iter)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            auto const c = static_cast<char>(*iter >> shift);
+            // Skip leading zeroes in b256.
+            if (leading && c == 0)
+                continue;
+            leading = false;
+            result.push_back(c);
+        }
+    }
     return result;
 }
 
@@ -201,12 +249,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
     // expanded token includes type + 4 byte checksum
     auto const expanded = 1 + size + 4;
 
-    // We need expanded + expanded * (log(256) / log(58)) which is
-    // bounded by expanded + expanded * (138 / 100 + 1) which works
-    // out to expanded * 3:
-    auto const bufsize = expanded * 3;
-
-    boost::container::small_vector<std::uint8_t, 1024> buf(bufsize);
+    boost::container::small_vector<std::uint8_t, 64> buf(expanded);
 
     // Lay the data out as
     //      <type><token><checksum>
@@ -215,8 +258,7 @@ encodeBase58Token(TokenType type, void const* token, std::size_t size)
         std::memcpy(buf.data() + 1, token, size);
     checksum(buf.data() + 1 + size, buf.data(), 1 + size);
 
-    return detail::encodeBase58(
-        buf.data(), expanded, buf.data() + expanded, bufsize - expanded);
+    return detail::encodeBase58(buf.data(), expanded);
 }
 
 std::string
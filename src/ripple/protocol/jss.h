@@ -147,6 +147,7 @@ JSS(auth_change_queued);     // out: AccountInfo
 JSS(available);              // out: ValidatorList
 JSS(avg_bps_recv);           // out: Peers
 JSS(avg_bps_sent);           // out: Peers
+JSS(avg_delay_us);           // out: Peers
 JSS(balance);                // out: AccountLines
 JSS(balances);               // out: GatewayBalances
 JSS(base);                   // out: LogLevel
@@ -269,6 +270,8 @@ JSS(fix_txns);              // in: LedgerCleaner
 JSS(flags);                 // out: AccountOffers,
                             //      NetworkOPs
 JSS(forward);               // in: AccountTx
+JSS(fragment_bytes);        // out: GetCounts
+JSS(fragment_hit_rate);     // out: GetCounts
 JSS(freeze);                // out: AccountLines
 JSS(freeze_peer);           // out: AccountLines
 JSS(frozen_balances);       // out: GatewayBalances
@@ -413,6 +416,8 @@ JSS(node_binary);                // out: LedgerEntry
 JSS(node_read_bytes);            // out: GetCounts
 JSS(node_read_errors);           // out: GetCounts
 JSS(node_read_retries);          // out: GetCounts
+JSS(node_reads_filtered);        // out: GetCounts
+JSS(node_reads_filter_false_positives);  // out: GetCounts
 JSS(node_reads_hit);             // out: GetCounts
 JSS(node_reads_total);           // out: GetCounts
 JSS(node_reads_duration_us);     // out: GetCounts
@@ -424,6 +429,8 @@ JSS(node_writes_duration_us);    // out: GetCounts
 JSS(node_write_retries);         // out: GetCounts
 JSS(node_writes_delayed);        // out::GetCounts
 JSS(obligations);                // out: GatewayBalances
+JSS(obligations_index_hit_rate); // out: GetCounts
+JSS(obligations_index_size);     // out: GetCounts
 JSS(offer);                      // in: LedgerEntry
 JSS(offers);                     // out: NetworkOPs, AccountOffers, Subscribe
 JSS(offline);                    // in: TransactionSign
@@ -474,7 +481,7 @@ JSS(quality_in);                  // out: AccountLines
 JSS(quality_out);                 // out: AccountLines
 JSS(queue);                       // in: AccountInfo
 JSS(queue_data);                  // out: AccountInfo
-JSS(queued);                      // out: SubmitTransaction
+JSS(queued);                      // out: SubmitTransaction, Peers
 JSS(queued_duration_us);
 JSS(random);                // out: Random
 JSS(raw_meta);              // out: AcceptedLedgerTx
@@ -499,6 +506,11 @@ JSS(ripple_state);          // in: LedgerEntr
 JSS(ripplerpc);             // ripple RPC version
 JSS(role);                  // out: Ping.cpp
 JSS(rpc);
+JSS(rpc_cache_bytes);         // out: GetCounts
+JSS(rpc_cache_evictions);     // out: GetCounts
+JSS(rpc_cache_hit_rate);      // out: GetCounts
+JSS(rpc_cache_size);          // out: GetCounts
+JSS(rpc_sub_dropped);         // out: GetCounts
 JSS(rt_accounts);  // in: Subscribe, Unsubscribe
 JSS(running_duration_us);
 JSS(search_depth);              // in: RipplePathFind
@@ -510,6 +522,7 @@ JSS(seed);                      //
 JSS(seed_hex);                  // in: WalletPropose, TransactionSign
 JSS(send_currencies);           // out: AccountCurrencies
 JSS(send_max);                  // in: PathRequest, RipplePathFind
+JSS(send_queue);                // out: Peers
 JSS(seq);                       // in: LedgerEntry;
                                 // out: NetworkOPs, RPCSub, AccountOffers,
                                 //      ValidatorList, ValidatorInfo, Manifest
@@ -525,6 +538,8 @@ JSS(settle_delay);              // out: AccountChannels
 JSS(severity);                  // in: LogLevel
 JSS(shards);                    // in/out: GetCounts, DownloadShard
 JSS(signature);                 // out: NetworkOPs, ChannelAuthorize
+JSS(signature_cache_hit_rate);  // out: GetCounts
+JSS(signature_cache_size);      // out: GetCounts
 JSS(signature_verified);        // out: ChannelVerify
 JSS(signing_key);               // out: NetworkOPs
 JSS(signing_keys);              // out: ValidatorList
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_OBLIGATIONSINDEX_H_INCLUDED
+#define RIPPLE_RPC_OBLIGATIONSINDEX_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/json/json_value.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/STAmount.h>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+
+namespace ripple {
+
+class AcceptedLedger;
+
+namespace RPC {
+
+/** Keeps the obligations of recently queried issuers up to date.
+
+    gateway_balances sums the balances of every trust line of an issuer,
+    which for a large issuer means reading hundreds of thousands of ledger
+    entries. The index keeps those sums as of the last published ledger,
+    for the issuers queried most recently, and updates them from the trust
+    lines changed by the transactions of each newly published ledger. The
+    sums of an issuer are read again from the ledger periodically, so that
+    rounding errors do not accumulate.
+
+    An index tracking zero issuers is disabled.
+*/
+class ObligationsIndex
+{
+public:
+    /** The trust lines of an issuer, seen from the issuer's side. */
+    struct Obligations
+    {
+        // The balances owed by the issuer and not frozen, by currency
+        std::map<Currency, STAmount> sums;
+
+        // The trust lines which hold an asset of the issuer or a frozen
+        // obligation
+        std::set<uint256> others;
+    };
+
+    // The number of ledgers after which the sums are read again
+    static constexpr LedgerIndex rebuildInterval = 256;
+
+    explicit ObligationsIndex(std::size_t maxIssuers);
+
+    ObligationsIndex(ObligationsIndex const&) = delete;
+    ObligationsIndex&
+    operator=(ObligationsIndex const&) = delete;
+
+    bool
+    enabled() const
+    {
+        return maxIssuers_ != 0;
+    }
+
+    /** Returns the obligations of an issuer in a ledger.
+
+        Only the last published ledger is indexed: for any other ledger,
+        nothing is returned. An issuer which is not tracked yet is read
+        from the ledger, and tracked from then on.
+    */
+    std::optional<Obligations>
+    fetch(ReadView const& ledger, AccountID const& issuer);
+
+    /** Updates the tracked issuers with the changes of a published ledger.
+
+        If the ledger does not follow the last one published, the tracked
+        issuers are forgotten.
+    */
+    void
+    apply(AcceptedLedger const& ledger);
+
+    /** Reads the obligations of an issuer from a ledger. */
+    static Obligations
+    build(ReadView const& ledger, AccountID const& issuer);
+
+    /** Adds the index's statistics to a get_counts result. */
+    void
+    getCounts(Json::Value& obj) const;
+
+    std::size_t
+    size() const;
+
+    std::uint64_t
+    hits() const;
+
+    std::uint64_t
+    misses() const;
+
+private:
+    struct Entry
+    {
+        AccountID issuer;
+        LedgerIndex builtSeq;
+        Obligations obligations;
+    };
+
+    using List = std::list<Entry>;
+
+    std::size_t const maxIssuers_;
+
+    mutable std::mutex mutex_;
+
+    // The last published ledger
+    uint256 hash_;
+
+    // Most recently used first
+    List entries_;
+    hash_map<AccountID, List::iterator> index_;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+#define RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/json/json_value.h>
+#include <ripple/rpc/Role.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ripple {
+namespace RPC {
+
+/** Remembers the results of commands that read a validated ledger.
+
+    A validated ledger never changes, so repeating a read-only command
+    against one gives the same result. Results are keyed by the command,
+    the caller's role and API version, the canonical form of the request
+    parameters and the hash of the ledger. The least recently used results
+    are evicted to keep their estimated size within a byte budget.
+
+    A cache with a budget of zero bytes is disabled.
+*/
+class ResponseCache
+{
+public:
+    explicit ResponseCache(std::size_t maxBytes);
+
+    ResponseCache(ResponseCache const&) = delete;
+    ResponseCache&
+    operator=(ResponseCache const&) = delete;
+
+    bool
+    enabled() const
+    {
+        return maxBytes_ != 0;
+    }
+
+    /** Returns the key for a request.
+
+        Fields that identify the request rather than select its result,
+        such as the id and the command name, are left out, and the
+        remaining parameters are written in sorted order.
+    */
+    static std::string
+    makeKey(
+        std::string const& method,
+        Json::Value const& params,
+        uint256 const& ledgerHash,
+        Role role,
+        unsigned int apiVersion);
+
+    /** Returns the result stored for a key, or nullptr. */
+    std::shared_ptr<Json::Value const>
+    fetch(std::string const& key);
+
+    /** Stores a result, evicting older ones as needed.
+
+        Results larger than a quarter of the budget are not stored.
+    */
+    void
+    insert(std::string const& key, Json::Value const& result);
+
+    /** Adds the cache's statistics to a get_counts result. */
+    void
+    getCounts(Json::Value& obj) const;
+
+    std::size_t
+    size() const;
+
+    std::size_t
+    bytes() const;
+
+    std::uint64_t
+    hits() const;
+
+    std::uint64_t
+    misses() const;
+
+    std::uint64_t
+    evictions() const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<Json::Value const> result;
+        std::size_t bytes;
+    };
+
+    using List = std::list<Entry>;
+
+    std::size_t const maxBytes_;
+
+    mutable std::mutex mutex_;
+
+    // Most recently used first. The index refers to the keys in the list.
+    List entries_;
+    std::unordered_map<std::string_view, List::iterator> index_;
+    std::size_t bytes_ = 0;
+
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+    std::uint64_t evictions_ = 0;
+};
+
+}  // namespace RPC
+}  // namespace ripple
+
+#endif
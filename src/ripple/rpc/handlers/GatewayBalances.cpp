@@ -26,6 +26,7 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/ObligationsIndex.h>
 #include <ripple/rpc/impl/RPCHelpers.h>
 
 namespace ripple {
@@ -140,53 +141,95 @@ doGatewayBalances(RPC::JsonContext& context)
     std::map<AccountID, std::vector<STAmount>> assets;
     std::map<AccountID, std::vector<STAmount>> frozenBalances;
 
-    // Traverse the cold wallet's trust lines
-    {
-        forEachItem(
-            *ledger, accountID, [&](std::shared_ptr<SLE const> const& sle) {
-                auto rs = PathFindTrustLine::makeItem(accountID, sle);
+    auto addLine = [&](std::shared_ptr<SLE const> const& sle) {
+        auto rs = PathFindTrustLine::makeItem(accountID, sle);
 
-                if (!rs)
-                    return;
+        if (!rs)
+            return;
 
-                int balSign = rs->getBalance().signum();
-                if (balSign == 0)
-                    return;
+        int balSign = rs->getBalance().signum();
+        if (balSign == 0)
+            return;
 
-                auto const& peer = rs->getAccountIDPeer();
+        auto const& peer = rs->getAccountIDPeer();
 
-                // Here, a negative balance means the cold wallet owes (normal)
-                // A positive balance means the cold wallet has an asset
-                // (unusual)
+        // Here, a negative balance means the cold wallet owes (normal)
+        // A positive balance means the cold wallet has an asset
+        // (unusual)
 
-                if (hotWallets.count(peer) > 0)
-                {
-                    // This is a specified hot wallet
-                    hotBalances[peer].push_back(-rs->getBalance());
-                }
-                else if (balSign > 0)
-                {
-                    // This is a gateway asset
-                    assets[peer].push_back(rs->getBalance());
-                }
-                else if (rs->getFreeze())
-                {
-                    // An obligation the gateway has frozen
-                    frozenBalances[peer].push_back(-rs->getBalance());
-                }
-                else
+        if (hotWallets.count(peer) > 0)
+        {
+            // This is a specified hot wallet
+            hotBalances[peer].push_back(-rs->getBalance());
+        }
+        else if (balSign > 0)
+        {
+            // This is a gateway asset
+            assets[peer].push_back(rs->getBalance());
+        }
+        else if (rs->getFreeze())
+        {
+            // An obligation the gateway has frozen
+            frozenBalances[peer].push_back(-rs->getBalance());
+        }
+        else
+        {
+            // normal negative balance, obligation to customer
+            auto& bal = sums[rs->getBalance().getCurrency()];
+            if (bal == beast::zero)
+            {
+                // This is needed to set the currency code correctly
+                bal = -rs->getBalance();
+            }
+            else
+                bal -= rs->getBalance();
+        }
+    };
+
+    std::optional<RPC::ObligationsIndex::Obligations> indexed;
+    if (auto& index = context.app.getObligationsIndex(); index.enabled())
+        indexed = index.fetch(*ledger, accountID);
+
+    if (indexed)
+    {
+        // The index sums the obligations to the hot wallets too
+        sums = std::move(indexed->sums);
+        for (auto const& hotWallet : hotWallets)
+        {
+            if (hotWallet == accountID)
+                continue;
+
+            for (auto it = sums.begin(); it != sums.end();)
+            {
+                auto const rs = PathFindTrustLine::makeItem(
+                    accountID,
+                    ledger->read(
+                        keylet::line(accountID, hotWallet, it->first)));
+                if (rs && rs->getBalance().signum() < 0 && !rs->getFreeze())
                 {
-                    // normal negative balance, obligation to customer
-                    auto& bal = sums[rs->getBalance().getCurrency()];
-                    if (bal == beast::zero)
+                    hotBalances[hotWallet].push_back(-rs->getBalance());
+                    it->second += rs->getBalance();
+                    if (it->second.signum() <= 0)
                     {
-                        // This is needed to set the currency code correctly
-                        bal = -rs->getBalance();
+                        it = sums.erase(it);
+                        continue;
                     }
-                    else
-                        bal -= rs->getBalance();
                 }
-            });
+                ++it;
+            }
+        }
+
+        // The trust lines which are not obligations are read
+        for (auto const& key : indexed->others)
+        {
+            if (auto const sle = ledger->read(Keylet(ltRIPPLE_STATE, key)))
+                addLine(sle);
+        }
+    }
+    else
+    {
+        // Traverse the cold wallet's trust lines
+        forEachItem(*ledger, accountID, addLine);
     }
 
     if (!sums.empty())
@@ -30,8 +30,11 @@
 #include <ripple/nodestore/Database.h>
 #include <ripple/nodestore/DatabaseShard.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/SignatureCache.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/ObligationsIndex.h>
+#include <ripple/rpc/ResponseCache.h>
 #include <ripple/shamap/ShardFamily.h>
 
 namespace ripple {
@@ -111,6 +114,20 @@ getCountsJson(Application& app, int minObjectCount)
     ret[jss::ledger_hit_rate] = app.getLedgerMaster().getCacheHitRate();
     ret[jss::AL_size] = Json::UInt(app.getAcceptedLedgerCache().size());
     ret[jss::AL_hit_rate] = app.getAcceptedLedgerCache().getHitRate();
+    ret[jss::fragment_bytes] = std::to_string(
+        app.getLedgerMaster().getFragmentCache().bytes());
+    ret[jss::fragment_hit_rate] =
+        app.getLedgerMaster().getFragmentCache().getHitRate();
+    ret[jss::signature_cache_size] = Json::UInt(signatureCache().size());
+    ret[jss::signature_cache_hit_rate] = signatureCache().getHitRate();
+
+    if (auto const& cache = app.getRPCResponseCache(); cache.enabled())
+        cache.getCounts(ret);
+
+    if (auto const& index = app.getObligationsIndex(); index.enabled())
+        index.getCounts(ret);
+
+    app.getOPs().getRpcSubCounts(ret);
 
     ret[jss::fullbelow_size] =
         static_cast<int>(app.getNodeFamily().getFullBelowCache(0)->size());
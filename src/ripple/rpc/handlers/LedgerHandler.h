@@ -76,6 +76,12 @@ public:
         return NO_CONDITION;
     }
 
+    static bool
+    cacheable()
+    {
+        return true;
+    }
+
 private:
     JsonContext& context_;
     std::shared_ptr<ReadView const> ledger_;
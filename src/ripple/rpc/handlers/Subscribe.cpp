@@ -76,7 +76,7 @@ doSubscribe(RPC::JsonContext& context)
                 auto rspSub = make_RPCSub(
                     context.app.getOPs(),
                     context.app.getIOService(),
-                    context.app.getJobQueue(),
+                    context.app.config(),
                     strUrl,
                     strUsername,
                     strPassword,
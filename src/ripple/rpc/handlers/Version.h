@@ -64,6 +64,12 @@ public:
         return NO_CONDITION;
     }
 
+    static bool
+    cacheable()
+    {
+        return false;
+    }
+
 private:
     unsigned int apiVersion_;
     bool betaEnabled_;
@@ -60,19 +60,28 @@ handle(JsonContext& context, Object& object)
 Handler const handlerArray[]{
     // Some handlers not specified here are added to the table via addHandler()
     // Request-response methods
-    {"account_info", byRef(&doAccountInfo), Role::USER, NO_CONDITION},
+    {"account_info", byRef(&doAccountInfo), Role::USER, NO_CONDITION, true},
     {"account_currencies",
      byRef(&doAccountCurrencies),
      Role::USER,
-     NO_CONDITION},
-    {"account_lines", byRef(&doAccountLines), Role::USER, NO_CONDITION},
-    {"account_channels", byRef(&doAccountChannels), Role::USER, NO_CONDITION},
+     NO_CONDITION,
+     true},
+    {"account_lines", byRef(&doAccountLines), Role::USER, NO_CONDITION, true},
+    {"account_channels",
+     byRef(&doAccountChannels),
+     Role::USER,
+     NO_CONDITION,
+     true},
     {"account_nfts", byRef(&doAccountNFTs), Role::USER, NO_CONDITION},
-    {"account_objects", byRef(&doAccountObjects), Role::USER, NO_CONDITION},
-    {"account_offers", byRef(&doAccountOffers), Role::USER, NO_CONDITION},
+    {"account_objects",
+     byRef(&doAccountObjects),
+     Role::USER,
+     NO_CONDITION,
+     true},
+    {"account_offers", byRef(&doAccountOffers), Role::USER, NO_CONDITION, true},
     {"account_tx", byRef(&doAccountTxJson), Role::USER, NO_CONDITION},
     {"blacklist", byRef(&doBlackList), Role::ADMIN, NO_CONDITION},
-    {"book_offers", byRef(&doBookOffers), Role::USER, NO_CONDITION},
+    {"book_offers", byRef(&doBookOffers), Role::USER, NO_CONDITION, true},
     {"can_delete", byRef(&doCanDelete), Role::ADMIN, NO_CONDITION},
     {"channel_authorize", byRef(&doChannelAuthorize), Role::USER, NO_CONDITION},
     {"channel_verify", byRef(&doChannelVerify), Role::USER, NO_CONDITION},
@@ -84,9 +93,17 @@ Handler const handlerArray[]{
      NO_CONDITION},
     {"download_shard", byRef(&doDownloadShard), Role::ADMIN, NO_CONDITION},
 #ifdef RIPPLED_REPORTING
-    {"gateway_balances", byRef(&doGatewayBalances), Role::ADMIN, NO_CONDITION},
+    {"gateway_balances",
+     byRef(&doGatewayBalances),
+     Role::ADMIN,
+     NO_CONDITION,
+     true},
 #else
-    {"gateway_balances", byRef(&doGatewayBalances), Role::USER, NO_CONDITION},
+    {"gateway_balances",
+     byRef(&doGatewayBalances),
+     Role::USER,
+     NO_CONDITION,
+     true},
 #endif
     {"get_counts", byRef(&doGetCounts), Role::ADMIN, NO_CONDITION},
     {"feature", byRef(&doFeature), Role::ADMIN, NO_CONDITION},
@@ -106,7 +123,7 @@ Handler const handlerArray[]{
      Role::USER,
      NEEDS_CURRENT_LEDGER},
     {"ledger_data", byRef(&doLedgerData), Role::USER, NO_CONDITION},
-    {"ledger_entry", byRef(&doLedgerEntry), Role::USER, NO_CONDITION},
+    {"ledger_entry", byRef(&doLedgerEntry), Role::USER, NO_CONDITION, true},
     {"ledger_header", byRef(&doLedgerHeader), Role::USER, NO_CONDITION},
     {"ledger_request", byRef(&doLedgerRequest), Role::ADMIN, NO_CONDITION},
     {"log_level", byRef(&doLogLevel), Role::ADMIN, NO_CONDITION},
@@ -231,6 +248,7 @@ private:
         h.valueMethod_ = &handle<Json::Value, HandlerImpl>;
         h.role_ = HandlerImpl::role();
         h.condition_ = HandlerImpl::condition();
+        h.cacheable_ = HandlerImpl::cacheable();
 
         table_[HandlerImpl::name()] = h;
     }
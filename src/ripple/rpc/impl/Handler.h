@@ -52,6 +52,9 @@ struct Handler
     Method<Json::Value> valueMethod_;
     Role role_;
     RPC::Condition condition_;
+
+    // Whether the results for validated ledgers may be cached
+    bool cacheable_ = false;
 };
 
 Handler const*
@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/ledger/View.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ObligationsIndex.h>
+
+namespace ripple {
+namespace RPC {
+
+namespace {
+
+// The fields of a trust line which decide its part in the obligations
+struct LineState
+{
+    STAmount balance;
+    std::uint32_t flags = 0;
+    AccountID low;
+    AccountID high;
+};
+
+// The part of a trust line in the obligations of one of its accounts
+struct Share
+{
+    enum Kind { none, obligation, other };
+
+    Kind kind = none;
+    STAmount amount;
+};
+
+Share
+share(AccountID const& account, LineState const& line)
+{
+    bool const viewLowest = account == line.low;
+    auto balance = line.balance;
+    if (!viewLowest)
+        balance.negate();
+
+    auto const sign = balance.signum();
+    if (sign == 0)
+        return {};
+
+    // Matches the classification of the trust lines in gateway_balances
+    if (sign > 0 || (line.flags & (viewLowest ? lsfLowFreeze : lsfHighFreeze)))
+        return {Share::other, {}};
+    return {Share::obligation, -balance};
+}
+
+void
+addShare(
+    ObligationsIndex::Obligations& obligations,
+    uint256 const& key,
+    Share const& s)
+{
+    if (s.kind == Share::obligation)
+    {
+        auto& sum = obligations.sums[s.amount.getCurrency()];
+        if (sum == beast::zero)
+            sum = s.amount;
+        else
+            sum += s.amount;
+    }
+    else if (s.kind == Share::other)
+    {
+        obligations.others.insert(key);
+    }
+}
+
+void
+removeShare(
+    ObligationsIndex::Obligations& obligations,
+    uint256 const& key,
+    Share const& s)
+{
+    if (s.kind == Share::obligation)
+    {
+        auto const it = obligations.sums.find(s.amount.getCurrency());
+        if (it == obligations.sums.end())
+            return;
+        it->second -= s.amount;
+        if (it->second.signum() <= 0)
+            obligations.sums.erase(it);
+    }
+    else if (s.kind == Share::other)
+    {
+        obligations.others.erase(key);
+    }
+}
+
+STObject const*
+innerObject(STObject const& node, SField const& field)
+{
+    auto const index = node.getFieldIndex(field);
+    if (index == -1)
+        return nullptr;
+    return dynamic_cast<STObject const*>(&node.peekAtIndex(index));
+}
+
+// Reads a trust line from metadata, with the previous values of the
+// fields that changed if given
+LineState
+lineState(STObject const& fields, STObject const* previous)
+{
+    LineState line;
+    line.balance = fields[~sfBalance].value_or(STAmount{});
+    line.flags = fields[~sfFlags].value_or(0);
+    if (auto const limit = fields[~sfLowLimit])
+        line.low = limit->getIssuer();
+    if (auto const limit = fields[~sfHighLimit])
+        line.high = limit->getIssuer();
+
+    if (previous)
+    {
+        if (auto const balance = (*previous)[~sfBalance])
+            line.balance = *balance;
+        if (auto const flags = (*previous)[~sfFlags])
+            line.flags = *flags;
+    }
+    return line;
+}
+
+// The states of a trust line before and after a transaction
+std::pair<std::optional<LineState>, std::optional<LineState>>
+lineChange(STObject const& node)
+{
+    if (node.getFName() == sfCreatedNode)
+    {
+        if (auto const fields = innerObject(node, sfNewFields))
+            return {std::nullopt, lineState(*fields, nullptr)};
+        return {};
+    }
+
+    auto const fields = innerObject(node, sfFinalFields);
+    if (!fields)
+        return {};
+
+    auto before = lineState(*fields, innerObject(node, sfPreviousFields));
+    if (node.getFName() == sfDeletedNode)
+        return {std::move(before), std::nullopt};
+    return {std::move(before), lineState(*fields, nullptr)};
+}
+
+}  // namespace
+
+ObligationsIndex::ObligationsIndex(std::size_t maxIssuers)
+    : maxIssuers_(maxIssuers)
+{
+}
+
+std::optional<ObligationsIndex::Obligations>
+ObligationsIndex::fetch(ReadView const& ledger, AccountID const& issuer)
+{
+    auto const& info = ledger.info();
+    {
+        std::lock_guard lock(mutex_);
+        if (ledger.open() || hash_.isZero() || info.hash != hash_)
+            return std::nullopt;
+
+        if (auto const it = index_.find(issuer); it != index_.end())
+        {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            ++hits_;
+            return it->second->obligations;
+        }
+        ++misses_;
+    }
+
+    // Read the ledger without blocking the updates
+    auto obligations = build(ledger, issuer);
+
+    std::lock_guard lock(mutex_);
+
+    // Unless a ledger was published meanwhile, track the issuer
+    if (info.hash == hash_ && index_.find(issuer) == index_.end())
+    {
+        entries_.push_front({issuer, info.seq, obligations});
+        index_[issuer] = entries_.begin();
+
+        while (entries_.size() > maxIssuers_)
+        {
+            index_.erase(entries_.back().issuer);
+            entries_.pop_back();
+        }
+    }
+
+    return obligations;
+}
+
+void
+ObligationsIndex::apply(AcceptedLedger const& ledger)
+{
+    auto const& info = ledger.getLedger()->info();
+
+    std::lock_guard lock(mutex_);
+
+    if (info.parentHash != hash_)
+    {
+        index_.clear();
+        entries_.clear();
+    }
+    hash_ = info.hash;
+
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        if (info.seq - it->builtSeq >= rebuildInterval)
+        {
+            index_.erase(it->issuer);
+            it = entries_.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    if (entries_.empty())
+        return;
+
+    for (auto const& tx : ledger)
+    {
+        for (auto const& node : tx->getMeta().getNodes())
+        {
+            if (node.getFieldU16(sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+
+            auto const [before, after] = lineChange(node);
+            if (before && after && before->balance == after->balance &&
+                before->flags == after->flags)
+                continue;
+
+            auto const& line = after ? *after : *before;
+            auto const key = node.getFieldH256(sfLedgerIndex);
+            for (auto const& account : {line.low, line.high})
+            {
+                auto const it = index_.find(account);
+                if (it == index_.end())
+                    continue;
+
+                auto& obligations = it->second->obligations;
+                if (before)
+                    removeShare(obligations, key, share(account, *before));
+                if (after)
+                    addShare(obligations, key, share(account, *after));
+            }
+        }
+    }
+}
+
+ObligationsIndex::Obligations
+ObligationsIndex::build(ReadView const& ledger, AccountID const& issuer)
+{
+    Obligations obligations;
+    forEachItem(ledger, issuer, [&](std::shared_ptr<SLE const> const& sle) {
+        if (!sle || sle->getType() != ltRIPPLE_STATE)
+            return;
+
+        LineState line;
+        line.balance = sle->getFieldAmount(sfBalance);
+        line.flags = sle->getFlags();
+        line.low = sle->getFieldAmount(sfLowLimit).getIssuer();
+        line.high = sle->getFieldAmount(sfHighLimit).getIssuer();
+        addShare(obligations, sle->key(), share(issuer, line));
+    });
+    return obligations;
+}
+
+void
+ObligationsIndex::getCounts(Json::Value& obj) const
+{
+    std::lock_guard lock(mutex_);
+    auto const total = hits_ + misses_;
+    obj[jss::obligations_index_size] = Json::UInt(entries_.size());
+    obj[jss::obligations_index_hit_rate] =
+        total == 0 ? 0.0 : hits_ * 100.0 / total;
+}
+
+std::size_t
+ObligationsIndex::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::uint64_t
+ObligationsIndex::hits() const
+{
+    std::lock_guard lock(mutex_);
+    return hits_;
+}
+
+std::uint64_t
+ObligationsIndex::misses() const
+{
+    std::lock_guard lock(mutex_);
+    return misses_;
+}
+
+}  // namespace RPC
+}  // namespace ripple
@@ -24,6 +24,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/basics/PerfLog.h>
 #include <ripple/basics/contract.h>
+#include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/json/Object.h>
@@ -33,11 +34,13 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/ResponseCache.h>
 #include <ripple/rpc/Role.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <ripple/rpc/impl/Tuning.h>
 #include <atomic>
 #include <chrono>
+#include <optional>
 
 namespace ripple {
 namespace RPC {
@@ -219,6 +222,96 @@ callMethod(
     }
 }
 
+/** Returns the hash of the validated ledger a request reads, if its
+    result may be cached.
+
+    The ledger must be named by hash, by sequence or as "validated".
+    Whether a ledger named by hash is validated is only known once the
+    command has run, so that is checked before its result is cached.
+*/
+std::optional<uint256>
+cacheableLedger(JsonContext const& context)
+{
+    auto const& params = context.params;
+    if (params.isMember(jss::ledger))
+        return std::nullopt;
+
+    if (params.isMember(jss::ledger_hash))
+    {
+        auto const& hashValue = params[jss::ledger_hash];
+        uint256 hash;
+        if (!hashValue.isString() || !hash.parseHex(hashValue.asString()))
+            return std::nullopt;
+        return hash;
+    }
+
+    if (!params.isMember(jss::ledger_index))
+        return std::nullopt;
+
+    auto& ledgerMaster = context.ledgerMaster;
+    auto const index = params[jss::ledger_index].asString();
+    if (index == "validated")
+    {
+        if (auto const ledger = ledgerMaster.getValidatedLedger())
+            return ledger->info().hash;
+        return std::nullopt;
+    }
+
+    std::uint32_t seq;
+    if (!beast::lexicalCastChecked(seq, index) ||
+        seq > ledgerMaster.getValidLedgerIndex())
+        return std::nullopt;
+
+    if (auto const hash = ledgerMaster.getHashBySeq(seq); hash.isNonZero())
+        return hash;
+    return std::nullopt;
+}
+
+/** Calls a command, answering it from the response cache when it reads
+    a validated ledger that the same request has read before.
+*/
+Status
+callCachedMethod(
+    JsonContext& context,
+    Handler const& handler,
+    Json::Value& result)
+{
+    auto& cache = context.app.getRPCResponseCache();
+    std::optional<uint256> ledgerHash;
+    if (cache.enabled() && handler.cacheable_ &&
+        !context.app.config().reporting())
+        ledgerHash = cacheableLedger(context);
+
+    if (!ledgerHash)
+        return callMethod(
+            context, handler.valueMethod_, handler.name_, result);
+
+    auto const key = ResponseCache::makeKey(
+        handler.name_,
+        context.params,
+        *ledgerHash,
+        context.role,
+        context.apiVersion);
+
+    if (auto const cached = cache.fetch(key))
+    {
+        result = *cached;
+        return Status::OK;
+    }
+
+    auto const ret =
+        callMethod(context, handler.valueMethod_, handler.name_, result);
+
+    // The command looks the ledger up again, and may have found a newer
+    // validated ledger, or one that is not validated at all.
+    if (!ret && !result.isMember(jss::error) &&
+        result.get(jss::validated, false).asBool() &&
+        result.get(jss::ledger_hash, "").asString() == to_string(*ledgerHash))
+        cache.insert(key, result);
+
+    return ret;
+}
+
 }  // namespace
 
 void
@@ -258,7 +351,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         return error;
     }
 
-    if (auto method = handler->valueMethod_)
+    if (handler->valueMethod_)
     {
         if (!context.headers.user.empty() ||
             !context.headers.forwardedFor.empty())
@@ -268,7 +361,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
                 << ", user: " << context.headers.user
                 << ", forwarded for: " << context.headers.forwardedFor;
 
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCachedMethod(context, *handler, result);
 
             JLOG(context.j.debug())
                 << "finish command: " << handler->name_
@@ -279,7 +372,7 @@ doCommand(RPC::JsonContext& context, Json::Value& result)
         }
         else
         {
-            auto ret = callMethod(context, method, handler->name_, result);
+            auto ret = callCachedMethod(context, *handler, result);
             injectReportingWarning(context, result);
             return ret;
         }
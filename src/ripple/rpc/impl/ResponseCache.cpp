@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/json/json_writer.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResponseCache.h>
+
+namespace ripple {
+namespace RPC {
+
+ResponseCache::ResponseCache(std::size_t maxBytes) : maxBytes_(maxBytes)
+{
+}
+
+std::string
+ResponseCache::makeKey(
+    std::string const& method,
+    Json::Value const& params,
+    uint256 const& ledgerHash,
+    Role role,
+    unsigned int apiVersion)
+{
+    Json::Value canonical(Json::objectValue);
+    for (auto it = params.begin(); it != params.end(); ++it)
+    {
+        std::string const name = it.memberName();
+        if (name == jss::id || name == jss::command || name == jss::method ||
+            name == jss::jsonrpc || name == jss::ripplerpc ||
+            name == jss::api_version)
+            continue;
+        canonical[name] = *it;
+    }
+
+    // Object members are kept sorted by name, so equal parameters are
+    // always written the same way.
+    std::string key = method;
+    key += ' ';
+    key += to_string(ledgerHash);
+    key += ' ';
+    key += std::to_string(static_cast<int>(role));
+    key += ' ';
+    key += std::to_string(apiVersion);
+    key += ' ';
+    key += Json::FastWriter().write(canonical);
+    return key;
+}
+
+std::shared_ptr<Json::Value const>
+ResponseCache::fetch(std::string const& key)
+{
+    std::lock_guard lock(mutex_);
+    auto const it = index_.find(key);
+    if (it == index_.end())
+    {
+        ++misses_;
+        return {};
+    }
+
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->result;
+}
+
+void
+ResponseCache::insert(std::string const& key, Json::Value const& result)
+{
+    if (!enabled())
+        return;
+
+    auto const bytes = key.size() + Json::FastWriter().write(result).size();
+    if (bytes > maxBytes_ / 4)
+        return;
+
+    auto value = std::make_shared<Json::Value const>(result);
+
+    std::lock_guard lock(mutex_);
+    if (index_.count(key) != 0)
+        return;
+
+    while (!entries_.empty() && bytes_ + bytes > maxBytes_)
+    {
+        auto const& last = entries_.back();
+        bytes_ -= last.bytes;
+        index_.erase(last.key);
+        entries_.pop_back();
+        ++evictions_;
+    }
+
+    entries_.push_front({key, std::move(value), bytes});
+    index_.emplace(entries_.front().key, entries_.begin());
+    bytes_ += bytes;
+}
+
+void
+ResponseCache::getCounts(Json::Value& obj) const
+{
+    std::lock_guard lock(mutex_);
+    auto const total = hits_ + misses_;
+    obj[jss::rpc_cache_size] = Json::UInt(entries_.size());
+    obj[jss::rpc_cache_bytes] = std::to_string(bytes_);
+    obj[jss::rpc_cache_hit_rate] = total == 0 ? 0.0 : hits_ * 100.0 / total;
+    obj[jss::rpc_cache_evictions] = std::to_string(evictions_);
+}
+
+std::size_t
+ResponseCache::size() const
+{
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t
+ResponseCache::bytes() const
+{
+    std::lock_guard lock(mutex_);
+    return bytes_;
+}
+
+std::uint64_t
+ResponseCache::hits() const
+{
+    std::lock_guard lock(mutex_);
+    return hits_;
+}
+
+std::uint64_t
+ResponseCache::misses() const
+{
+    std::lock_guard lock(mutex_);
+    return misses_;
+}
+
+std::uint64_t
+ResponseCache::evictions() const
+{
+    std::lock_guard lock(mutex_);
+    return evictions_;
+}
+
+}  // namespace RPC
+}  // namespace ripple
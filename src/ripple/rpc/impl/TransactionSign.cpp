@@ -232,6 +232,12 @@ checkPayment(
                     amount,
                     std::nullopt,
                     app);
+                if (auto const searchTime = app.config().PATH_SEARCH_TIME;
+                    searchTime != std::chrono::milliseconds::zero())
+                {
+                    pf.setDeadline(
+                        std::chrono::steady_clock::now() + searchTime);
+                }
                 if (pf.findPaths(app.config().PATH_SEARCH_OLD))
                 {
                     // 4 is the maxium paths
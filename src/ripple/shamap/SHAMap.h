@@ -33,6 +33,7 @@
 #include <ripple/shamap/SHAMapMissingNode.h>
 #include <ripple/shamap/SHAMapTreeNode.h>
 #include <ripple/shamap/TreeNodeCache.h>
+#include <array>
 #include <cassert>
 #include <stack>
 #include <vector>
@@ -119,6 +120,11 @@ public:
     /** The depth of the hash map: data is only present in the leaves */
     static inline constexpr unsigned int leafDepth = 64;
 
+    /** Flush the subtrees below the root in parallel when at least this
+        many nodes in the top two levels below the root need flushing.
+    */
+    static inline constexpr int parallelFlushThreshold = 128;
+
     using DeltaItem = std::pair<
         std::shared_ptr<SHAMapItem const>,
         std::shared_ptr<SHAMapItem const>>;
@@ -360,6 +366,21 @@ public:
 private:
     using SharedPtrNodeStack =
         std::stack<std::pair<std::shared_ptr<SHAMapTreeNode>, SHAMapNodeID>>;
+
+    /** The path from the root to a leaf, held with raw pointers.
+
+        The nodes are owned by the map, so a cursor remains valid until
+        the map is next modified; for an immutable map, that is for as
+        long as the map exists. The inner node at index `i` of `inner`
+        is at depth `i`.
+    */
+    struct Cursor
+    {
+        std::array<SHAMapInnerNode*, leafDepth> inner;
+        unsigned int depth = 0;
+        SHAMapLeafNode* leaf = nullptr;
+    };
+
     using DeltaRef = std::pair<
         std::shared_ptr<SHAMapItem const> const&,
         std::shared_ptr<SHAMapItem const> const&>;
@@ -410,34 +431,31 @@ private:
     std::shared_ptr<Node>
     preFlushNode(std::shared_ptr<Node> node) const;
 
-    /** write and canonicalize modified node */
+    /** canonicalize modified node and add it to the batch to be written */
     std::shared_ptr<SHAMapTreeNode>
-    writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const;
+    writeNode(
+        NodeObjectType t,
+        std::shared_ptr<SHAMapTreeNode> node,
+        NodeStore::Batch& batch) const;
+
+    /** write out and clear the batch, once full if `force` is false */
+    void
+    writeBatch(NodeStore::Batch& batch, bool force) const;
+
+    /** Walk towards the specified id, recording the path in the cursor.
+        On return `cursor.leaf` is the leaf reached, if any, which need
+        not hold the id.
+    */
+    void
+    walkTowardsKey(uint256 const& id, Cursor& cursor) const;
 
     // returns the first item at or below this node
     SHAMapLeafNode*
-    firstBelow(
-        std::shared_ptr<SHAMapTreeNode>,
-        SharedPtrNodeStack& stack,
-        int branch = 0) const;
+    firstBelow(SHAMapTreeNode* node, Cursor& cursor) const;
 
     // returns the last item at or below this node
     SHAMapLeafNode*
-    lastBelow(
-        std::shared_ptr<SHAMapTreeNode> node,
-        SharedPtrNodeStack& stack,
-        int branch = branchFactor) const;
-
-    // helper function for firstBelow and lastBelow
-    SHAMapLeafNode*
-    belowHelper(
-        std::shared_ptr<SHAMapTreeNode> node,
-        SharedPtrNodeStack& stack,
-        int branch,
-        std::tuple<
-            int,
-            std::function<bool(int)>,
-            std::function<void(int&)>> const& loopParams) const;
+    lastBelow(SHAMapTreeNode* node, Cursor& cursor) const;
 
     // Simple descent
     // Get a child of the specified node
@@ -484,9 +502,9 @@ private:
     hasLeafNode(uint256 const& tag, SHAMapHash const& hash) const;
 
     SHAMapLeafNode const*
-    peekFirstItem(SharedPtrNodeStack& stack) const;
+    peekFirstItem(Cursor& cursor) const;
     SHAMapLeafNode const*
-    peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const;
+    peekNextItem(Cursor& cursor) const;
     bool
     walkBranch(
         SHAMapTreeNode* node,
@@ -496,6 +514,11 @@ private:
         int& maxCount) const;
     int
     walkSubTree(bool doWrite, NodeObjectType t);
+    int
+    walkSubTree(
+        std::shared_ptr<SHAMapTreeNode>& node,
+        bool doWrite,
+        NodeObjectType t);
 
     // Structure to track information about call to
     // getMissingNodes while it's in progress
@@ -637,7 +660,7 @@ public:
     using pointer = value_type const*;
 
 private:
-    SharedPtrNodeStack stack_;
+    Cursor cursor_;
     SHAMap const* map_ = nullptr;
     pointer item_ = nullptr;
 
@@ -663,7 +686,7 @@ public:
 private:
     explicit const_iterator(SHAMap const* map);
     const_iterator(SHAMap const* map, std::nullptr_t);
-    const_iterator(SHAMap const* map, pointer item, SharedPtrNodeStack&& stack);
+    const_iterator(SHAMap const* map, Cursor const& cursor);
 
     friend bool
     operator==(const_iterator const& x, const_iterator const& y);
@@ -674,7 +697,7 @@ inline SHAMap::const_iterator::const_iterator(SHAMap const* map) : map_(map)
 {
     assert(map_ != nullptr);
 
-    if (auto temp = map_->peekFirstItem(stack_))
+    if (auto temp = map_->peekFirstItem(cursor_))
         item_ = temp->peekItem().get();
 }
 
@@ -685,9 +708,8 @@ inline SHAMap::const_iterator::const_iterator(SHAMap const* map, std::nullptr_t)
 
 inline SHAMap::const_iterator::const_iterator(
     SHAMap const* map,
-    pointer item,
-    SharedPtrNodeStack&& stack)
-    : stack_(std::move(stack)), map_(map), item_(item)
+    Cursor const& cursor)
+    : cursor_(cursor), map_(map), item_(cursor.leaf->peekItem().get())
 {
 }
 
@@ -706,7 +728,7 @@ SHAMap::const_iterator::operator->() const
 inline SHAMap::const_iterator&
 SHAMap::const_iterator::operator++()
 {
-    if (auto temp = map_->peekNextItem(item_->key(), stack_))
+    if (auto temp = map_->peekNextItem(cursor_))
         item_ = temp->peekItem().get();
     else
         item_ = nullptr;
@@ -29,6 +29,7 @@
 
 #include <atomic>
 #include <bitset>
+#include <cassert>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -140,6 +141,18 @@ public:
     bool
     isEmptyBranch(int m) const;
 
+    /** Returns the first non-empty branch at or after `m`, or
+        branchFactor if there is none.
+    */
+    int
+    nextBranch(int m) const;
+
+    /** Returns the last non-empty branch at or before `m`, or
+        -1 if there is none.
+    */
+    int
+    prevBranch(int m) const;
+
     int
     getBranchCount() const;
 
@@ -200,6 +213,40 @@ SHAMapInnerNode::isEmptyBranch(int m) const
     return (isBranch_ & (1 << m)) == 0;
 }
 
+inline int
+SHAMapInnerNode::nextBranch(int m) const
+{
+    assert(m >= 0 && m <= static_cast<int>(branchFactor));
+    std::uint32_t const bits = isBranch_ & (0xFFFFu << m) & 0xFFFFu;
+    if (bits == 0)
+        return branchFactor;
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else
+    while ((bits & (1u << m)) == 0)
+        ++m;
+    return m;
+#endif
+}
+
+inline int
+SHAMapInnerNode::prevBranch(int m) const
+{
+    assert(m >= -1 && m < static_cast<int>(branchFactor));
+    if (m < 0)
+        return -1;
+    std::uint32_t const bits = isBranch_ & ((2u << m) - 1);
+    if (bits == 0)
+        return -1;
+#if defined(__clang__) || defined(__GNUC__)
+    return 31 - __builtin_clz(bits);
+#else
+    while ((bits & (1u << m)) == 0)
+        --m;
+    return m;
+#endif
+}
+
 inline bool
 SHAMapInnerNode::isFullBelow(std::uint32_t generation) const
 {
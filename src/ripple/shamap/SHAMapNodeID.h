@@ -158,6 +158,11 @@ deserializeSHAMapNodeID(std::string const& s)
 [[nodiscard]] unsigned int
 selectBranch(SHAMapNodeID const& id, uint256 const& hash);
 
+/** Returns the branch that would contain the given hash, below a node at
+    the given depth */
+[[nodiscard]] unsigned int
+selectBranch(unsigned int depth, uint256 const& hash);
+
 }  // namespace ripple
 
 #endif
@@ -17,7 +17,9 @@
 */
 //==============================================================================
 
+#include <ripple/basics/WorkerPool.h>
 #include <ripple/basics/contract.h>
+#include <ripple/basics/scope.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/shamap/SHAMapAccountStateLeafNode.h>
 #include <ripple/shamap/SHAMapNodeID.h>
@@ -436,71 +438,59 @@ SHAMap::unshareNode(std::shared_ptr<Node> node, SHAMapNodeID const& nodeID)
     return node;
 }
 
-SHAMapLeafNode*
-SHAMap::belowHelper(
-    std::shared_ptr<SHAMapTreeNode> node,
-    SharedPtrNodeStack& stack,
-    int branch,
-    std::tuple<int, std::function<bool(int)>, std::function<void(int&)>> const&
-        loopParams) const
+void
+SHAMap::walkTowardsKey(uint256 const& id, Cursor& cursor) const
 {
-    auto& [init, cmp, incr] = loopParams;
-    if (node->isLeaf())
-    {
-        auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
-        stack.push({node, {leafDepth, n->peekItem()->key()}});
-        return n.get();
-    }
-    auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
-    if (stack.empty())
-        stack.push({inner, SHAMapNodeID{}});
-    else
-        stack.push({inner, stack.top().second.getChildNodeID(branch)});
-    for (int i = init; cmp(i);)
+    SHAMapTreeNode* node = root_.get();
+    cursor.depth = 0;
+    cursor.leaf = nullptr;
+
+    while (node->isInner())
     {
-        if (!inner->isEmptyBranch(i))
-        {
-            node = descendThrow(inner, i);
-            assert(!stack.empty());
-            if (node->isLeaf())
-            {
-                auto n = std::static_pointer_cast<SHAMapLeafNode>(node);
-                stack.push({n, {leafDepth, n->peekItem()->key()}});
-                return n.get();
-            }
-            inner = std::static_pointer_cast<SHAMapInnerNode>(node);
-            stack.push({inner, stack.top().second.getChildNodeID(branch)});
-            i = init;  // descend and reset loop
-        }
-        else
-            incr(i);  // scan next branch
+        auto const inner = static_cast<SHAMapInnerNode*>(node);
+        cursor.inner[cursor.depth] = inner;
+        auto const branch = selectBranch(cursor.depth, id);
+        ++cursor.depth;
+        if (inner->isEmptyBranch(branch))
+            return;
+        node = descendThrow(inner, branch);
     }
-    return nullptr;
+
+    cursor.leaf = static_cast<SHAMapLeafNode*>(node);
 }
+
 SHAMapLeafNode*
-SHAMap::lastBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
-    SharedPtrNodeStack& stack,
-    int branch) const
+SHAMap::firstBelow(SHAMapTreeNode* node, Cursor& cursor) const
 {
-    auto init = branchFactor - 1;
-    auto cmp = [](int i) { return i >= 0; };
-    auto incr = [](int& i) { --i; };
-
-    return belowHelper(node, stack, branch, {init, cmp, incr});
+    while (node->isInner())
+    {
+        auto const inner = static_cast<SHAMapInnerNode*>(node);
+        auto const branch = inner->nextBranch(0);
+        if (branch == branchFactor)
+            return nullptr;
+        cursor.inner[cursor.depth++] = inner;
+        node = descendThrow(inner, branch);
+    }
+    cursor.leaf = static_cast<SHAMapLeafNode*>(node);
+    return cursor.leaf;
 }
+
 SHAMapLeafNode*
-SHAMap::firstBelow(
-    std::shared_ptr<SHAMapTreeNode> node,
-    SharedPtrNodeStack& stack,
-    int branch) const
+SHAMap::lastBelow(SHAMapTreeNode* node, Cursor& cursor) const
 {
-    auto init = 0;
-    auto cmp = [](int i) { return i <= branchFactor; };
-    auto incr = [](int& i) { ++i; };
-
-    return belowHelper(node, stack, branch, {init, cmp, incr});
+    while (node->isInner())
+    {
+        auto const inner = static_cast<SHAMapInnerNode*>(node);
+        auto const branch = inner->prevBranch(branchFactor - 1);
+        if (branch < 0)
+            return nullptr;
+        cursor.inner[cursor.depth++] = inner;
+        node = descendThrow(inner, branch);
+    }
+    cursor.leaf = static_cast<SHAMapLeafNode*>(node);
+    return cursor.leaf;
 }
+
 static const std::shared_ptr<SHAMapItem const> no_item;
 
 std::shared_ptr<SHAMapItem const> const&
@@ -540,45 +530,34 @@ SHAMap::onlyBelow(SHAMapTreeNode* node) const
 }
 
 SHAMapLeafNode const*
-SHAMap::peekFirstItem(SharedPtrNodeStack& stack) const
+SHAMap::peekFirstItem(Cursor& cursor) const
 {
-    assert(stack.empty());
-    SHAMapLeafNode* node = firstBelow(root_, stack);
-    if (!node)
-    {
-        while (!stack.empty())
-            stack.pop();
-        return nullptr;
-    }
-    return node;
+    cursor.depth = 0;
+    cursor.leaf = nullptr;
+    return firstBelow(root_.get(), cursor);
 }
 
 SHAMapLeafNode const*
-SHAMap::peekNextItem(uint256 const& id, SharedPtrNodeStack& stack) const
+SHAMap::peekNextItem(Cursor& cursor) const
 {
-    assert(!stack.empty());
-    assert(stack.top().first->isLeaf());
-    stack.pop();
-    while (!stack.empty())
+    assert(cursor.leaf != nullptr);
+    auto const& id = cursor.leaf->peekItem()->key();
+    while (cursor.depth != 0)
     {
-        auto [node, nodeID] = stack.top();
-        assert(!node->isLeaf());
-        auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
-        for (auto i = selectBranch(nodeID, id) + 1; i < branchFactor; ++i)
+        auto const inner = cursor.inner[cursor.depth - 1];
+        auto const branch =
+            inner->nextBranch(selectBranch(cursor.depth - 1, id) + 1);
+        if (branch != branchFactor)
         {
-            if (!inner->isEmptyBranch(i))
-            {
-                node = descendThrow(inner, i);
-                auto leaf = firstBelow(node, stack, i);
-                if (!leaf)
-                    Throw<SHAMapMissingNode>(type_, id);
-                assert(leaf->isLeaf());
-                return leaf;
-            }
+            auto const leaf = firstBelow(descendThrow(inner, branch), cursor);
+            if (!leaf)
+                Throw<SHAMapMissingNode>(type_, id);
+            return leaf;
         }
-        stack.pop();
+        --cursor.depth;
     }
     // must be last item
+    cursor.leaf = nullptr;
     return nullptr;
 }
 
@@ -608,73 +587,45 @@ SHAMap::peekItem(uint256 const& id, SHAMapHash& hash) const
 SHAMap::const_iterator
 SHAMap::upper_bound(uint256 const& id) const
 {
-    SharedPtrNodeStack stack;
-    walkTowardsKey(id, &stack);
-    while (!stack.empty())
+    Cursor cursor;
+    walkTowardsKey(id, cursor);
+    if (cursor.leaf && cursor.leaf->peekItem()->key() > id)
+        return const_iterator(this, cursor);
+    while (cursor.depth != 0)
     {
-        auto [node, nodeID] = stack.top();
-        if (node->isLeaf())
-        {
-            auto leaf = static_cast<SHAMapLeafNode*>(node.get());
-            if (leaf->peekItem()->key() > id)
-                return const_iterator(
-                    this, leaf->peekItem().get(), std::move(stack));
-        }
-        else
+        auto const inner = cursor.inner[cursor.depth - 1];
+        auto const branch =
+            inner->nextBranch(selectBranch(cursor.depth - 1, id) + 1);
+        if (branch != branchFactor)
         {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
-            for (auto branch = selectBranch(nodeID, id) + 1;
-                 branch < branchFactor;
-                 ++branch)
-            {
-                if (!inner->isEmptyBranch(branch))
-                {
-                    node = descendThrow(inner, branch);
-                    auto leaf = firstBelow(node, stack, branch);
-                    if (!leaf)
-                        Throw<SHAMapMissingNode>(type_, id);
-                    return const_iterator(
-                        this, leaf->peekItem().get(), std::move(stack));
-                }
-            }
+            if (!firstBelow(descendThrow(inner, branch), cursor))
+                Throw<SHAMapMissingNode>(type_, id);
+            return const_iterator(this, cursor);
         }
-        stack.pop();
+        --cursor.depth;
     }
     return end();
 }
+
 SHAMap::const_iterator
 SHAMap::lower_bound(uint256 const& id) const
 {
-    SharedPtrNodeStack stack;
-    walkTowardsKey(id, &stack);
-    while (!stack.empty())
+    Cursor cursor;
+    walkTowardsKey(id, cursor);
+    if (cursor.leaf && cursor.leaf->peekItem()->key() < id)
+        return const_iterator(this, cursor);
+    while (cursor.depth != 0)
     {
-        auto [node, nodeID] = stack.top();
-        if (node->isLeaf())
+        auto const inner = cursor.inner[cursor.depth - 1];
+        auto const branch = inner->prevBranch(
+            static_cast<int>(selectBranch(cursor.depth - 1, id)) - 1);
+        if (branch >= 0)
         {
-            auto leaf = static_cast<SHAMapLeafNode*>(node.get());
-            if (leaf->peekItem()->key() < id)
-                return const_iterator(
-                    this, leaf->peekItem().get(), std::move(stack));
-        }
-        else
-        {
-            auto inner = std::static_pointer_cast<SHAMapInnerNode>(node);
-            for (int branch = selectBranch(nodeID, id) - 1; branch >= 0;
-                 --branch)
-            {
-                if (!inner->isEmptyBranch(branch))
-                {
-                    node = descendThrow(inner, branch);
-                    auto leaf = lastBelow(node, stack, branch);
-                    if (!leaf)
-                        Throw<SHAMapMissingNode>(type_, id);
-                    return const_iterator(
-                        this, leaf->peekItem().get(), std::move(stack));
-                }
-            }
+            if (!lastBelow(descendThrow(inner, branch), cursor))
+                Throw<SHAMapMissingNode>(type_, id);
+            return const_iterator(this, cursor);
         }
-        stack.pop();
+        --cursor.depth;
     }
     // TODO: what to return here?
     return end();
@@ -938,7 +889,10 @@ SHAMap::fetchRoot(SHAMapHash const& hash, SHAMapSyncFilter* filter)
           first call SHAMapTreeNode::unshare().
  */
 std::shared_ptr<SHAMapTreeNode>
-SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
+SHAMap::writeNode(
+    NodeObjectType t,
+    std::shared_ptr<SHAMapTreeNode> node,
+    NodeStore::Batch& batch) const
 {
     assert(node->cowid() == 0);
     assert(backed_);
@@ -947,11 +901,23 @@ SHAMap::writeNode(NodeObjectType t, std::shared_ptr<SHAMapTreeNode> node) const
 
     Serializer s;
     node->serializeWithPrefix(s);
-    f_.db().store(
-        t, std::move(s.modData()), node->getHash().as_uint256(), ledgerSeq_);
+    batch.push_back(NodeObject::createObject(
+        t, std::move(s.modData()), node->getHash().as_uint256()));
+    writeBatch(batch, false);
     return node;
 }
 
+void
+SHAMap::writeBatch(NodeStore::Batch& batch, bool force) const
+{
+    if (batch.empty() ||
+        (!force && batch.size() < NodeStore::batchWritePreallocationSize))
+        return;
+
+    f_.db().storeBatch(batch, ledgerSeq_);
+    batch.clear();
+}
+
 // We can't modify an inner node someone else might have a
 // pointer to because flushing modifies inner nodes -- it
 // makes them point to canonical/shared nodes.
@@ -991,22 +957,11 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
 {
     assert(!doWrite || backed_);
 
-    int flushed = 0;
-
     if (!root_ || (root_->cowid() == 0))
-        return flushed;
+        return 0;
 
     if (root_->isLeaf())
-    {  // special case -- root_ is leaf
-        root_ = preFlushNode(std::move(root_));
-        root_->updateHash();
-        root_->unshare();
-
-        if (doWrite)
-            root_ = writeNode(t, std::move(root_));
-
-        return 1;
-    }
+        return walkSubTree(root_, doWrite, t);
 
     auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
 
@@ -1016,12 +971,136 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         return 1;
     }
 
+    node = preFlushNode(std::move(node));
+
+    // The subtrees below the root are independent of one another, so
+    // when enough of the map has changed they are flushed in parallel
+    // and then joined here.
+    std::array<std::shared_ptr<SHAMapTreeNode>, branchFactor> children;
+    std::array<int, branchFactor> counts{};
+    std::vector<int> dirty;
+    int work = 0;
+
+    for (int branch = node->nextBranch(0); branch != branchFactor;
+         branch = node->nextBranch(branch + 1))
+    {
+        // No need to do I/O. If the node isn't linked,
+        // it can't need to be flushed
+        auto child = node->getChild(branch);
+        if (!child || (child->cowid() == 0))
+            continue;
+
+        ++work;
+        if (child->isInner())
+        {
+            auto const inner = static_cast<SHAMapInnerNode*>(child.get());
+            for (int i = inner->nextBranch(0); i != branchFactor;
+                 i = inner->nextBranch(i + 1))
+            {
+                auto const grandchild = inner->getChildPointer(i);
+                if (grandchild && (grandchild->cowid() != 0))
+                    ++work;
+            }
+        }
+
+        children[branch] = std::move(child);
+        dirty.push_back(branch);
+    }
+
+    auto flush = [&](std::size_t i) {
+        auto const branch = dirty[i];
+        counts[branch] = walkSubTree(children[branch], doWrite, t);
+    };
+
+    if (dirty.size() > 1 && work >= parallelFlushThreshold)
+    {
+        WorkerPool::instance().forEach(dirty.size(), dirty.size() - 1, flush);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < dirty.size(); ++i)
+            flush(i);
+    }
+
+    int flushed = 0;
+
+    for (auto const branch : dirty)
+    {
+        // Hook the flushed subtree to the root
+        assert(node->cowid() == cowid_);
+        node->shareChild(branch, children[branch]);
+        flushed += counts[branch];
+    }
+
+    node->updateHashDeep();
+    node->unshare();
+
+    if (doWrite)
+    {
+        NodeStore::Batch batch;
+        node = std::static_pointer_cast<SHAMapInnerNode>(
+            writeNode(t, std::move(node), batch));
+        writeBatch(batch, true);
+    }
+
+    root_ = std::move(node);
+
+    return flushed + 1;
+}
+
+int
+SHAMap::walkSubTree(
+    std::shared_ptr<SHAMapTreeNode>& subtree,
+    bool doWrite,
+    NodeObjectType t)
+{
+    assert(subtree && (subtree->cowid() != 0));
+
+    int flushed = 0;
+
+    // Written nodes are collected and handed to the database in groups
+    NodeStore::Batch batch;
+
+    // The nodes collected so far are already canonical, so they must reach
+    // the database even if the walk is cut short
+    scope_fail flushBatch([this, &batch]() noexcept {
+        try
+        {
+            writeBatch(batch, true);
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(journal_.error())
+                << "walkSubTree: unable to store " << batch.size()
+                << " nodes: " << e.what();
+        }
+    });
+
+    if (subtree->isLeaf())
+    {
+        subtree = preFlushNode(std::move(subtree));
+        subtree->updateHash();
+        subtree->unshare();
+
+        if (doWrite)
+        {
+            subtree = writeNode(t, std::move(subtree), batch);
+            writeBatch(batch, true);
+        }
+
+        return 1;
+    }
+
+    if (doWrite)
+        batch.reserve(NodeStore::batchWritePreallocationSize);
+
     // Stack of {parent,index,child} pointers representing
     // inner nodes we are in the process of flushing
     using StackEntry = std::pair<std::shared_ptr<SHAMapInnerNode>, int>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
-    node = preFlushNode(std::move(node));
+    auto node = preFlushNode(
+        std::static_pointer_cast<SHAMapInnerNode>(std::move(subtree)));
 
     int pos = 0;
 
@@ -1069,7 +1148,7 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
                         child->unshare();
 
                         if (doWrite)
-                            child = writeNode(t, std::move(child));
+                            child = writeNode(t, std::move(child), batch);
 
                         node->shareChild(branch, child);
                     }
@@ -1085,7 +1164,7 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
 
         if (doWrite)
             node = std::static_pointer_cast<SHAMapInnerNode>(
-                writeNode(t, std::move(node)));
+                writeNode(t, std::move(node), batch));
 
         ++flushed;
 
@@ -1105,8 +1184,10 @@ SHAMap::walkSubTree(bool doWrite, NodeObjectType t)
         ++pos;
     }
 
-    // Last inner node is the new root_
-    root_ = std::move(node);
+    writeBatch(batch, true);
+
+    // Last inner node is the root of the flushed subtree
+    subtree = std::move(node);
 
     return flushed;
 }
@@ -1182,9 +1263,9 @@ SHAMap::invariants() const
     auto node = root_.get();
     assert(node != nullptr);
     assert(!node->isLeaf());
-    SharedPtrNodeStack stack;
-    for (auto leaf = peekFirstItem(stack); leaf != nullptr;
-         leaf = peekNextItem(leaf->peekItem()->key(), stack))
+    Cursor cursor;
+    for (auto leaf = peekFirstItem(cursor); leaf != nullptr;
+         leaf = peekNextItem(cursor))
         ;
     node->invariants(true);
 }
@@ -120,7 +120,12 @@ deserializeSHAMapNodeID(void const* data, std::size_t size)
 [[nodiscard]] unsigned int
 selectBranch(SHAMapNodeID const& id, uint256 const& hash)
 {
-    auto const depth = id.getDepth();
+    return selectBranch(id.getDepth(), hash);
+}
+
+[[nodiscard]] unsigned int
+selectBranch(unsigned int depth, uint256 const& hash)
+{
     auto branch = static_cast<unsigned int>(*(hash.begin() + (depth / 2)));
 
     if (depth & 1)
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/AcceptedLedger.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <chrono>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class AcceptedLedger_test : public beast::unit_test::suite
+{
+protected:
+    // Allow an arbitrary number of transactions into a single ledger
+    static std::unique_ptr<Config>
+    makeConfig(std::unique_ptr<Config> cfg)
+    {
+        auto& s = cfg->section("transaction_queue");
+        s.set("minimum_txn_in_ledger_standalone", "4294967295");
+        s.set("target_txn_in_ledger", "4294967295");
+        return cfg;
+    }
+
+    void
+    testLazyJson()
+    {
+        testcase("Lazy JSON");
+        using namespace jtx;
+
+        Env env{*this};
+        Account const gw{"gateway"};
+        Account const alice{"alice"};
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice);
+        env.close();
+        env.trust(USD(1000), alice);
+        env(pay(gw, alice, USD(100)));
+        env.close();
+
+        // An offer that is not self funded reports the owner's funds
+        env(offer(alice, XRP(10), USD(10)));
+        env.close();
+
+        AcceptedLedger const al{env.closed(), env.app()};
+        BEAST_EXPECT(al.size() == 1);
+
+        for (auto const& tx : al)
+        {
+            auto const& jv = tx->getJson();
+
+            // The JSON is built once and then cached
+            BEAST_EXPECT(&jv == &tx->getJson());
+
+            BEAST_EXPECT(jv.isMember(jss::transaction));
+            BEAST_EXPECT(jv.isMember(jss::meta));
+            BEAST_EXPECT(jv[jss::result] == "tesSUCCESS");
+            BEAST_EXPECT(
+                jv[jss::transaction][jss::hash] ==
+                to_string(tx->getTransactionID()));
+            BEAST_EXPECT(
+                jv[jss::transaction][jss::owner_funds] ==
+                env.balance(alice, USD).value().getText());
+
+            Serializer s;
+            tx->getMeta().getAsObject().add(s);
+            BEAST_EXPECT(jv[jss::raw_meta] == strHex(s.peekData()));
+
+            auto const& affected = tx->getAffected();
+            BEAST_EXPECT(jv[jss::affected].size() == affected.size());
+            BEAST_EXPECT(
+                jv[jss::affected][0u] ==
+                env.app().accountIDCache().toBase58(*affected.begin()));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testLazyJson();
+    }
+};
+
+// Measures the cost of building an AcceptedLedger for a large ledger, both
+// on its own and when every transaction is also rendered as JSON.
+class AcceptedLedger_manual_test : public AcceptedLedger_test
+{
+    void
+    testConstruction(std::size_t const txCount)
+    {
+        testcase << "Construction " << txCount << " transactions";
+        using namespace jtx;
+        using clock_type = std::chrono::steady_clock;
+        using namespace std::chrono;
+
+        Env env{*this, envconfig(makeConfig)};
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 20; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+        for (auto const& a : accounts)
+            env.fund(XRP(100000), a);
+        env.close();
+
+        for (std::size_t i = 0; i < txCount; ++i)
+            env(pay(
+                accounts[i % accounts.size()],
+                accounts[(i + 1) % accounts.size()],
+                drops(1000 + i)));
+        env.close();
+
+        auto const ledger = env.closed();
+        int const rounds = 10;
+
+        auto start = clock_type::now();
+        for (int i = 0; i < rounds; ++i)
+        {
+            AcceptedLedger const al{ledger, env.app()};
+            BEAST_EXPECT(al.size() == txCount);
+        }
+        auto const lazy = clock_type::now() - start;
+
+        start = clock_type::now();
+        for (int i = 0; i < rounds; ++i)
+        {
+            AcceptedLedger const al{ledger, env.app()};
+            for (auto const& tx : al)
+                BEAST_EXPECT(!tx->getJson().isNull());
+        }
+        auto const rendered = clock_type::now() - start;
+
+        log << "    construction: "
+            << duration_cast<microseconds>(lazy).count() / rounds << "us"
+            << ", with JSON: "
+            << duration_cast<microseconds>(rendered).count() / rounds << "us"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        testConstruction(100);
+        testConstruction(1000);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AcceptedLedger, app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(AcceptedLedger_manual, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
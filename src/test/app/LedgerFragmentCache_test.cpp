@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerFragmentCache.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/digest.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerFragmentCache_test : public beast::unit_test::suite
+{
+    static std::shared_ptr<std::string const>
+    makeFragment(std::size_t size, char c = 'x')
+    {
+        return std::make_shared<std::string const>(size, c);
+    }
+
+    void
+    testKeys()
+    {
+        testcase("Keys");
+
+        SHAMapHash const map{sha512Half(std::string("map"))};
+        SHAMapHash const other{sha512Half(std::string("other"))};
+        SHAMapNodeID const root;
+        auto const child = root.getChildNodeID(3);
+
+        auto const key = LedgerFragmentCache::nodeKey(map, root, 1, true);
+        BEAST_EXPECT(key == LedgerFragmentCache::nodeKey(map, root, 1, true));
+        BEAST_EXPECT(key != LedgerFragmentCache::nodeKey(other, root, 1, true));
+        BEAST_EXPECT(key != LedgerFragmentCache::nodeKey(map, child, 1, true));
+        BEAST_EXPECT(key != LedgerFragmentCache::nodeKey(map, root, 2, true));
+        BEAST_EXPECT(key != LedgerFragmentCache::nodeKey(map, root, 1, false));
+        BEAST_EXPECT(
+            LedgerFragmentCache::fetchPackKey(map.as_uint256()) !=
+            LedgerFragmentCache::fetchPackKey(other.as_uint256()));
+    }
+
+    void
+    testFetch()
+    {
+        testcase("Fetch");
+
+        LedgerFragmentCache cache(4000);
+        auto const k1 = LedgerFragmentCache::fetchPackKey(uint256{1});
+        auto const k2 = LedgerFragmentCache::fetchPackKey(uint256{2});
+
+        BEAST_EXPECT(!cache.fetch(k1));
+        cache.insert(k1, makeFragment(100, 'a'));
+        auto const f = cache.fetch(k1);
+        BEAST_EXPECT(f && *f == std::string(100, 'a'));
+        BEAST_EXPECT(!cache.fetch(k2));
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.bytes() == 100);
+
+        // A fragment already present is kept
+        cache.insert(k1, makeFragment(200, 'b'));
+        BEAST_EXPECT(*cache.fetch(k1) == std::string(100, 'a'));
+        BEAST_EXPECT(cache.bytes() == 100);
+
+        // Fragments larger than a quarter of the budget are not stored
+        cache.insert(k2, makeFragment(1001));
+        BEAST_EXPECT(!cache.fetch(k2));
+
+        // Two hits out of five lookups
+        BEAST_EXPECT(cache.getHitRate() == 40.0);
+    }
+
+    void
+    testEviction()
+    {
+        testcase("Eviction");
+
+        LedgerFragmentCache cache(4000);
+        auto key = [](int i) {
+            return LedgerFragmentCache::fetchPackKey(uint256{i});
+        };
+
+        for (int i = 0; i < 4; ++i)
+            cache.insert(key(i), makeFragment(1000));
+        BEAST_EXPECT(cache.size() == 4);
+
+        // Using the oldest fragment protects it from eviction
+        BEAST_EXPECT(cache.fetch(key(0)));
+        cache.insert(key(4), makeFragment(1000));
+        BEAST_EXPECT(cache.size() == 4);
+        BEAST_EXPECT(cache.bytes() == 4000);
+        BEAST_EXPECT(cache.fetch(key(0)));
+        BEAST_EXPECT(!cache.fetch(key(1)));
+        BEAST_EXPECT(cache.fetch(key(4)));
+    }
+
+public:
+    void
+    run() override
+    {
+        testKeys();
+        testFetch();
+        testEviction();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerFragmentCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <boost/filesystem/fstream.hpp>
+
+namespace ripple {
+namespace test {
+
+class LedgerHashIndex_test : public beast::unit_test::suite
+{
+    beast::Journal const j_{beast::Journal::getNullSink()};
+
+    void
+    testDisabled()
+    {
+        testcase("Disabled");
+
+        LedgerHashIndex index{{}, std::nullopt, j_};
+        BEAST_EXPECT(!index.enabled());
+
+        BEAST_EXPECT(index.confirm({}));
+        index.insert(5, LedgerHash{5});
+        BEAST_EXPECT(!index.get(5));
+    }
+
+    void
+    testInsert()
+    {
+        testcase("Insert and erase");
+
+        beast::temp_dir dir;
+        LedgerHashIndex index{dir.file("hashes"), std::nullopt, j_};
+        BEAST_EXPECT(index.enabled());
+        BEAST_EXPECT(index.confirm({}));
+
+        // Sequence zero is never a ledger
+        index.insert(0, LedgerHash{1});
+        BEAST_EXPECT(!index.get(0));
+
+        index.insert(1, LedgerHash{1});
+        index.insert(2, LedgerHash{2});
+        BEAST_EXPECT(index.get(1) == LedgerHash{1});
+        BEAST_EXPECT(index.get(2) == LedgerHash{2});
+        BEAST_EXPECT(!index.get(3));
+
+        // Replace and erase
+        index.insert(2, LedgerHash{22});
+        BEAST_EXPECT(index.get(2) == LedgerHash{22});
+        index.erase(1);
+        BEAST_EXPECT(!index.get(1));
+
+        // Far beyond the end of the file
+        index.insert(10000000, LedgerHash{3});
+        BEAST_EXPECT(index.get(10000000) == LedgerHash{3});
+        BEAST_EXPECT(!index.get(9999999));
+        BEAST_EXPECT(!index.get(10000001));
+        BEAST_EXPECT(index.get(2) == LedgerHash{22});
+    }
+
+    void
+    testBase()
+    {
+        testcase("Base sequence");
+
+        beast::temp_dir dir;
+        auto const file = dir.file("hashes");
+
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.confirm({}));
+
+            // The file starts at the first ledger inserted, not at one
+            index.insert(10000000, LedgerHash{1});
+            index.insert(10000001, LedgerHash{2});
+            BEAST_EXPECT(index.get(10000000) == LedgerHash{1});
+            BEAST_EXPECT(index.get(10000001) == LedgerHash{2});
+            BEAST_EXPECT(boost::filesystem::file_size(file) < 4 << 20);
+
+            // Older ledgers move the base down and keep the newer ones
+            index.insert(9999000, LedgerHash{3});
+            index.insert(9000000, LedgerHash{4});
+            BEAST_EXPECT(index.get(9000000) == LedgerHash{4});
+            BEAST_EXPECT(index.get(9999000) == LedgerHash{3});
+            BEAST_EXPECT(index.get(10000000) == LedgerHash{1});
+            BEAST_EXPECT(index.get(10000001) == LedgerHash{2});
+            BEAST_EXPECT(!index.get(8999999));
+            BEAST_EXPECT(!index.get(9999001));
+            BEAST_EXPECT(boost::filesystem::file_size(file) < 64 << 20);
+        }
+
+        // The base is kept in the file
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.confirm({}));
+            BEAST_EXPECT(index.get(9000000) == LedgerHash{4});
+            BEAST_EXPECT(index.get(9999000) == LedgerHash{3});
+            BEAST_EXPECT(index.get(10000000) == LedgerHash{1});
+            BEAST_EXPECT(index.get(10000001) == LedgerHash{2});
+        }
+    }
+
+    void
+    testReopen()
+    {
+        testcase("Reopen");
+
+        beast::temp_dir dir;
+        auto const file = dir.file("hashes");
+
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.confirm({}));
+            index.insert(7, LedgerHash{7});
+            index.insert(300000, LedgerHash{8});
+        }
+
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+
+            // Nothing is found until the contents are confirmed
+            BEAST_EXPECT(!index.get(7));
+            BEAST_EXPECT(index.confirm({{7, LedgerHash{7}}}));
+            BEAST_EXPECT(index.get(7) == LedgerHash{7});
+            BEAST_EXPECT(index.get(300000) == LedgerHash{8});
+        }
+
+        // A file that isn't an index is replaced
+        {
+            boost::filesystem::ofstream os{file, std::ios::trunc};
+            os << std::string(1024, 'x');
+        }
+
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.enabled());
+            BEAST_EXPECT(index.confirm({}));
+            BEAST_EXPECT(!index.get(7));
+            BEAST_EXPECT(!index.get(300000));
+
+            index.insert(7, LedgerHash{9});
+            BEAST_EXPECT(index.get(7) == LedgerHash{9});
+        }
+    }
+
+    void
+    testNetwork()
+    {
+        testcase("Network");
+
+        beast::temp_dir dir;
+        auto const file = dir.file("hashes");
+
+        {
+            LedgerHashIndex index{file, 1, j_};
+            BEAST_EXPECT(index.confirm({}));
+            index.insert(7, LedgerHash{7});
+        }
+
+        {
+            LedgerHashIndex index{file, 1, j_};
+            BEAST_EXPECT(index.confirm({}));
+            BEAST_EXPECT(index.get(7) == LedgerHash{7});
+        }
+
+        // An index of another network is discarded
+        {
+            LedgerHashIndex index{file, 2, j_};
+            BEAST_EXPECT(index.confirm({}));
+            BEAST_EXPECT(!index.get(7));
+            index.insert(7, LedgerHash{8});
+        }
+
+        // So is one of an unknown network
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.confirm({}));
+            BEAST_EXPECT(!index.get(7));
+        }
+    }
+
+    void
+    testConfirm()
+    {
+        testcase("Confirm");
+
+        beast::temp_dir dir;
+        auto const file = dir.file("hashes");
+
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(index.confirm({}));
+            index.insert(5, LedgerHash{5});
+            index.insert(6, LedgerHash{6});
+        }
+
+        // Missing hashes are filled in
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(
+                index.confirm({{5, LedgerHash{5}}, {4, LedgerHash{4}}}));
+            BEAST_EXPECT(index.get(4) == LedgerHash{4});
+            BEAST_EXPECT(index.get(5) == LedgerHash{5});
+            BEAST_EXPECT(index.get(6) == LedgerHash{6});
+        }
+
+        // Any disagreement discards the whole index
+        {
+            LedgerHashIndex index{file, std::nullopt, j_};
+            BEAST_EXPECT(
+                !index.confirm({{5, LedgerHash{55}}, {4, LedgerHash{4}}}));
+            BEAST_EXPECT(index.get(4) == LedgerHash{4});
+            BEAST_EXPECT(index.get(5) == LedgerHash{55});
+            BEAST_EXPECT(!index.get(6));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testDisabled();
+        testInsert();
+        testBase();
+        testReopen();
+        testNetwork();
+        testConfirm();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerHashIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
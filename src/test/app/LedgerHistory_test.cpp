@@ -193,10 +193,54 @@ public:
         }
     }
 
+    void
+    testHeaderCache()
+    {
+        testcase("LedgerHistory header cache");
+        using namespace jtx;
+        using namespace std::chrono;
+
+        Env env{*this};
+        LedgerHistory lh{beast::insight::NullCollector::New(), env.app()};
+
+        // A chain of validated ledgers which are not in the database
+        std::vector<std::pair<LedgerIndex, LedgerHash>> chain;
+        {
+            auto ledger = makeLedger({}, env, lh, 0s);
+            for (int i = 0; i < 8; ++i)
+            {
+                ledger = makeLedger(ledger, env, lh, 10s);
+                lh.insert(ledger, true);
+                chain.emplace_back(ledger->info().seq, ledger->info().hash);
+            }
+        }
+
+        // Drop the ledgers themselves, keeping only what was remembered
+        lh.clearLedgerCachePrior(chain.back().first + 1);
+
+        for (auto const& [seq, hash] : chain)
+        {
+            auto const bySeq = lh.getLedgerBySeq(seq);
+            BEAST_EXPECT(bySeq && bySeq->info().hash == hash);
+            BEAST_EXPECT(bySeq && bySeq->isImmutable());
+
+            auto const byHash = lh.getLedgerByHash(hash);
+            BEAST_EXPECT(byHash && byHash->info().seq == seq);
+        }
+
+        // Repairing the index forgets the header of the replaced ledger
+        auto const [seq, hash] = chain.front();
+        BEAST_EXPECT(!lh.fixIndex(seq, uint256{1}));
+        BEAST_EXPECT(lh.getLedgerHash(seq) == uint256{1});
+        lh.clearLedgerCachePrior(chain.back().first + 1);
+        BEAST_EXPECT(!lh.getLedgerByHash(hash));
+    }
+
     void
     run() override
     {
         testHandleMismatch();
+        testHeaderCache();
     }
 };
 
@@ -22,6 +22,7 @@
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
 #include <test/jtx.h>
+#include <test/jtx/benchmark.h>
 
 #include <initializer_list>
 
@@ -4285,6 +4286,72 @@ public:
     }
 };
 
+// Measures how quickly tokens are minted into, and transferred out of, an
+// account that already holds many tokens.
+class NFToken_manual_test : public beast::unit_test::suite
+{
+    void
+    testThroughput(std::size_t const tokenCount)
+    {
+        testcase << "Throughput " << tokenCount << " tokens";
+        using namespace test::jtx;
+
+        Env env{*this};
+        Account const minter{"minter"};
+        Account const buyer{"buyer"};
+        env.fund(XRP(1000000), minter, buyer);
+        env.close();
+
+        // Random taxons spread the tokens over all of the minter's pages.
+        std::vector<uint256> nftIDs;
+        nftIDs.reserve(tokenCount);
+        benchmark(*this, "mint", tokenCount, [&]() {
+            for (std::size_t i = 0; i < tokenCount; ++i)
+            {
+                auto const taxon = rand_int<std::uint32_t>();
+                nftIDs.push_back(
+                    token::getNextID(env, minter, taxon, tfTransferable));
+                env(token::mint(minter, taxon), txflags(tfTransferable));
+                if (i % 256 == 255)
+                    env.close();
+            }
+            env.close();
+        });
+
+        // Each transfer is an offer and its acceptance.
+        std::size_t const transfers = tokenCount / 10;
+        benchmark(*this, "transfer", transfers, [&]() {
+            for (std::size_t i = 0; i < transfers; ++i)
+            {
+                uint256 const offerID =
+                    keylet::nftoffer(minter, env.seq(minter)).key;
+                env(token::createOffer(minter, nftIDs[i], XRP(0)),
+                    token::destination(buyer),
+                    txflags(tfSellNFToken));
+                env(token::acceptSellOffer(buyer, offerID));
+                if (i % 128 == 127)
+                    env.close();
+            }
+            env.close();
+        });
+
+        for (std::size_t i = 0; i < tokenCount; ++i)
+        {
+            auto const owner = i < transfers ? buyer : minter;
+            BEAST_EXPECT(nft::findToken(*env.closed(), owner, nftIDs[i]));
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testThroughput(1000);
+        testThroughput(10000);
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(NFToken, tx, ripple, 2);
+BEAST_DEFINE_TESTSUITE_MANUAL(NFToken_manual, tx, ripple);
 
 }  // namespace ripple
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/tx/apply.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+#include <atomic>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class OpenLedger_test : public beast::unit_test::suite
+{
+    void
+    testSubmitDuringAccept()
+    {
+        testcase("Submit during accept");
+
+        using namespace jtx;
+        Env env(*this);
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 200; ++i)
+            accounts.emplace_back("account" + std::to_string(i));
+        for (auto const& account : accounts)
+            env.fund(XRP(1000), account);
+        env.close();
+
+        // Half of the accounts fill the open view that accept rebuilds,
+        // the other half submit while the rebuild is under way
+        std::vector<std::shared_ptr<STTx const>> txs;
+        for (auto const& account : accounts)
+            txs.push_back(env.jt(noop(account)).stx);
+
+        auto submit = [&](std::shared_ptr<STTx const> const& tx) {
+            env.app().openLedger().modify(
+                [&](OpenView& view, beast::Journal j) {
+                    return ripple::apply(env.app(), view, *tx, tapNONE, j)
+                        .second;
+                });
+        };
+
+        auto const half = txs.size() / 2;
+        for (std::size_t i = 0; i < half; ++i)
+            submit(txs[i]);
+        BEAST_EXPECT(env.current()->txCount() == half);
+
+        std::atomic<bool> done = false;
+        std::thread submitter([&] {
+            for (std::size_t i = half; i < txs.size(); ++i)
+            {
+                submit(txs[i]);
+                std::this_thread::yield();
+            }
+            done = true;
+        });
+
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        int accepts = 0;
+        do
+        {
+            OrderedTxs retries({});
+            env.app().openLedger().accept(
+                env.app(),
+                env.current()->rules(),
+                closed,
+                OrderedTxs({}),
+                false,
+                retries,
+                tapNONE,
+                "test");
+            BEAST_EXPECT(retries.empty());
+            ++accepts;
+        } while (!done);
+        submitter.join();
+        BEAST_EXPECT(accepts > 0);
+
+        // No transaction was lost by the rebuilds
+        auto const view = env.app().openLedger().current();
+        BEAST_EXPECT(view->info().parentHash == closed->info().hash);
+        BEAST_EXPECT(view->txCount() == txs.size());
+        for (auto const& tx : txs)
+            BEAST_EXPECT(view->txExists(tx->getTransactionID()));
+
+        env.close();
+        for (auto const& tx : txs)
+            BEAST_EXPECT(env.closed()->txExists(tx->getTransactionID()));
+    }
+
+    void
+    testInterleavedAccepts()
+    {
+        testcase("Interleaved accepts");
+
+        using namespace jtx;
+        Env env(*this);
+        Account const alice{"alice"};
+        env.fund(XRP(1000), alice);
+        env.close();
+        auto const older = env.app().getLedgerMaster().getClosedLedger();
+        env.close();
+        auto const newer = env.app().getLedgerMaster().getClosedLedger();
+        env(noop(alice));
+
+        auto& openLedger = env.app().openLedger();
+        auto accept = [&](std::shared_ptr<Ledger const> const& ledger,
+                          char const* suffix) {
+            OrderedTxs retries({});
+            openLedger.accept(
+                env.app(),
+                env.current()->rules(),
+                ledger,
+                OrderedTxs({}),
+                false,
+                retries,
+                tapNONE,
+                suffix);
+        };
+        auto acceptsStarted = [&]() {
+            std::lock_guard lock(openLedger.modify_mutex_);
+            return openLedger.acceptsStarted_;
+        };
+
+        // A rebuild on the older ledger takes its snapshot, then waits to
+        // publish while an accept on the newer ledger runs to completion
+        {
+            std::unique_lock masterLock(env.app().getMasterMutex());
+            auto const started = acceptsStarted();
+            std::thread rebuild([&] { accept(older, "older"); });
+            while (acceptsStarted() == started)
+                std::this_thread::yield();
+            accept(newer, "newer");
+            masterLock.unlock();
+            rebuild.join();
+        }
+
+        // The older rebuild did not replace the newer view
+        auto const view = openLedger.current();
+        BEAST_EXPECT(view->info().parentHash == newer->info().hash);
+        BEAST_EXPECT(view->txCount() == 1);
+
+        // An accept that starts later wins, whatever its ledger
+        accept(older, "jump");
+        BEAST_EXPECT(
+            openLedger.current()->info().parentHash == older->info().hash);
+    }
+
+public:
+    void
+    run() override
+    {
+        testSubmitDuringAccept();
+        testInterleavedAccepts();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OpenLedger, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/BuildLedger.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerReplay.h>
+#include <ripple/app/misc/CanonicalTXSet.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class ParallelApply_test : public beast::unit_test::suite
+{
+    static std::size_t
+    txCount(ReadView const& view)
+    {
+        return std::distance(view.txs.begin(), view.txs.end());
+    }
+
+    // Allow an arbitrary number of transactions into a single ledger
+    static std::unique_ptr<Config>
+    makeConfig(std::unique_ptr<Config> cfg, int workers)
+    {
+        auto& s = cfg->section("transaction_queue");
+        s.set("minimum_txn_in_ledger_standalone", "4294967295");
+        s.set("target_txn_in_ledger", "4294967295");
+        cfg->APPLY_WORKERS = workers;
+        return cfg;
+    }
+
+    // Submit a mix of transactions that are partly independent and partly
+    // touch the same ledger entries, then close the ledger.
+    void
+    populate(jtx::Env& env)
+    {
+        using namespace jtx;
+
+        Account const gw{"gateway"};
+        Account const hub{"hub"};
+        auto const USD = gw["USD"];
+
+        std::vector<Account> accounts;
+        for (int i = 0; i < 24; ++i)
+            accounts.emplace_back("a" + std::to_string(i));
+
+        env.fund(XRP(100000), gw, hub);
+        for (auto const& a : accounts)
+            env.fund(XRP(100000), a);
+        env.close();
+
+        for (auto const& a : accounts)
+            env.trust(USD(100000), a);
+        env.close();
+
+        for (auto const& a : accounts)
+            env(pay(gw, a, USD(1000)));
+        env.close();
+
+        auto const n = accounts.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const& a = accounts[i];
+
+            // Disjoint payments
+            env(pay(a, accounts[(i + 1) % n], XRP(10 + i)));
+
+            // Everyone pays the same account
+            env(pay(a, hub, drops(1000 + i)));
+
+            // Payments of an issued currency
+            env(pay(a, accounts[(i + 7) % n], USD(5)));
+
+            // Offers in the same books, some of which cross
+            if (i % 2)
+                env(offer(a, XRP(100 + i), USD(100)));
+            else
+                env(offer(a, USD(100), XRP(90 + i)));
+        }
+
+        // A transaction that claims a fee without succeeding
+        env(pay(accounts[0], Account{"unfunded"}, XRP(1)),
+            ter(tecNO_DST_INSUF_XRP));
+        env.close();
+    }
+
+    void
+    testReplay()
+    {
+        testcase("Parallel close matches serial replay");
+        using namespace jtx;
+
+        Env env{*this, envconfig(makeConfig, 4)};
+        populate(env);
+
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        BEAST_EXPECT(txCount(*closed) > 24 * 4);
+
+        auto const parent = env.app().getLedgerMaster().getLedgerByHash(
+            closed->info().parentHash);
+        BEAST_EXPECT(parent);
+
+        auto const replayed = buildLedger(
+            LedgerReplay(parent, closed), tapNONE, env.app(), env.journal);
+
+        BEAST_EXPECT(replayed->info().hash == closed->info().hash);
+    }
+
+    void
+    testBuild()
+    {
+        testcase("Parallel build matches serial build");
+        using namespace jtx;
+
+        Env env{*this, envconfig(makeConfig, 0)};
+        populate(env);
+
+        auto const closed = env.app().getLedgerMaster().getClosedLedger();
+        auto const parent = env.app().getLedgerMaster().getLedgerByHash(
+            closed->info().parentHash);
+        BEAST_EXPECT(parent);
+
+        auto build = [&](int workers) {
+            env.app().config().APPLY_WORKERS = workers;
+
+            CanonicalTXSet txns{closed->info().hash};
+            for (auto const& item : closed->txs)
+                txns.insert(item.first);
+
+            std::set<TxID> failed;
+            auto const built = buildLedger(
+                parent,
+                closed->info().closeTime,
+                getCloseAgree(closed->info()),
+                closed->info().closeTimeResolution,
+                env.app(),
+                txns,
+                failed,
+                env.journal);
+
+            return std::make_tuple(built, txns.size(), failed);
+        };
+
+        auto const [serial, retries, failed] = build(0);
+        BEAST_EXPECT(txCount(*serial) == txCount(*closed));
+
+        for (int workers : {2, 4, 16})
+        {
+            auto const [parallel, r, f] = build(workers);
+            BEAST_EXPECT(parallel->info().hash == serial->info().hash);
+            BEAST_EXPECT(r == retries);
+            BEAST_EXPECT(f == failed);
+        }
+    }
+
+public:
+    void
+    run() override
+    {
+        testReplay();
+        testBuild();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ParallelApply, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -18,6 +18,9 @@
 //==============================================================================
 
 #include <ripple/app/paths/AccountCurrencies.h>
+#include <ripple/app/paths/Pathfinder.h>
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/app/paths/impl/PathfinderUtils.h>
 #include <ripple/basics/contract.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/JobQueue.h>
@@ -669,6 +672,126 @@ public:
         BEAST_EXPECT(equal(sa, Account("alice")["USD"](5)));
     }
 
+    void
+    path_search_deadline()
+    {
+        testcase("path search deadline");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->PATH_SEARCH_OLD = 7;
+            cfg->PATH_SEARCH = 7;
+            cfg->PATH_SEARCH_MAX = 10;
+            cfg->PATH_SEARCH_TIME = 1h;
+            return cfg;
+        }));
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        auto const gw2 = Account("gateway2");
+        auto const gw2_USD = gw2["USD"];
+        env.fund(XRP(10000), "alice", "bob", "carol", "dan", gw, gw2);
+        env(rate("carol", 1.1));
+        env.trust(Account("carol")["USD"](800), "alice", "bob");
+        env.trust(Account("dan")["USD"](800), "alice", "bob");
+        env.trust(USD(800), "alice", "bob");
+        env.trust(gw2_USD(800), "alice", "bob");
+        env.trust(Account("alice")["USD"](800), "dan");
+        env.trust(Account("bob")["USD"](800), "dan");
+        env(pay(gw2, "alice", gw2_USD(100)));
+        env(pay("carol", "alice", Account("carol")["USD"](100)));
+        env(pay(gw, "alice", USD(100)));
+
+        // A deadline that is not reached finds the same paths
+        STPathSet st;
+        STAmount sa;
+        std::tie(st, sa, std::ignore) =
+            find_paths(env, "alice", "bob", Account("bob")["USD"](5));
+        BEAST_EXPECT(same(
+            st,
+            stpath("gateway"),
+            stpath("gateway2"),
+            stpath("dan"),
+            stpath("carol")));
+        BEAST_EXPECT(equal(sa, Account("alice")["USD"](5)));
+
+        auto makePathfinder = [&]() {
+            return std::make_unique<Pathfinder>(
+                std::make_shared<RippleLineCache>(
+                    env.current(), env.journal),
+                Account("alice").id(),
+                Account("bob").id(),
+                USD.currency,
+                std::nullopt,
+                Account("bob")["USD"](5),
+                std::nullopt,
+                env.app());
+        };
+
+        // Past the deadline, the search stops without failing once the
+        // first path type is searched, which finds every path here
+        auto bestPaths = [&](bool expired) {
+            auto pf = makePathfinder();
+            if (expired)
+                pf->setDeadline(std::chrono::steady_clock::now() - 1s);
+            STPathSet result;
+            if (BEAST_EXPECT(pf->findPaths(7)))
+            {
+                pf->computePathRanks(4);
+                STPath fullLiquidityPath;
+                result = pf->getBestPaths(
+                    4, fullLiquidityPath, {}, Account("alice").id());
+            }
+            return result;
+        };
+        BEAST_EXPECT(bestPaths(false).size() == 4);
+        BEAST_EXPECT(bestPaths(true).size() == 4);
+
+        // The search completes, but ranking runs past its deadline. The
+        // paths with the best quality bound are ranked first, and ranking
+        // stops once more paths than asked for are ranked, which leaves
+        // out carol and her transfer fee.
+        {
+            auto pf = makePathfinder();
+            if (BEAST_EXPECT(pf->findPaths(7)))
+            {
+                pf->setDeadline(std::chrono::steady_clock::now() - 1s);
+                pf->computePathRanks(1);
+                STPath fullLiquidityPath;
+                auto const best = pf->getBestPaths(
+                    4, fullLiquidityPath, {}, Account("alice").id());
+                BEAST_EXPECT(!best.empty() && best.size() <= 2);
+                for (auto const& path : best)
+                    BEAST_EXPECT(!(path == stpath("carol")));
+            }
+        }
+
+        // Paths are ordered by their quality bound, best first. Paths
+        // through an empty order book are dry, and are dropped along with
+        // empty paths.
+        {
+            auto pf = makePathfinder();
+            STPathSet paths;
+            paths.push_back(stpath(IPE(xrpIssue()), IPE(USD.issue())));
+            paths.push_back(stpath("carol"));
+            paths.push_back(stpath("gateway"));
+            paths.push_back(STPath{});
+            BEAST_EXPECT(pf->orderPaths(paths) == std::vector<int>({2, 1}));
+        }
+
+        // The time left is shared evenly by the searches left, so a search
+        // that ends early leaves its time to the next ones
+        {
+            using clock_type = std::chrono::steady_clock;
+            clock_type::time_point const start{};
+            auto const deadline = start + 900ms;
+            BEAST_EXPECT(shareDeadline(deadline, start, 3) == start + 300ms);
+            BEAST_EXPECT(
+                shareDeadline(deadline, start + 100ms, 2) == start + 500ms);
+            BEAST_EXPECT(shareDeadline(deadline, start + 500ms, 1) == deadline);
+            BEAST_EXPECT(shareDeadline(deadline, start + 1s, 1) == start + 1s);
+        }
+    }
+
     void
     issues_path_negative_issue()
     {
@@ -1391,6 +1514,7 @@ public:
         alternative_paths_consume_best_transfer();
         alternative_paths_consume_best_transfer_first();
         alternative_paths_limit_returned_paths_to_best_quality();
+        path_search_deadline();
         issues_path_negative_issue();
         issues_path_negative_ripple_client_issue_23_smaller();
         issues_path_negative_ripple_client_issue_23_larger();
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/rdb/TxIndex.h>
+#include <ripple/app/rdb/backend/RelationalDBInterfaceSqlite.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/jss.h>
+#include <test/jtx.h>
+#include <test/jtx/envconfig.h>
+#include <test/unit_test/SuiteJournal.h>
+
+namespace ripple {
+namespace test {
+
+class TxIndex_test : public beast::unit_test::suite
+{
+    static uint256
+    txID(std::uint32_t i)
+    {
+        return sha512Half(std::string("tx"), i);
+    }
+
+    static TxIndex::Entry
+    entry(std::uint32_t i, LedgerIndex seq)
+    {
+        return {seq, sha512Half(std::string("node"), i)};
+    }
+
+    bool
+    expectEntry(
+        TxIndex const& index,
+        std::uint32_t i,
+        std::optional<LedgerIndex> seq)
+    {
+        auto const found = index.fetch(txID(i));
+        if (!seq)
+            return !found;
+        return found && found->ledgerSeq == *seq &&
+            found->nodeKey == entry(i, *seq).nodeKey;
+    }
+
+    void
+    testInsertFetch()
+    {
+        testcase("Insert and fetch");
+
+        beast::temp_dir tempDir;
+        SuiteJournal journal("TxIndex_test", *this);
+
+        {
+            TxIndex index(tempDir.path(), journal);
+            BEAST_EXPECT(expectEntry(index, 0, std::nullopt));
+
+            for (std::uint32_t i = 0; i < 100; ++i)
+                index.insert(txID(i), entry(i, 10 + i / 10));
+
+            for (std::uint32_t i = 0; i < 100; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i / 10));
+            BEAST_EXPECT(expectEntry(index, 100, std::nullopt));
+
+            // A transaction is indexed once
+            index.insert(txID(0), entry(0, 50));
+            BEAST_EXPECT(expectEntry(index, 0, 10));
+        }
+
+        {
+            // Re-open the index
+            TxIndex index(tempDir.path(), journal);
+            for (std::uint32_t i = 0; i < 100; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i / 10));
+        }
+    }
+
+    void
+    testDelete()
+    {
+        testcase("Delete");
+
+        using namespace boost::filesystem;
+
+        beast::temp_dir tempDir;
+        path const dir = tempDir.path();
+        SuiteJournal journal("TxIndex_test", *this);
+
+        auto generations = [&] {
+            std::size_t count = 0;
+            for (auto const& d : directory_iterator(dir))
+                count += is_directory(d.path()) ? 1 : 0;
+            return count;
+        };
+
+        {
+            TxIndex index(dir, journal);
+
+            // Ledgers 10 to 19
+            for (std::uint32_t i = 0; i < 10; ++i)
+                index.insert(txID(i), entry(i, 10 + i));
+            BEAST_EXPECT(generations() == 1);
+
+            // Deleting below the first ledger of the database keeps it
+            index.deleteBefore(5);
+            BEAST_EXPECT(expectEntry(index, 0, 10));
+
+            // Older ledgers are no longer found
+            index.deleteBefore(15);
+            for (std::uint32_t i = 0; i < 5; ++i)
+                BEAST_EXPECT(expectEntry(index, i, std::nullopt));
+            for (std::uint32_t i = 5; i < 10; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i));
+
+            // Ledgers 20 to 29 go to a new database
+            for (std::uint32_t i = 10; i < 20; ++i)
+                index.insert(txID(i), entry(i, 10 + i));
+            BEAST_EXPECT(generations() == 2);
+            for (std::uint32_t i = 5; i < 20; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i));
+
+            // The database of ledgers 10 to 19 is removed
+            index.deleteBefore(25);
+            BEAST_EXPECT(generations() == 1);
+            for (std::uint32_t i = 0; i < 15; ++i)
+                BEAST_EXPECT(expectEntry(index, i, std::nullopt));
+            for (std::uint32_t i = 15; i < 20; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i));
+
+            index.insert(txID(20), entry(20, 30));
+            BEAST_EXPECT(generations() == 2);
+        }
+
+        {
+            // Re-open the index
+            TxIndex index(dir, journal);
+            for (std::uint32_t i = 15; i < 21; ++i)
+                BEAST_EXPECT(expectEntry(index, i, 10 + i));
+        }
+    }
+
+    void
+    testTxRPC()
+    {
+        testcase("tx RPC");
+
+        using namespace test::jtx;
+
+        // Look up a payment after its rows are removed from the
+        // transaction database, so only the index can find it
+        auto lookup = [&](bool useIndex) {
+            beast::temp_dir tempDir;
+            Env env{*this, envconfig([&](std::unique_ptr<Config> cfg) {
+                        cfg->legacy("database_path", tempDir.path());
+                        if (useIndex)
+                            cfg->loadFromString(
+                                "[ledger_tx_tables]\nuse_tx_index = 1\n");
+                        return cfg;
+                    })};
+            BEAST_EXPECT(env.app().config().useTxIndex() == useIndex);
+
+            Account const alice("alice");
+            env.fund(XRP(10000), alice);
+            env.close();
+
+            env(pay(alice, env.master, XRP(100)));
+            auto const tx = env.tx();
+            env.close();
+            auto const seq = env.closed()->info().seq;
+            auto const meta =
+                env.closed()->txRead(tx->getTransactionID()).second;
+
+            auto const txID = to_string(tx->getTransactionID());
+            auto const before = env.rpc("tx", txID, "binary");
+            BEAST_EXPECT(
+                before[jss::result][jss::status] == jss::success &&
+                before[jss::result][jss::validated].asBool());
+
+            dynamic_cast<RelationalDBInterfaceSqlite*>(
+                &env.app().getRelationalDBInterface())
+                ->deleteTransactionByLedgerSeq(seq);
+
+            auto const result = env.rpc("tx", txID, "binary");
+            if (!useIndex)
+            {
+                BEAST_EXPECT(
+                    result[jss::result][jss::error] ==
+                    RPC::get_error_info(rpcTXN_NOT_FOUND).token);
+                return;
+            }
+
+            BEAST_EXPECT(result[jss::result][jss::status] == jss::success);
+            BEAST_EXPECT(result[jss::result][jss::validated].asBool());
+            BEAST_EXPECT(result[jss::result][jss::ledger_index] == seq);
+            BEAST_EXPECT(
+                result[jss::result][jss::tx] ==
+                strHex(tx->getSerializer().getData()));
+            BEAST_EXPECT(
+                result[jss::result][jss::meta] ==
+                strHex(meta->getSerializer().getData()));
+            BEAST_EXPECT(result[jss::result] == before[jss::result]);
+        };
+
+        lookup(false);
+        lookup(true);
+    }
+
+public:
+    void
+    run() override
+    {
+        testInsertFetch();
+        testDelete();
+        testTxRPC();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(TxIndex, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -2407,6 +2407,228 @@ private:
             {{108, {6}}, {108, {7}}, {110, {10}}, {110, {12}}});
     }
 
+    void
+    testVerifyBlob()
+    {
+        testcase("Verify blob");
+        using namespace std::chrono_literals;
+
+        ManifestCache manifests;
+        jtx::Env env(*this);
+        auto trustedKeys = std::make_unique<ValidatorList>(
+            manifests,
+            manifests,
+            env.timeKeeper(),
+            env.app().config().legacy("database_path"),
+            env.journal);
+
+        auto const publisherSecret = randomSecretKey();
+        auto const publisherPublic =
+            derivePublicKey(KeyType::ed25519, publisherSecret);
+        auto const pubSigningKeys1 = randomKeyPair(KeyType::secp256k1);
+        auto const manifest1 = base64_encode(makeManifestString(
+            publisherPublic,
+            publisherSecret,
+            pubSigningKeys1.first,
+            pubSigningKeys1.second,
+            1));
+
+        PublicKey emptyLocalKey;
+        std::vector<std::string> emptyCfgKeys;
+        std::vector<std::string> cfgPublishers({strHex(publisherPublic)});
+        BEAST_EXPECT(
+            trustedKeys->load(emptyLocalKey, emptyCfgKeys, cfgPublishers));
+
+        auto const validUntil = env.timeKeeper().now() + 3600s;
+        auto const blob = makeList(
+            {randomValidator(), randomValidator()},
+            1,
+            validUntil.time_since_epoch().count());
+        auto const sig = signList(blob, pubSigningKeys1);
+
+        auto& cache = trustedKeys->verifiedBlobs_;
+
+        // A good list is decoded and remembered
+        auto const verified = trustedKeys->verifyBlob(manifest1, blob, sig);
+        if (!BEAST_EXPECT(verified))
+            return;
+        BEAST_EXPECT(verified->signingKey == pubSigningKeys1.first);
+        BEAST_EXPECT(verified->list[jss::sequence] == 1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Seeing it again finds it in the cache
+        BEAST_EXPECT(trustedKeys->verifyBlob(manifest1, blob, sig) == verified);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Lists with a bad signature or from an unknown publisher are
+        // rejected and not remembered
+        BEAST_EXPECT(!trustedKeys->verifyBlob(
+            manifest1,
+            blob,
+            signList(blob, randomKeyPair(KeyType::secp256k1))));
+        {
+            auto const otherSecret = randomSecretKey();
+            auto const otherPublic =
+                derivePublicKey(KeyType::ed25519, otherSecret);
+            auto const otherSigningKeys = randomKeyPair(KeyType::secp256k1);
+            auto const otherManifest = base64_encode(makeManifestString(
+                otherPublic,
+                otherSecret,
+                otherSigningKeys.first,
+                otherSigningKeys.second,
+                1));
+            BEAST_EXPECT(!trustedKeys->verifyBlob(
+                otherManifest, blob, signList(blob, otherSigningKeys)));
+        }
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A list remembered for another signing key is checked again
+        auto const pubSigningKeys2 = randomKeyPair(KeyType::secp256k1);
+        auto const manifest2 = base64_encode(makeManifestString(
+            publisherPublic,
+            publisherSecret,
+            pubSigningKeys2.first,
+            pubSigningKeys2.second,
+            2));
+        BEAST_EXPECT(!trustedKeys->verifyBlob(manifest2, blob, sig));
+        auto const verified2 = trustedKeys->verifyBlob(
+            manifest2, blob, signList(blob, pubSigningKeys2));
+        BEAST_EXPECT(
+            verified2 && verified2 != verified &&
+            verified2->signingKey == pubSigningKeys2.first);
+        BEAST_EXPECT(cache.size() == 2);
+
+        // Once forgotten, a list is checked and remembered again
+        beast::expire(cache, 0s);
+        BEAST_EXPECT(cache.empty());
+        auto const verified3 = trustedKeys->verifyBlob(manifest1, blob, sig);
+        BEAST_EXPECT(verified3 && verified3 != verified);
+        BEAST_EXPECT(cache.size() == 1);
+    }
+
+    void
+    testIncrementalUpdateTrusted()
+    {
+        testcase("Incremental update trusted");
+        using namespace std::chrono_literals;
+
+        std::string const siteUri = "testIncrementalUpdateTrusted.test";
+
+        ManifestCache manifests;
+        jtx::Env env(*this);
+        auto trustedKeys = std::make_unique<ValidatorList>(
+            manifests,
+            manifests,
+            env.timeKeeper(),
+            env.app().config().legacy("database_path"),
+            env.journal);
+
+        auto const publisherSecret = randomSecretKey();
+        auto const publisherPublic =
+            derivePublicKey(KeyType::ed25519, publisherSecret);
+        auto const pubSigningKeys = randomKeyPair(KeyType::secp256k1);
+        auto const manifest = base64_encode(makeManifestString(
+            publisherPublic,
+            publisherSecret,
+            pubSigningKeys.first,
+            pubSigningKeys.second,
+            1));
+
+        PublicKey emptyLocalKey;
+        std::vector<std::string> emptyCfgKeys;
+        std::vector<std::string> cfgPublishers({strHex(publisherPublic)});
+        BEAST_EXPECT(
+            trustedKeys->load(emptyLocalKey, emptyCfgKeys, cfgPublishers));
+
+        // A validator whose master key will be revoked
+        auto const revokedSecret = randomSecretKey();
+        auto const revokedPublic =
+            derivePublicKey(KeyType::ed25519, revokedSecret);
+        auto const revokedSigningKeys = randomKeyPair(KeyType::secp256k1);
+
+        std::vector<Validator> validators(
+            {{revokedPublic,
+              revokedSigningKeys.first,
+              base64_encode(makeManifestString(
+                  revokedPublic,
+                  revokedSecret,
+                  revokedSigningKeys.first,
+                  revokedSigningKeys.second,
+                  1))},
+             randomValidator(),
+             randomValidator(),
+             randomValidator()});
+
+        auto const validUntil = env.timeKeeper().now() + 3600s;
+        auto apply = [&](std::size_t sequence) {
+            auto const blob = makeList(
+                validators, sequence, validUntil.time_since_epoch().count());
+            return trustedKeys->applyLists(
+                manifest,
+                1,
+                {{blob, signList(blob, pubSigningKeys), {}}},
+                siteUri);
+        };
+        auto update = [&] {
+            return trustedKeys->updateTrusted(
+                {},
+                env.timeKeeper().now(),
+                env.app().getOPs(),
+                env.app().overlay(),
+                env.app().getHashRouter());
+        };
+        auto const& listingChanges = trustedKeys->listingChanges_;
+
+        // Newly listed keys are trusted on the next update
+        BEAST_EXPECT(
+            apply(1).bestDisposition() == ListDisposition::accepted);
+        BEAST_EXPECT(listingChanges.size() == validators.size());
+        BEAST_EXPECT(!trustedKeys->trusted(revokedPublic));
+
+        auto changes = update();
+        BEAST_EXPECT(listingChanges.empty());
+        BEAST_EXPECT(changes.added.size() == validators.size());
+        BEAST_EXPECT(changes.removed.empty());
+        for (auto const& val : validators)
+            BEAST_EXPECT(trustedKeys->trusted(val.masterPublic));
+
+        // Without any listing change there is nothing to do
+        changes = update();
+        BEAST_EXPECT(changes.added.empty());
+        BEAST_EXPECT(changes.removed.empty());
+
+        // Only the keys added to or removed from the list are considered
+        auto const dropped = validators.back();
+        validators.back() = randomValidator();
+        BEAST_EXPECT(
+            apply(2).bestDisposition() == ListDisposition::accepted);
+        BEAST_EXPECT(listingChanges.size() == 2);
+        BEAST_EXPECT(listingChanges.count(dropped.masterPublic));
+        BEAST_EXPECT(listingChanges.count(validators.back().masterPublic));
+
+        changes = update();
+        BEAST_EXPECT(listingChanges.empty());
+        BEAST_EXPECT(
+            changes.added == asNodeIDs({validators.back().masterPublic}));
+        BEAST_EXPECT(changes.removed == asNodeIDs({dropped.masterPublic}));
+        BEAST_EXPECT(!trustedKeys->trusted(dropped.masterPublic));
+        BEAST_EXPECT(trustedKeys->trusted(validators.back().masterPublic));
+
+        // A trusted key stops being trusted once revoked, although its
+        // listing didn't change
+        BEAST_EXPECT(
+            manifests.applyManifest(*deserializeManifest(
+                makeRevocationString(revokedPublic, revokedSecret))) ==
+            ManifestDisposition::accepted);
+        BEAST_EXPECT(listingChanges.empty());
+
+        changes = update();
+        BEAST_EXPECT(changes.added.empty());
+        BEAST_EXPECT(changes.removed == asNodeIDs({revokedPublic}));
+        BEAST_EXPECT(!trustedKeys->trusted(revokedPublic));
+        BEAST_EXPECT(trustedKeys->listed(revokedPublic));
+    }
+
 public:
     void
     run() override
@@ -2416,6 +2638,8 @@ public:
         testApplyLists();
         testGetAvailable();
         testUpdateTrusted();
+        testVerifyBlob();
+        testIncrementalUpdateTrusted();
         testExpires();
         testNegativeUNL();
         testSha512Hash();
@@ -61,6 +61,25 @@ public:
         testUnHexFailure("XRP");
     }
 
+    void
+    testHex()
+    {
+        testcase("strHex");
+
+        BEAST_EXPECT(strHex(std::string{}) == "");
+        BEAST_EXPECT(strHex(std::string("RippleD")) == "526970706C6544");
+        BEAST_EXPECT(strHex(std::string("\0\x0F\xF0\xFF", 4)) == "000FF0FF");
+
+        // Every byte value round trips
+        Blob blob(256);
+        for (int i = 0; i < 256; ++i)
+            blob[i] = static_cast<unsigned char>(255 - i);
+        auto const hex = strHex(blob);
+        BEAST_EXPECT(hex.size() == 512);
+        BEAST_EXPECT(hex.substr(0, 6) == "FFFEFD");
+        BEAST_EXPECT(strUnHex(hex) == blob);
+    }
+
     void
     testParseUrl()
     {
@@ -311,6 +330,7 @@ public:
     {
         testParseUrl();
         testUnHex();
+        testHex();
         testToString();
     }
 };
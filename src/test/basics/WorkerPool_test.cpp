@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/WorkerPool.h>
+#include <ripple/beast/unit_test.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+class WorkerPool_test : public beast::unit_test::suite
+{
+    void
+    testForEach()
+    {
+        testcase("forEach");
+
+        auto& pool = WorkerPool::instance();
+        BEAST_EXPECT(pool.size() > 0);
+
+        // Nothing to do
+        pool.forEach(0, 4, [&](std::size_t) { fail("called"); });
+
+        // Every part is done exactly once, with or without helpers
+        for (std::size_t helpers : {0, 1, 4, 64})
+        {
+            std::vector<std::atomic<int>> calls(1000);
+            pool.forEach(calls.size(), helpers, [&](std::size_t i) {
+                ++calls[i];
+            });
+            bool once = true;
+            for (auto const& c : calls)
+                once = once && c == 1;
+            BEAST_EXPECT(once);
+        }
+    }
+
+    void
+    testNested()
+    {
+        testcase("Nested");
+
+        // Parts that split their own work complete even when every
+        // thread of the pool is busy
+        auto& pool = WorkerPool::instance();
+        std::size_t const n = pool.size() * 2;
+        std::atomic<std::size_t> total{0};
+        pool.forEach(n, n, [&](std::size_t) {
+            pool.forEach(n, n, [&](std::size_t) { ++total; });
+        });
+        BEAST_EXPECT(total == n * n);
+    }
+
+    void
+    testException()
+    {
+        testcase("Exception");
+
+        auto& pool = WorkerPool::instance();
+        std::atomic<int> calls{0};
+        try
+        {
+            pool.forEach(100, 4, [&](std::size_t i) {
+                ++calls;
+                if (i == 50)
+                    throw std::runtime_error("part 50");
+            });
+            fail("no exception");
+        }
+        catch (std::runtime_error const& e)
+        {
+            BEAST_EXPECT(std::string(e.what()) == "part 50");
+        }
+        // The other parts still ran
+        BEAST_EXPECT(calls == 100);
+    }
+
+public:
+    void
+    run() override
+    {
+        testForEach();
+        testNested();
+        testException();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(WorkerPool, basics, ripple);
+
+}  // namespace test
+}  // namespace ripple
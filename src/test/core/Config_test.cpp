@@ -1139,6 +1139,34 @@ r.ripple.com 51235
         BEAST_EXPECT(!testDiverged("901"));
     }
 
+    void
+    testNetworkID()
+    {
+        testcase("network_id");
+
+        auto testNetwork =
+            [](std::string value) -> std::optional<std::uint32_t> {
+            try
+            {
+                Config c;
+                c.loadFromString("[network_id]\n" + value);
+                return c.NETWORK_ID;
+            }
+            catch (std::runtime_error&)
+            {
+                return 999;
+            }
+        };
+
+        BEAST_EXPECT(!testNetwork(""));
+        BEAST_EXPECT(testNetwork("main") == 0);
+        BEAST_EXPECT(testNetwork("testnet") == 1);
+        BEAST_EXPECT(testNetwork("devnet") == 2);
+        BEAST_EXPECT(testNetwork("21337") == 21337);
+        BEAST_EXPECT(testNetwork("mainnet") == 999);
+        BEAST_EXPECT(testNetwork("-1") == 999);
+    }
+
     void
     run() override
     {
@@ -1154,6 +1182,7 @@ r.ripple.com 51235
         testGetters();
         testAmendment();
         testOverlay();
+        testNetworkID();
     }
 };
 
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TEST_JTX_BENCHMARK_H_INCLUDED
+#define RIPPLE_TEST_JTX_BENCHMARK_H_INCLUDED
+
+#include <ripple/beast/unit_test.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace ripple {
+namespace test {
+namespace jtx {
+
+/** Times one step of a manual benchmark suite.
+
+    Runs f, which performs ops operations, and writes the total time and
+    the average time per operation to the suite's log.
+*/
+template <class F>
+void
+benchmark(
+    beast::unit_test::suite& suite,
+    std::string const& name,
+    std::size_t ops,
+    F&& f)
+{
+    using namespace std::chrono;
+    auto const start = steady_clock::now();
+    std::forward<F>(f)();
+    auto const elapsed = steady_clock::now() - start;
+
+    nanoseconds const each = elapsed / std::max<std::size_t>(ops, 1);
+    suite.log << "    " << name << ": " << ops << " in "
+              << duration_cast<milliseconds>(elapsed).count() << "ms, ";
+    if (each < 10us)
+        suite.log << each.count() << "ns each" << std::endl;
+    else
+        suite.log << duration_cast<microseconds>(each).count() << "us each"
+                  << std::endl;
+}
+
+}  // namespace jtx
+}  // namespace test
+}  // namespace ripple
+
+#endif
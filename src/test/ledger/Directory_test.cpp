@@ -24,6 +24,7 @@
 #include <ripple/protocol/jss.h>
 #include <algorithm>
 #include <test/jtx.h>
+#include <test/jtx/benchmark.h>
 
 namespace ripple {
 namespace test {
@@ -406,7 +407,65 @@ struct Directory_test : public beast::unit_test::suite
     }
 };
 
+// Measures how quickly offers are created in, and cancelled from, a large
+// owner directory.
+struct Directory_manual_test : public beast::unit_test::suite
+{
+    void
+    testOfferThroughput(std::size_t const offerCount)
+    {
+        testcase << "Offer throughput " << offerCount << " offers";
+        using namespace jtx;
+
+        auto gw = Account("gw");
+        auto USD = gw["USD"];
+        auto alice = Account("alice");
+
+        Env env(*this);
+        env.fund(XRP(10000000), alice, gw);
+        env.close();
+
+        std::uint32_t const firstOfferSeq{env.seq(alice)};
+        benchmark(*this, "create", offerCount, [&]() {
+            for (std::size_t i = 1; i <= offerCount; ++i)
+            {
+                env(offer(alice, USD(i), XRP(i)));
+                if (i % 256 == 0)
+                    env.close();
+            }
+            env.close();
+        });
+
+        BEAST_EXPECT(env.le(alice)->getFieldU32(sfOwnerCount) == offerCount);
+
+        // Cancel from the middle of the directory outwards, so that pages
+        // are emptied out of order.
+        benchmark(*this, "cancel", offerCount, [&]() {
+            for (std::size_t i = 0; i < offerCount; ++i)
+            {
+                auto const seq = (i % 2 == 0) ? offerCount / 2 + i / 2
+                                              : offerCount / 2 - 1 - i / 2;
+                env(offer_cancel(alice, firstOfferSeq + seq));
+                if (i % 256 == 255)
+                    env.close();
+            }
+            env.close();
+        });
+
+        BEAST_EXPECT(env.le(alice)->getFieldU32(sfOwnerCount) == 0);
+        BEAST_EXPECT(!env.le(keylet::ownerDir(alice)));
+    }
+
+    void
+    run() override
+    {
+        testOfferThroughput(1000);
+        testOfferThroughput(10000);
+    }
+};
+
 BEAST_DEFINE_TESTSUITE_PRIO(Directory, ledger, ripple, 1);
+BEAST_DEFINE_TESTSUITE_MANUAL(Directory_manual, ledger, ripple);
 
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,401 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/net/RPCSub.h>
+#include <ripple/protocol/jss.h>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <test/jtx.h>
+#include <test/jtx/benchmark.h>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+// A local HTTP server which collects the posted events. Each reply is
+// written `latency` after its request was read, in order, while the
+// following requests are read, as if the server were that far away.
+class EventSink
+{
+    using clock_type = std::chrono::steady_clock;
+    using socket_type = boost::asio::ip::tcp::socket;
+    using error_code = boost::system::error_code;
+    using response_type =
+        boost::beast::http::response<boost::beast::http::string_body>;
+
+    // The replies not yet written on one connection
+    struct Replies
+    {
+        explicit Replies(boost::asio::io_context& ioc) : timer(ioc)
+        {
+        }
+
+        std::deque<std::pair<clock_type::time_point, response_type>> queue;
+        bool writing = false;
+        boost::asio::steady_timer timer;
+    };
+
+    boost::asio::io_context ioc_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    bool const keepAlive_;
+    std::chrono::milliseconds const latency_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Json::Value> events_;
+    std::size_t connections_ = 0;
+
+    std::thread thread_;
+
+    void
+    serve(
+        std::shared_ptr<socket_type> const& socket,
+        boost::asio::yield_context yield)
+    {
+        namespace http = boost::beast::http;
+
+        auto const replies = std::make_shared<Replies>(ioc_);
+        boost::beast::flat_buffer buffer;
+        for (;;)
+        {
+            error_code ec;
+            http::request<http::string_body> req;
+            http::async_read(*socket, buffer, req, yield[ec]);
+            if (ec)
+                return;
+
+            Json::Value jv;
+            Json::Reader().parse(req.body(), jv);
+            {
+                std::lock_guard lock(mutex_);
+                events_.push_back(jv[jss::params]);
+            }
+            cv_.notify_all();
+
+            response_type res{http::status::ok, req.version()};
+            res.keep_alive(keepAlive_ && req.keep_alive());
+            res.body() = "{}";
+            res.prepare_payload();
+            bool const keepAlive = res.keep_alive();
+            replies->queue.emplace_back(
+                clock_type::now() + latency_, std::move(res));
+
+            if (!replies->writing)
+            {
+                replies->writing = true;
+                boost::asio::spawn(
+                    ioc_,
+                    [socket, replies](boost::asio::yield_context yield) {
+                        writeReplies(*socket, *replies, yield);
+                    });
+            }
+            if (!keepAlive)
+                return;
+        }
+    }
+
+    static void
+    writeReplies(
+        socket_type& socket,
+        Replies& replies,
+        boost::asio::yield_context yield)
+    {
+        while (!replies.queue.empty())
+        {
+            error_code ec;
+            replies.timer.expires_at(replies.queue.front().first);
+            replies.timer.async_wait(yield[ec]);
+
+            auto& res = replies.queue.front().second;
+            boost::beast::http::async_write(socket, res, yield[ec]);
+            bool const keepAlive = res.keep_alive();
+            replies.queue.pop_front();
+            if (ec || !keepAlive)
+            {
+                socket.close(ec);
+                break;
+            }
+        }
+        replies.writing = false;
+    }
+
+public:
+    explicit EventSink(
+        bool keepAlive,
+        std::chrono::milliseconds latency = std::chrono::milliseconds{0})
+        : acceptor_(
+              ioc_,
+              {boost::asio::ip::make_address(getEnvLocalhostAddr()), 0})
+        , keepAlive_(keepAlive)
+        , latency_(latency)
+    {
+        boost::asio::spawn(ioc_, [this](boost::asio::yield_context yield) {
+            for (;;)
+            {
+                error_code ec;
+                auto socket = std::make_shared<socket_type>(ioc_);
+                acceptor_.async_accept(*socket, yield[ec]);
+                if (ec)
+                    return;
+
+                {
+                    std::lock_guard lock(mutex_);
+                    ++connections_;
+                }
+
+                boost::asio::spawn(
+                    ioc_, [this, socket](boost::asio::yield_context yield) {
+                        serve(socket, yield);
+                    });
+            }
+        });
+        thread_ = std::thread([this] { ioc_.run(); });
+    }
+
+    ~EventSink()
+    {
+        ioc_.stop();
+        thread_.join();
+    }
+
+    std::string
+    url() const
+    {
+        auto const ep = acceptor_.local_endpoint();
+        auto const host = ep.address().is_v6()
+            ? "[" + ep.address().to_string() + "]"
+            : ep.address().to_string();
+        return "http://" + host + ":" + std::to_string(ep.port()) +
+            "/events";
+    }
+
+    // Waits for `n` events and returns them
+    std::vector<Json::Value>
+    wait(
+        std::size_t n,
+        std::chrono::seconds timeout = std::chrono::seconds{10})
+    {
+        std::unique_lock lock(mutex_);
+        cv_.wait_for(lock, timeout, [&] { return events_.size() >= n; });
+        return events_;
+    }
+
+    std::size_t
+    connections()
+    {
+        std::lock_guard lock(mutex_);
+        return connections_;
+    }
+};
+
+static std::shared_ptr<RPCSub>
+makeSub(jtx::Env& env, EventSink const& sink)
+{
+    return make_RPCSub(
+        env.app().getOPs(),
+        env.app().getIOService(),
+        env.app().config(),
+        sink.url(),
+        "",
+        "",
+        env.app().logs());
+}
+
+class RPCSub_test : public beast::unit_test::suite
+{
+    void
+    testKeepAlive()
+    {
+        testcase("Keep alive");
+
+        jtx::Env env(*this);
+        EventSink sink(true);
+        auto sub = makeSub(env, sink);
+
+        int const count = 100;
+        for (int i = 0; i < count; ++i)
+        {
+            Json::Value event;
+            event[jss::type] = "test";
+            event[jss::index] = i;
+            sub->send(event, false);
+        }
+
+        auto const events = sink.wait(count);
+        if (BEAST_EXPECT(events.size() == count))
+        {
+            // The events arrive in order over a single connection
+            for (int i = 0; i < count; ++i)
+            {
+                BEAST_EXPECT(events[i]["seq"].asInt() == i + 1);
+                BEAST_EXPECT(events[i][jss::index].asInt() == i);
+            }
+        }
+        BEAST_EXPECT(sink.connections() == 1);
+        BEAST_EXPECT(sub->dropped() == 0);
+    }
+
+    void
+    testPipelining()
+    {
+        testcase("Pipelining");
+
+        using namespace std::chrono_literals;
+        jtx::Env env(*this);
+        auto const latency = 50ms;
+        EventSink sink(true, latency);
+        auto sub = makeSub(env, sink);
+
+        int const count = 64;
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            Json::Value event;
+            event[jss::type] = "test";
+            event[jss::index] = i;
+            sub->send(event, false);
+        }
+
+        // Several events are in flight at once, still in order and over a
+        // single connection. One at a time would take count * latency.
+        auto const events = sink.wait(count);
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        if (BEAST_EXPECT(events.size() == count))
+        {
+            for (int i = 0; i < count; ++i)
+                BEAST_EXPECT(events[i][jss::index].asInt() == i);
+        }
+        BEAST_EXPECT(elapsed < count * latency / 2);
+        BEAST_EXPECT(sink.connections() == 1);
+    }
+
+    void
+    testReconnect()
+    {
+        testcase("Reconnect");
+
+        jtx::Env env(*this);
+        EventSink sink(false);
+        auto sub = makeSub(env, sink);
+
+        int const count = 10;
+        for (int i = 0; i < count; ++i)
+        {
+            Json::Value event;
+            event[jss::type] = "test";
+            event[jss::index] = i;
+            sub->send(event, false);
+        }
+
+        // Every event is delivered when the server closes the connections
+        auto const events = sink.wait(count);
+        if (BEAST_EXPECT(events.size() == count))
+        {
+            for (int i = 0; i < count; ++i)
+                BEAST_EXPECT(events[i][jss::index].asInt() == i);
+        }
+        BEAST_EXPECT(sink.connections() == count);
+    }
+
+    void
+    testCounts()
+    {
+        testcase("Counts");
+
+        using namespace jtx;
+        Env env(*this);
+        EventSink sink(true);
+
+        Json::Value jv;
+        jv[jss::url] = sink.url();
+        jv[jss::streams] = Json::arrayValue;
+        jv[jss::streams].append("ledger");
+        auto const sub = env.rpc("json", "subscribe", to_string(jv));
+        BEAST_EXPECT(sub[jss::result][jss::status] == "success");
+
+        // Each URL subscription reports the events it dropped
+        auto const counts = env.rpc("get_counts")[jss::result];
+        BEAST_EXPECT(counts[jss::rpc_sub_dropped][sink.url()] == "0");
+    }
+
+public:
+    void
+    run() override
+    {
+        testKeepAlive();
+        testPipelining();
+        testReconnect();
+        testCounts();
+    }
+};
+
+// Measures how quickly events are delivered to a local receiver, with and
+// without latency on its replies.
+class RPCSub_manual_test : public beast::unit_test::suite
+{
+    void
+    testThroughput(std::chrono::milliseconds latency)
+    {
+        testcase << "Throughput " << latency.count() << "ms latency";
+
+        jtx::Env env(*this);
+        EventSink sink(true, latency);
+        auto sub = makeSub(env, sink);
+
+        std::size_t const count = 10000;
+        std::vector<Json::Value> events;
+        jtx::benchmark(*this, "deliver", count, [&]() {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Json::Value event;
+                event[jss::type] = "transaction";
+                event[jss::index] = static_cast<Json::UInt>(i);
+                sub->send(event, true);
+            }
+            events = sink.wait(count, std::chrono::seconds{600});
+        });
+
+        BEAST_EXPECT(events.size() == count);
+        BEAST_EXPECT(sub->dropped() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace std::chrono_literals;
+        testThroughput(0ms);
+        testThroughput(1ms);
+        testThroughput(10ms);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RPCSub, net, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(RPCSub_manual, net, ripple);
+
+}  // namespace test
+}  // namespace ripple
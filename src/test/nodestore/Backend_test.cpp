@@ -22,6 +22,8 @@
 #include <ripple/nodestore/Manager.h>
 #include <ripple/unity/rocksdb.h>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 #include <test/nodestore/TestBase.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -98,6 +100,119 @@ public:
         }
     }
 
+    void
+    testFilter(std::string const& type, std::uint64_t const seedValue)
+    {
+        DummyScheduler scheduler;
+
+        testcase("Bloom filter type=" + type);
+
+        Section params;
+        beast::temp_dir tempDir;
+        params.set("type", type);
+        params.set("path", tempDir.path());
+        params.set("bloom_filter_items", "4000");
+
+        beast::xor_shift_engine rng(seedValue);
+
+        auto batch = createPredictableBatch(numObjectsToTest, rng());
+        auto missing = createPredictableBatch(numObjectsToTest, rng());
+
+        using namespace beast::severities;
+        test::SuiteJournal journal("Backend_test", *this);
+
+        // Wait for the filter to be loaded, then fetch the missing objects
+        auto expectFiltered = [&](Backend& backend) {
+            using namespace std::chrono_literals;
+            for (int i = 0; i < 100; ++i)
+            {
+                std::shared_ptr<NodeObject> object;
+                for (auto const& e : missing)
+                {
+                    if (backend.fetch(e->getHash().cbegin(), &object) !=
+                            notFound ||
+                        object)
+                    {
+                        fail("missing object found");
+                        return;
+                    }
+                }
+
+                auto const c = backend.counters();
+                if (c && c->filteredReads != 0)
+                {
+                    // About 0.5% of misses should reach the database
+                    BEAST_EXPECT(
+                        c->filterFalsePositives < missing.size() / 20);
+                    return;
+                }
+                std::this_thread::sleep_for(10ms);
+            }
+            fail("filter never loaded");
+        };
+
+        {
+            std::unique_ptr<Backend> backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal);
+            backend->open();
+
+            storeBatch(*backend, batch);
+
+            Batch copy;
+            fetchCopyOfBatch(*backend, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+
+            expectFiltered(*backend);
+
+            // Objects stored after the filter is loaded are found
+            auto more = createPredictableBatch(numObjectsToTest / 10, rng());
+            backend->storeBatch(more);
+            copy.clear();
+            fetchCopyOfBatch(*backend, &copy, more);
+            BEAST_EXPECT(areBatchesEqual(more, copy));
+        }
+
+        {
+            // Re-open the backend, which fills the filter from the database
+            std::unique_ptr<Backend> backend = Manager::instance().make_Backend(
+                params, megabytes(4), scheduler, journal);
+            backend->open();
+
+            // Objects stored while the filter is loading are found
+            auto more = createPredictableBatch(numObjectsToTest / 10, rng());
+            backend->storeBatch(more);
+
+            expectFiltered(*backend);
+
+            Batch copy;
+            fetchCopyOfBatch(*backend, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual(batch, copy));
+            copy.clear();
+            fetchCopyOfBatch(*backend, &copy, more);
+            BEAST_EXPECT(areBatchesEqual(more, copy));
+
+            // Batch fetches are filtered too
+            std::vector<uint256 const*> hashes;
+            for (auto const& e : missing)
+                hashes.push_back(&e->getHash());
+            for (auto const& e : batch)
+                hashes.push_back(&e->getHash());
+
+            auto const [objects, status] = backend->fetchBatch(hashes);
+            BEAST_EXPECT(status == ok);
+            if (BEAST_EXPECT(objects.size() == hashes.size()))
+            {
+                for (std::size_t i = 0; i < missing.size(); ++i)
+                    BEAST_EXPECT(!objects[i]);
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                {
+                    auto const& object = objects[missing.size() + i];
+                    BEAST_EXPECT(object && isSame(batch[i], object));
+                }
+            }
+        }
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -107,6 +222,9 @@ public:
 
         testBackend("nudb", seedValue);
 
+        testFilter("memory", seedValue);
+        testFilter("nudb", seedValue);
+
 #if RIPPLE_ROCKSDB_AVAILABLE
         testBackend("rocksdb", seedValue);
 #endif
@@ -37,6 +37,7 @@
 #include <test/nodestore/TestBase.h>
 
 #include <boost/algorithm/hex.hpp>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -1628,6 +1629,56 @@ class DatabaseShard_test : public TestBase
         auto const index{ledgerSeq - ledgersPerShard - 1};
         BEAST_EXPECT(shardStore->fetchNodeObject(
             data.ledgers_[index]->info().hash, ledgerSeq));
+
+        // Query the databases of every shard, opening the closed ones,
+        // and merge the results in order
+        shardStore->sweep();
+        std::vector<std::uint32_t> visited;
+        BEAST_EXPECT(shardStore->iterateLedgerSQLsBack(
+            std::nullopt,
+            [&](soci::session& session, std::uint32_t shardIndex) {
+                visited.push_back(shardIndex);
+                return true;
+            }));
+        BEAST_EXPECT(visited.size() == numShards);
+        BEAST_EXPECT(std::is_sorted(visited.rbegin(), visited.rend()));
+
+        std::atomic<int> queried{0};
+        visited.clear();
+        BEAST_EXPECT(shardStore->queryTransactionSQLsForward(
+            std::nullopt,
+            [&](soci::session& session, std::uint32_t shardIndex) {
+                ++queried;
+            },
+            [&](std::uint32_t shardIndex) {
+                visited.push_back(shardIndex);
+                return true;
+            }));
+        BEAST_EXPECT(queried == numShards);
+        BEAST_EXPECT(visited.size() == numShards);
+        BEAST_EXPECT(std::is_sorted(visited.begin(), visited.end()));
+
+        visited.clear();
+        BEAST_EXPECT(shardStore->queryTransactionSQLsBack(
+            std::nullopt,
+            [&](soci::session& session, std::uint32_t shardIndex) {},
+            [&](std::uint32_t shardIndex) {
+                visited.push_back(shardIndex);
+                return true;
+            }));
+        BEAST_EXPECT(visited.size() == numShards);
+        BEAST_EXPECT(std::is_sorted(visited.rbegin(), visited.rend()));
+
+        // Stop merging part way through
+        visited.clear();
+        BEAST_EXPECT(!shardStore->queryLedgerSQLsForward(
+            std::nullopt,
+            [&](soci::session& session, std::uint32_t shardIndex) {},
+            [&](std::uint32_t shardIndex) {
+                visited.push_back(shardIndex);
+                return visited.size() < 2;
+            }));
+        BEAST_EXPECT(visited.size() == 2);
     }
 
     void
@@ -1801,6 +1852,16 @@ class DatabaseShard_test : public TestBase
         rdb->closeLedgerDB();
         rdb->closeTransactionDB();
 
+        {
+            // The ledgers of every shard are counted
+            auto const [count, minSeq, maxSeq] = rdb->getLedgerCountMinMax();
+            BEAST_EXPECT(count == shardCount * ledgersPerShard);
+            BEAST_EXPECT(
+                minSeq ==
+                shardStore->firstLedgerSeq(shardStore->earliestShardIndex()));
+            BEAST_EXPECT(maxSeq - minSeq + 1 == count);
+        }
+
         // Lambda for comparing Ledger objects
         auto infoCmp = [](auto const& a, auto const& b) {
             return a.hash == b.hash && a.txHash == b.txHash &&
@@ -145,7 +145,10 @@ class Timing_test : public beast::unit_test::suite
 public:
     enum {
         // percent of fetches for missing nodes
-        missingNodePercent = 20
+        missingNodePercent = 20,
+
+        // objects written per storeBatch call
+        insertBatchSize = 256
     };
 
     std::size_t const default_repeat = 3;
@@ -321,6 +324,65 @@ public:
         backend->close();
     }
 
+    // Insert all objects in groups, one storeBatch call per group
+    void
+    do_insert_batch(
+        Section const& config,
+        Params const& params,
+        beast::Journal journal)
+    {
+        DummyScheduler scheduler;
+        auto backend = make_Backend(config, scheduler, journal);
+        BEAST_EXPECT(backend != nullptr);
+        backend->open();
+
+        class Body
+        {
+        private:
+            suite& suite_;
+            Backend& backend_;
+            Sequence seq_;
+            Batch batch_;
+
+        public:
+            explicit Body(suite& s, Backend& backend)
+                : suite_(s), backend_(backend), seq_(3)
+            {
+            }
+
+            void
+            operator()(std::size_t i)
+            {
+                try
+                {
+                    seq_.batch(i * insertBatchSize, batch_, insertBatchSize);
+                    backend_.storeBatch(batch_);
+                }
+                catch (std::exception const& e)
+                {
+                    suite_.fail(e.what());
+                }
+            }
+        };
+
+        try
+        {
+            parallel_for<Body>(
+                params.items / insertBatchSize,
+                params.threads,
+                std::ref(*this),
+                std::ref(*backend));
+        }
+        catch (std::exception const&)
+        {
+#if NODESTORE_TIMING_DO_VERIFY
+            backend->verify();
+#endif
+            Rethrow();
+        }
+        backend->close();
+    }
+
     // Fetch existing keys
     void
     do_fetch(
@@ -757,6 +819,7 @@ public:
 
         test_list const tests = {
             {"Insert", &Timing_test::do_insert},
+            {"InsertBatch", &Timing_test::do_insert_batch},
             {"Fetch", &Timing_test::do_fetch},
             {"Missing", &Timing_test::do_missing},
             {"Mixed", &Timing_test::do_mixed},
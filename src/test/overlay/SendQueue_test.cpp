@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/SendQueue.h>
+#include <ripple/protocol/jss.h>
+#include <ripple.pb.h>
+#include <string>
+
+namespace ripple {
+
+namespace test {
+
+class SendQueue_test : public beast::unit_test::suite
+{
+    using clock_type = SendQueue::clock_type;
+
+    static std::shared_ptr<Message>
+    makeMessage(SendQueue::Class c)
+    {
+        switch (c)
+        {
+            case SendQueue::consensus: {
+                protocol::TMPing ping;
+                ping.set_type(protocol::TMPing::ptPING);
+                return std::make_shared<Message>(ping, protocol::mtPING);
+            }
+            case SendQueue::transactions: {
+                protocol::TMTransaction tx;
+                tx.set_rawtransaction("tx");
+                tx.set_status(protocol::tsNEW);
+                return std::make_shared<Message>(
+                    tx, protocol::mtTRANSACTION);
+            }
+            case SendQueue::ledgerData: {
+                protocol::TMLedgerData data;
+                data.set_ledgerhash(std::string(32, 'a'));
+                data.set_ledgerseq(1);
+                data.set_type(protocol::liAS_NODE);
+                return std::make_shared<Message>(
+                    data, protocol::mtLEDGER_DATA);
+            }
+            case SendQueue::maintenance:
+                break;
+        }
+        protocol::TMCluster cluster;
+        return std::make_shared<Message>(cluster, protocol::mtCLUSTER);
+    }
+
+    static SendQueue::Class
+    classOf(std::shared_ptr<Message> const& m)
+    {
+        return SendQueue::classify(
+            safe_cast<TrafficCount::category>(m->getCategory()));
+    }
+
+    void
+    testClassify()
+    {
+        testcase("Classify");
+
+        for (auto const c :
+             {SendQueue::consensus,
+              SendQueue::transactions,
+              SendQueue::ledgerData,
+              SendQueue::maintenance})
+            BEAST_EXPECT(classOf(makeMessage(c)) == c);
+
+        using cat = TrafficCount::category;
+        BEAST_EXPECT(
+            SendQueue::classify(cat::validation) == SendQueue::consensus);
+        BEAST_EXPECT(
+            SendQueue::classify(cat::proposal) == SendQueue::consensus);
+        BEAST_EXPECT(
+            SendQueue::classify(cat::share_fetch_pack) ==
+            SendQueue::ledgerData);
+        BEAST_EXPECT(
+            SendQueue::classify(cat::validatorlist) ==
+            SendQueue::maintenance);
+    }
+
+    void
+    testOrder()
+    {
+        testcase("Order");
+
+        SendQueue queue;
+        BEAST_EXPECT(queue.empty());
+
+        // Messages of one class keep their order
+        std::vector<std::shared_ptr<Message>> sent;
+        for (int i = 0; i < 3; ++i)
+        {
+            sent.push_back(makeMessage(SendQueue::transactions));
+            queue.push(sent.back(), 100);
+        }
+        BEAST_EXPECT(queue.size() == 3);
+        BEAST_EXPECT(queue.size(SendQueue::transactions) == 3);
+
+        for (auto const& m : sent)
+        {
+            BEAST_EXPECT(queue.front() == m);
+            BEAST_EXPECT(queue.front() == m);
+            BEAST_EXPECT(queue.size() != 0);
+            queue.pop();
+        }
+        BEAST_EXPECT(queue.empty());
+    }
+
+    void
+    testPriority()
+    {
+        testcase("Priority");
+
+        SendQueue queue;
+        std::size_t const large = 10 * SendQueue::quantum(SendQueue::consensus);
+
+        for (int i = 0; i < 5; ++i)
+            queue.push(makeMessage(SendQueue::ledgerData), large);
+
+        // A reply is being written when the consensus messages arrive
+        BEAST_EXPECT(classOf(queue.front()) == SendQueue::ledgerData);
+        for (int i = 0; i < 5; ++i)
+            queue.push(makeMessage(SendQueue::consensus), 200);
+        BEAST_EXPECT(queue.size() == 10);
+        queue.pop();
+
+        // They are written next, without waiting for the other replies
+        for (int i = 0; i < 5; ++i)
+        {
+            BEAST_EXPECT(classOf(queue.front()) == SendQueue::consensus);
+            queue.pop();
+        }
+        while (!queue.empty())
+        {
+            BEAST_EXPECT(classOf(queue.front()) == SendQueue::ledgerData);
+            queue.pop();
+        }
+    }
+
+    void
+    testShare()
+    {
+        testcase("Share");
+
+        // With every class backlogged, each writes bytes in proportion
+        // to its weight, so that none is starved
+        SendQueue queue;
+        std::size_t const bytes = SendQueue::quantum(SendQueue::maintenance);
+        for (std::size_t c = 0; c < SendQueue::classCount; ++c)
+        {
+            for (int i = 0; i < 100; ++i)
+                queue.push(
+                    makeMessage(static_cast<SendQueue::Class>(c)), bytes);
+        }
+
+        std::array<int, SendQueue::classCount> written{};
+        for (int i = 0; i < 2 * 15; ++i)
+        {
+            ++written[classOf(queue.front())];
+            queue.pop();
+        }
+        BEAST_EXPECT(written[SendQueue::consensus] == 16);
+        BEAST_EXPECT(written[SendQueue::transactions] == 8);
+        BEAST_EXPECT(written[SendQueue::ledgerData] == 4);
+        BEAST_EXPECT(written[SendQueue::maintenance] == 2);
+    }
+
+    void
+    testStats()
+    {
+        testcase("Stats");
+
+        using namespace std::chrono_literals;
+        SendQueue queue;
+        auto const start = clock_type::now();
+        queue.push(makeMessage(SendQueue::consensus), 100, start);
+        queue.push(makeMessage(SendQueue::consensus), 100, start);
+        queue.push(makeMessage(SendQueue::ledgerData), 100, start);
+
+        queue.front(start + 2ms);
+        BEAST_EXPECT(queue.waited() == 2ms);
+        queue.pop();
+        queue.front(start + 4ms);
+        BEAST_EXPECT(queue.waited() == 4ms);
+        queue.pop();
+
+        auto const jv = queue.json();
+        BEAST_EXPECT(jv["consensus"][jss::queued].asUInt() == 0);
+        BEAST_EXPECT(jv["consensus"][jss::avg_delay_us].asString() == "3000");
+        BEAST_EXPECT(jv["ledger_data"][jss::queued].asUInt() == 1);
+        BEAST_EXPECT(jv["ledger_data"][jss::avg_delay_us].asString() == "0");
+        BEAST_EXPECT(jv["transactions"][jss::queued].asUInt() == 0);
+        BEAST_EXPECT(jv["maintenance"][jss::queued].asUInt() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testClassify();
+        testOrder();
+        testPriority();
+        testShare();
+        testStats();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SendQueue, overlay, ripple);
+
+}  // namespace test
+
+}  // namespace ripple
@@ -35,16 +35,20 @@
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/shamap/SHAMapNodeID.h>
+#include <ripple/shamap/SHAMapTreeNode.h>
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/beast/core/multi_buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
+#include <chrono>
 #include <ripple.pb.h>
 #include <test/jtx/Account.h>
 #include <test/jtx/Env.h>
 #include <test/jtx/WSClient.h>
 #include <test/jtx/amount.h>
+#include <test/jtx/offer.h>
 #include <test/jtx/pay.h>
+#include <test/jtx/trust.h>
 
 namespace ripple {
 
@@ -89,57 +93,72 @@ public:
     {
         testcase("Compress/Decompress: " + msg);
 
-        Message m(*proto, mt);
-
-        auto& buffer = m.getBuffer(Compressed::On);
-
-        boost::beast::multi_buffer buffers;
-
-        // simulate multi-buffer
-        auto sz = buffer.size() / nbuffers;
-        for (int i = 0; i < nbuffers; i++)
+        for (auto const algorithm : {Algorithm::LZ4, Algorithm::LZ4Dict})
         {
-            auto start = buffer.begin() + sz * i;
-            auto end = i < nbuffers - 1 ? (buffer.begin() + sz * (i + 1))
-                                        : buffer.end();
-            std::vector<std::uint8_t> slice(start, end);
-            buffers.commit(boost::asio::buffer_copy(
-                buffers.prepare(slice.size()), boost::asio::buffer(slice)));
+            Message m(*proto, mt);
+
+            auto& buffer = m.getBuffer(Compressed::On, algorithm);
+
+            boost::beast::multi_buffer buffers;
+
+            // simulate multi-buffer
+            auto sz = buffer.size() / nbuffers;
+            for (int i = 0; i < nbuffers; i++)
+            {
+                auto start = buffer.begin() + sz * i;
+                auto end = i < nbuffers - 1 ? (buffer.begin() + sz * (i + 1))
+                                            : buffer.end();
+                std::vector<std::uint8_t> slice(start, end);
+                buffers.commit(boost::asio::buffer_copy(
+                    buffers.prepare(slice.size()), boost::asio::buffer(slice)));
+            }
+
+            boost::system::error_code ec;
+            auto header = ripple::detail::parseMessageHeader(
+                ec, buffers.data(), buffer.size());
+
+            BEAST_EXPECT(header);
+
+            if (!header || header->algorithm == Algorithm::None)
+                continue;
+
+            // The dictionary is only used for some message types, and
+            // only for small messages
+            BEAST_EXPECT(
+                header->algorithm == algorithm ||
+                header->algorithm == Algorithm::LZ4);
+            if (header->algorithm == Algorithm::LZ4Dict)
+                BEAST_EXPECT(
+                    header->uncompressed_size <=
+                    compression::lz4DictMaxBytes);
+
+            std::vector<std::uint8_t> decompressed;
+            decompressed.resize(header->uncompressed_size);
+
+            BEAST_EXPECT(
+                header->payload_wire_size ==
+                buffer.size() - header->header_size);
+
+            ZeroCopyInputStream stream(buffers.data());
+            stream.Skip(header->header_size);
+
+            auto decompressedSize = ripple::compression::decompress(
+                stream,
+                header->payload_wire_size,
+                decompressed.data(),
+                header->uncompressed_size,
+                header->algorithm);
+            BEAST_EXPECT(decompressedSize == header->uncompressed_size);
+            auto const proto1 = std::make_shared<T>();
+
+            BEAST_EXPECT(
+                proto1->ParseFromArray(decompressed.data(), decompressedSize));
+            auto uncompressed = m.getBuffer(Compressed::Off);
+            BEAST_EXPECT(std::equal(
+                uncompressed.begin() + ripple::compression::headerBytes,
+                uncompressed.end(),
+                decompressed.begin()));
         }
-
-        boost::system::error_code ec;
-        auto header = ripple::detail::parseMessageHeader(
-            ec, buffers.data(), buffer.size());
-
-        BEAST_EXPECT(header);
-
-        if (!header || header->algorithm == Algorithm::None)
-            return;
-
-        std::vector<std::uint8_t> decompressed;
-        decompressed.resize(header->uncompressed_size);
-
-        BEAST_EXPECT(
-            header->payload_wire_size == buffer.size() - header->header_size);
-
-        ZeroCopyInputStream stream(buffers.data());
-        stream.Skip(header->header_size);
-
-        auto decompressedSize = ripple::compression::decompress(
-            stream,
-            header->payload_wire_size,
-            decompressed.data(),
-            header->uncompressed_size);
-        BEAST_EXPECT(decompressedSize == header->uncompressed_size);
-        auto const proto1 = std::make_shared<T>();
-
-        BEAST_EXPECT(
-            proto1->ParseFromArray(decompressed.data(), decompressedSize));
-        auto uncompressed = m.getBuffer(Compressed::Off);
-        BEAST_EXPECT(std::equal(
-            uncompressed.begin() + ripple::compression::headerBytes,
-            uncompressed.end(),
-            decompressed.begin()));
     }
 
     std::shared_ptr<protocol::TMManifests>
@@ -519,11 +538,178 @@ public:
             auto const outboundEnabled = peerFeatureEnabled(
                 http_resp, FEATURE_COMPR, "lz4", outboundEnable);
             BEAST_EXPECT(!(peerEnabled ^ outboundEnabled));
+            // the dictionary is negotiated along with compression
+            auto const inboundDict = peerFeatureEnabled(
+                http_request, FEATURE_COMPR, COMPR_LZ4_DICT, inboundEnable);
+            BEAST_EXPECT(!(peerEnabled ^ inboundDict));
+            auto const outboundDict = peerFeatureEnabled(
+                http_resp, FEATURE_COMPR, COMPR_LZ4_DICT, outboundEnable);
+            BEAST_EXPECT(!(peerEnabled ^ outboundDict));
         };
         handshake(1, 1);
         handshake(1, 0);
         handshake(0, 1);
         handshake(0, 0);
+
+        // a peer that only knows lz4 is answered with lz4 only
+        http_request_type request;
+        request.insert("X-Protocol-Ctl", "compr=lz4");
+        auto const features =
+            makeFeaturesResponseHeader(request, true, false, false, false);
+        BEAST_EXPECT(features == "compr=lz4;");
+    }
+
+    /** Returns serialized transactions of a few common types, along with
+        the ledger that holds the last of them.
+    */
+    std::pair<std::vector<std::string>, std::shared_ptr<Ledger const>>
+    makeTransactions(Env& env)
+    {
+        std::vector<std::string> txs;
+        auto close = [&] {
+            env.close();
+            for (auto const& [tx, meta] : env.closed()->txs)
+            {
+                Serializer s;
+                tx->add(s);
+                txs.push_back(s.getString());
+            }
+        };
+
+        Account const gw("gateway");
+        std::vector<Account> accounts;
+        for (int i = 0; i < 50; ++i)
+            accounts.emplace_back("account" + std::to_string(i));
+
+        env.fund(XRP(100000), gw);
+        for (auto const& account : accounts)
+            env.fund(XRP(10000), account);
+        close();
+        for (auto const& account : accounts)
+            env(trust(account, gw["USD"](1000)));
+        close();
+        for (std::size_t i = 0; i < accounts.size(); ++i)
+        {
+            env(pay(gw, accounts[i], gw["USD"](100)));
+            env(offer(accounts[i], XRP(10 + i), gw["USD"](1)));
+            env(pay(accounts[i], accounts[(i + 1) % accounts.size()], XRP(1)));
+        }
+        close();
+
+        return {txs, env.app().getLedgerMaster().getClosedLedger()};
+    }
+
+    /** Compresses and decompresses a message repeatedly, reporting the size
+        of the result and the time each takes.
+    */
+    template <typename T>
+    void
+    benchmark(T const& proto, std::string const& name)
+    {
+        using namespace std::chrono;
+        using namespace ripple::compression;
+
+        std::string payload;
+        BEAST_EXPECT(proto.SerializeToString(&payload));
+        auto const iterations =
+            std::max<std::size_t>(10, megabytes(16) / payload.size());
+
+        for (auto const algorithm : {Algorithm::LZ4, Algorithm::LZ4Dict})
+        {
+            auto const dictionary =
+                algorithm == Algorithm::LZ4Dict ? lz4Dictionary() : Slice{};
+
+            std::vector<std::uint8_t> compressed;
+            std::size_t compressedSize = 0;
+            auto start = steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                compressedSize = compress(
+                    payload.data(),
+                    payload.size(),
+                    [&](std::size_t size) {
+                        compressed.resize(size);
+                        return compressed.data();
+                    },
+                    algorithm);
+            }
+            auto const compressTime = steady_clock::now() - start;
+
+            std::vector<std::uint8_t> decompressed(payload.size());
+            start = steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                compression_algorithms::lz4Decompress(
+                    compressed.data(),
+                    compressedSize,
+                    decompressed.data(),
+                    decompressed.size(),
+                    dictionary);
+            }
+            auto const decompressTime = steady_clock::now() - start;
+
+            BEAST_EXPECT(std::equal(
+                decompressed.begin(), decompressed.end(), payload.begin()));
+
+            auto perMessage = [&](auto elapsed) {
+                return duration_cast<nanoseconds>(elapsed).count() /
+                    iterations / 1000.0;
+            };
+            log << name << " "
+                << (algorithm == Algorithm::LZ4 ? "lz4" : COMPR_LZ4_DICT)
+                << ": " << payload.size() << " -> " << compressedSize
+                << " bytes (" << (100.0 * compressedSize / payload.size())
+                << "%), compress " << perMessage(compressTime)
+                << "us, decompress " << perMessage(decompressTime) << "us"
+                << std::endl;
+        }
+    }
+
+    void
+    testBenchmark()
+    {
+        testcase("Bandwidth and CPU");
+
+        Env env(*this, envconfig());
+        auto const transactionsAndLedger = makeTransactions(env);
+        auto const& txs = transactionsAndLedger.first;
+        auto const& ledger = transactionsAndLedger.second;
+
+        auto makeTransaction = [](std::string const& tx) {
+            protocol::TMTransaction transaction;
+            transaction.set_rawtransaction(tx);
+            transaction.set_status(protocol::tsNEW);
+            transaction.set_receivetimestamp(123456789);
+            return transaction;
+        };
+
+        // A single transaction, as relayed
+        benchmark(makeTransaction(txs.back()), "TMTransaction");
+
+        // A batch of transactions, as requested after TMHaveTransactions
+        protocol::TMTransactions transactions;
+        for (auto const& tx : txs)
+            *transactions.add_transactions() = makeTransaction(tx);
+        benchmark(transactions, "TMTransactions");
+
+        // The nodes of a ledger's state and transaction trees, as sent
+        // to a node that is acquiring the ledger
+        auto ledgerData = [&](SHAMap const& map) {
+            protocol::TMLedgerData data;
+            data.set_ledgerhash(
+                ledger->info().hash.data(), ledger->info().hash.size());
+            data.set_ledgerseq(ledger->info().seq);
+            data.set_type(protocol::liAS_NODE);
+            map.visitNodes([&](SHAMapTreeNode& node) {
+                Serializer s;
+                node.serializeForWire(s);
+                data.add_nodes()->set_nodedata(s.getDataPtr(), s.getLength());
+                return true;
+            });
+            return data;
+        };
+        benchmark(ledgerData(ledger->stateMap()), "TMLedgerData state");
+        benchmark(ledgerData(ledger->txMap()), "TMLedgerData tx");
     }
 
     void
@@ -531,6 +717,7 @@ public:
     {
         testProtocol();
         testHandshake();
+        testBenchmark();
     }
 };
 
@@ -25,6 +25,7 @@
 #include <ripple/protocol/SecretKey.h>
 #include <ripple.pb.h>
 #include <test/jtx/Env.h>
+#include <test/jtx/benchmark.h>
 
 #include <boost/thread.hpp>
 
@@ -1584,11 +1585,60 @@ class reduce_relay_simulate_test : public reduce_relay_test
         doTest("Random Test", log, [&](bool log) { random(log); });
     }
 
+    // Measures the cost of counting messages in the slots, with every
+    // validator's messages received from every peer.
+    void
+    testThroughput(std::size_t nValidators, std::size_t nPeers)
+    {
+        testcase << "Throughput " << nValidators << " validators " << nPeers
+                 << " peers";
+
+        std::vector<PublicKey> validators;
+        for (std::size_t v = 0; v < nValidators; ++v)
+            validators.push_back(randomKeyPair(KeyType::ed25519).first);
+
+        Handler handler;
+        reduce_relay::Slots<ManualClock> slots(env_.app().logs(), handler);
+
+        // Each round every validator sends one message, which every peer
+        // relays. Squelches don't stop the updates, as the slots still see
+        // the messages relayed by squelched peers.
+        std::size_t const rounds = 100;
+        std::uint64_t mid = 0;
+        jtx::benchmark(*this, "update", rounds * nValidators * nPeers, [&]() {
+            for (std::size_t r = 0; r < rounds; ++r)
+            {
+                for (auto const& validator : validators)
+                {
+                    uint256 const message{++mid};
+                    for (std::size_t peer = 0; peer < nPeers; ++peer)
+                        slots.updateSlotAndSquelch(
+                            message,
+                            validator,
+                            peer,
+                            protocol::MessageType::mtVALIDATION);
+                }
+                ManualClock::advance(seconds(1));
+                slots.deleteIdlePeers();
+            }
+        });
+
+        for (auto const& validator : validators)
+            BEAST_EXPECT(
+                slots.getSelected(validator).size() ==
+                reduce_relay::MAX_SELECTED_PEERS);
+
+        // make Slot's internal hash router expire all messages
+        ManualClock::advance(hours(1));
+    }
+
     void
     run() override
     {
         bool log = false;
         testRandom(log);
+        testThroughput(35, 50);
+        testThroughput(35, 200);
     }
 };
 
@@ -40,6 +40,10 @@ public:
 
     struct TestStore : Store
     {
+        std::size_t writes = 0;
+        std::vector<Entry> changed;
+        std::vector<beast::IP::Endpoint> removed;
+
         std::size_t
         load(load_callback const& cb) override
         {
@@ -50,6 +54,16 @@ public:
         save(std::vector<Entry> const&) override
         {
         }
+
+        void
+        saveChanges(
+            std::vector<Entry> const& c,
+            std::vector<beast::IP::Endpoint> const& r) override
+        {
+            ++writes;
+            changed = c;
+            removed = r;
+        }
     };
 
     struct TestChecker
@@ -274,6 +288,53 @@ public:
 )rippleConfig");
     }
 
+    void
+    test_bootcache()
+    {
+        testcase("bootcache");
+        TestStore store;
+        TestChecker checker;
+        TestStopwatch clock;
+        Logic<TestChecker> logic(clock, store, checker, journal_);
+
+        auto redirect = [&](std::vector<char const*> const& addresses) {
+            std::vector<boost::asio::ip::tcp::endpoint> eps;
+            for (auto const& a : addresses)
+                eps.push_back(beast::IP::to_asio_endpoint(
+                    beast::IP::Endpoint::from_string(a)));
+            logic.onRedirects(eps.begin(), eps.end(), eps.front());
+        };
+
+        // Learning addresses doesn't write to the store
+        redirect({"65.0.0.1:5", "65.0.0.2:5", "65.0.0.3:5"});
+        BEAST_EXPECT(store.writes == 0);
+
+        // The new addresses are written on the timer
+        clock.advance(std::chrono::seconds(1));
+        logic.once_per_second();
+        BEAST_EXPECT(store.writes == 1);
+        BEAST_EXPECT(store.changed.size() == 3);
+        BEAST_EXPECT(store.removed.empty());
+
+        // Only the changes are written, once the cooldown has passed
+        redirect({"65.0.0.1:5", "65.0.0.4:5"});
+        clock.advance(std::chrono::seconds(1));
+        logic.once_per_second();
+        BEAST_EXPECT(store.writes == 1);
+        clock.advance(Tuning::bootcacheCooldownTime);
+        logic.once_per_second();
+        BEAST_EXPECT(store.writes == 2);
+        if (BEAST_EXPECT(store.changed.size() == 1))
+            BEAST_EXPECT(
+                store.changed.front().endpoint ==
+                beast::IP::Endpoint::from_string("65.0.0.4:5"));
+
+        // Nothing is written when nothing changed
+        clock.advance(Tuning::bootcacheCooldownTime);
+        logic.once_per_second();
+        BEAST_EXPECT(store.writes == 2);
+    }
+
     void
     run() override
     {
@@ -281,6 +342,7 @@ public:
         test_backoff2();
         test_config();
         test_invalid_config();
+        test_bootcache();
     }
 };
 
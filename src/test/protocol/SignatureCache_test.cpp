@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/SignatureCache.h>
+#include <ripple/protocol/digest.h>
+#include <string>
+
+namespace ripple {
+
+class SignatureCache_test : public beast::unit_test::suite
+{
+    void
+    testVerify(KeyType type)
+    {
+        testcase(std::string("Verify ") + to_string(type));
+
+        SignatureCache cache;
+        auto const [pk, sk] = randomKeyPair(type);
+        std::string const data = "Cache this signature";
+        auto const m = makeSlice(data);
+        auto const sig = sign(pk, sk, m);
+
+        // A good signature is verified once, then found in the cache
+        BEAST_EXPECT(cache.verify(pk, m, sig));
+        BEAST_EXPECT(cache.misses() == 1 && cache.hits() == 0);
+        BEAST_EXPECT(cache.verify(pk, m, sig));
+        BEAST_EXPECT(cache.misses() == 1 && cache.hits() == 1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // A bad signature is remembered as bad
+        auto bad = sig;
+        bad.data()[bad.size() / 2] ^= 0x01;
+        BEAST_EXPECT(!cache.verify(pk, m, bad));
+        BEAST_EXPECT(!cache.verify(pk, m, bad));
+        BEAST_EXPECT(cache.misses() == 2 && cache.hits() == 2);
+
+        // The cached verdicts don't leak to other messages or keys
+        std::string const other = "Cache this signature too";
+        BEAST_EXPECT(!cache.verify(pk, makeSlice(other), sig));
+        auto const [pk2, sk2] = randomKeyPair(type);
+        BEAST_EXPECT(!cache.verify(pk2, m, sig));
+        BEAST_EXPECT(cache.verify(pk, m, sig));
+        BEAST_EXPECT(cache.size() == 4);
+
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(cache.hits() == 0 && cache.misses() == 0);
+        BEAST_EXPECT(cache.getHitRate() == 0);
+    }
+
+    void
+    testVerifyDigest()
+    {
+        testcase("Verify digest");
+
+        SignatureCache cache;
+        auto const [pk, sk] = randomKeyPair(KeyType::secp256k1);
+        auto const digest = sha512Half(std::string("digest"));
+        auto const sig = signDigest(pk, sk, digest);
+
+        BEAST_EXPECT(cache.verifyDigest(pk, digest, sig));
+        BEAST_EXPECT(cache.verifyDigest(pk, digest, sig));
+        BEAST_EXPECT(cache.hits() == 1);
+
+        // A digest is not confused with a message holding the same bytes
+        BEAST_EXPECT(
+            !cache.verify(pk, Slice(digest.data(), digest.size()), sig));
+        BEAST_EXPECT(cache.hits() == 1);
+
+        // Nor is a signature checked with different canonicality rules
+        BEAST_EXPECT(cache.verifyDigest(pk, digest, sig, false));
+        BEAST_EXPECT(cache.hits() == 1);
+    }
+
+    void
+    testEviction()
+    {
+        testcase("Eviction");
+
+        std::size_t const capacity = 4 * SignatureCache::shardCount;
+        SignatureCache cache(capacity);
+        BEAST_EXPECT(cache.capacity() == capacity);
+
+        auto const [pk, sk] = randomKeyPair(KeyType::ed25519);
+        auto const sig = sign(pk, sk, makeSlice(std::string("first")));
+
+        // Fill the cache well past its capacity
+        BEAST_EXPECT(cache.verify(pk, makeSlice(std::string("first")), sig));
+        for (std::size_t i = 0; i < 10 * capacity; ++i)
+        {
+            auto const data = std::to_string(i);
+            BEAST_EXPECT(!cache.verify(pk, makeSlice(data), sig));
+            BEAST_EXPECT(cache.size() <= capacity);
+        }
+        BEAST_EXPECT(cache.size() > capacity / 2);
+
+        // The first verdict was evicted, and is checked again
+        auto const misses = cache.misses();
+        BEAST_EXPECT(cache.verify(pk, makeSlice(std::string("first")), sig));
+        BEAST_EXPECT(cache.misses() == misses + 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testVerify(KeyType::secp256k1);
+        testVerify(KeyType::ed25519);
+        testVerifyDigest();
+        testEviction();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SignatureCache, protocol, ripple);
+
+}  // namespace ripple
@@ -17,11 +17,65 @@
 */
 //==============================================================================
 
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/strHex.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
 #include <ripple/protocol/UintTypes.h>
+#include <ripple/protocol/digest.h>
+#include <chrono>
+#include <cstring>
 
 namespace ripple {
 
+namespace {
+
+// The digit at a time base58 encoder which tokens.cpp used to use
+std::string
+referenceBase58Token(TokenType type, void const* token, std::size_t size)
+{
+    static constexpr char const* alphabet =
+        "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+
+    std::vector<unsigned char> buf(1 + size + 4);
+    buf[0] = static_cast<unsigned char>(type);
+    if (size)
+        std::memcpy(buf.data() + 1, token, size);
+    sha256_hasher h1;
+    h1(buf.data(), 1 + size);
+    auto const d1 = static_cast<sha256_hasher::result_type>(h1);
+    sha256_hasher h2;
+    h2(d1.data(), d1.size());
+    auto const d2 = static_cast<sha256_hasher::result_type>(h2);
+    std::memcpy(buf.data() + 1 + size, d2.data(), 4);
+
+    auto iter = buf.begin();
+    int zeroes = 0;
+    for (; iter != buf.end() && *iter == 0; ++iter)
+        ++zeroes;
+
+    std::vector<unsigned char> b58(buf.size() * 138 / 100 + 1);
+    for (; iter != buf.end(); ++iter)
+    {
+        int carry = *iter;
+        for (auto it = b58.rbegin(); it != b58.rend(); ++it)
+        {
+            carry += 256 * (*it);
+            *it = carry % 58;
+            carry /= 58;
+        }
+    }
+
+    auto it = std::find_if(
+        b58.begin(), b58.end(), [](unsigned char c) { return c != 0; });
+    std::string str(zeroes, alphabet[0]);
+    for (; it != b58.end(); ++it)
+        str += alphabet[*it];
+    return str;
+}
+
+}  // namespace
+
 struct types_test : public beast::unit_test::suite
 {
     void
@@ -32,13 +86,145 @@ struct types_test : public beast::unit_test::suite
             BEAST_EXPECT(toBase58(*parseBase58<AccountID>(s)) == s);
     }
 
+    void
+    testBase58()
+    {
+        testcase("base58");
+
+        BEAST_EXPECT(toBase58(xrpAccount()) == "rrrrrrrrrrrrrrrrrrrrrhoLvTp");
+        BEAST_EXPECT(toBase58(noAccount()) == "rrrrrrrrrrrrrrrrrrrrBZbvji");
+
+        // Tokens of every size, with and without leading zeroes, match the
+        // reference encoder and decode to the original bytes.
+        beast::xor_shift_engine rng(42);
+        for (int i = 0; i < 2000; ++i)
+        {
+            std::vector<unsigned char> token(i % 40);
+            auto const zeroes = (i / 40) % 4;
+            for (std::size_t j = 0; j < token.size(); ++j)
+                token[j] = j < zeroes ? 0 : static_cast<unsigned char>(rng());
+
+            for (auto const type : {TokenType::AccountID, TokenType::None})
+            {
+                auto const s =
+                    encodeBase58Token(type, token.data(), token.size());
+                auto const expected =
+                    referenceBase58Token(type, token.data(), token.size());
+                BEAST_EXPECT(s == expected);
+
+                auto const decoded = decodeBase58Token(s, type);
+                BEAST_EXPECT(
+                    decoded.size() == token.size() &&
+                    std::equal(token.begin(), token.end(), decoded.begin()));
+            }
+        }
+
+        // Invalid characters and checksums are rejected
+        auto const s = toBase58(noAccount());
+        BEAST_EXPECT(!parseBase58<AccountID>(s.substr(0, s.size() - 1) + "0"));
+        BEAST_EXPECT(!parseBase58<AccountID>(s.substr(0, s.size() - 1) + "l"));
+        BEAST_EXPECT(!parseBase58<AccountID>(s.substr(0, s.size() - 1) + "a"));
+    }
+
+    void
+    testAccountIDCache()
+    {
+        testcase("AccountIDCache");
+
+        AccountIDCache cache(64);
+        beast::xor_shift_engine rng(7);
+        std::vector<AccountID> ids(256);
+        for (auto& id : ids)
+        {
+            for (auto& b : id)
+                b = static_cast<std::uint8_t>(rng());
+        }
+
+        // More accounts than the cache holds, rendered twice
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (auto const& id : ids)
+                BEAST_EXPECT(cache.toBase58(id) == toBase58(id));
+        }
+    }
+
     void
     run() override
     {
         testAccountID();
+        testBase58();
+        testAccountIDCache();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(types, protocol, ripple);
 
+// Measures the codecs used to render accounts and blobs
+struct types_timing_test : public beast::unit_test::suite
+{
+    template <class F>
+    void
+    measure(std::string const& name, F&& f)
+    {
+        using namespace std::chrono;
+        int const count = 200000;
+        std::size_t bytes = 0;
+        auto const start = steady_clock::now();
+        for (int i = 0; i < count; ++i)
+            bytes += f(i);
+        auto const elapsed = steady_clock::now() - start;
+        log << name << ": "
+            << duration_cast<nanoseconds>(elapsed).count() / count
+            << " ns per call (" << bytes << " bytes)" << std::endl;
+    }
+
+    void
+    run() override
+    {
+        beast::xor_shift_engine rng(1);
+        std::vector<AccountID> ids(1000);
+        for (auto& id : ids)
+        {
+            for (auto& b : id)
+                b = static_cast<std::uint8_t>(rng());
+        }
+        std::vector<std::string> strings;
+        for (auto const& id : ids)
+            strings.push_back(toBase58(id));
+        Blob blob(256);
+        for (auto& b : blob)
+            b = static_cast<std::uint8_t>(rng());
+
+        measure("reference base58 encode", [&](int i) {
+            auto const& id = ids[i % ids.size()];
+            return referenceBase58Token(TokenType::AccountID, id.data(), 20)
+                .size();
+        });
+        measure("base58 encode", [&](int i) {
+            return toBase58(ids[i % ids.size()]).size();
+        });
+        measure("base58 decode", [&](int i) {
+            return parseBase58<AccountID>(strings[i % strings.size()])->size();
+        });
+
+        AccountIDCache cache(128000);
+        measure("AccountIDCache", [&](int i) {
+            return cache.toBase58(ids[i % ids.size()]).size();
+        });
+
+        measure("strHex 256 bytes", [&](int i) {
+            blob[0] = static_cast<std::uint8_t>(i);
+            return strHex(blob).size();
+        });
+        auto const hex = strHex(blob);
+        measure("strUnHex 256 bytes", [&](int) {
+            return strUnHex(hex)->size();
+        });
+
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(types_timing, protocol, ripple);
+
 }  // namespace ripple
@@ -15,9 +15,12 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/AcceptedLedger.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Feature.h>
 #include <ripple/protocol/jss.h>
+#include <ripple/rpc/ObligationsIndex.h>
 #include <test/jtx.h>
 #include <test/jtx/WSClient.h>
 
@@ -148,6 +151,126 @@ public:
         }
     }
 
+    void
+    testIndex()
+    {
+        testcase("Obligations index");
+
+        using namespace jtx;
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg) {
+            cfg->GATEWAY_BALANCES_INDEX = 8;
+            return cfg;
+        }));
+
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+        Account const carol{"carol"};
+        Account const dave{"dave"};
+        Account const erin{"erin"};
+        auto const USD = alice["USD"];
+        auto const EUR = alice["EUR"];
+
+        env.fund(XRP(10000), alice, bob, carol, dave, erin);
+        env.trust(USD(1000), bob, carol, dave);
+        env.trust(EUR(1000), bob);
+        env(pay(alice, bob, USD(100)));
+        env(pay(alice, carol, USD(50)));
+        env.close();
+
+        using Obligations = RPC::ObligationsIndex::Obligations;
+        RPC::ObligationsIndex index(8);
+
+        auto publish = [&]() {
+            index.apply(AcceptedLedger(env.closed(), env.app()));
+        };
+
+        auto expectBuilt = [&](std::optional<Obligations> const& o) {
+            auto const built =
+                RPC::ObligationsIndex::build(*env.closed(), alice.id());
+            return o && o->sums == built.sums && o->others == built.others;
+        };
+
+        publish();
+        BEAST_EXPECT(!index.fetch(*env.current(), alice.id()));
+        {
+            auto const o = index.fetch(*env.closed(), alice.id());
+            BEAST_EXPECT(expectBuilt(o));
+            BEAST_EXPECT(o && o->sums.at(USD.currency) == USD(150));
+            BEAST_EXPECT(index.misses() == 1 && index.hits() == 0);
+        }
+
+        // Move, add, freeze and hold balances
+        env(pay(bob, carol, USD(30)));
+        env(pay(alice, dave, USD(20)));
+        env(pay(alice, bob, EUR(5)));
+        env(trust(alice, dave["USD"](0), dave, tfSetFreeze));
+        env(trust(alice, erin["USD"](50)));
+        env(pay(erin, alice, erin["USD"](10)));
+        env.close();
+        publish();
+        {
+            auto const o = index.fetch(*env.closed(), alice.id());
+            BEAST_EXPECT(expectBuilt(o));
+            BEAST_EXPECT(o && o->sums.at(USD.currency) == USD(150));
+            BEAST_EXPECT(o && o->sums.at(EUR.currency) == EUR(5));
+            BEAST_EXPECT(o && o->others.size() == 2);
+            BEAST_EXPECT(index.hits() == 1);
+        }
+
+        // Remove a trust line
+        env(pay(bob, alice, EUR(5)));
+        env(trust(bob, EUR(0)));
+        env.close();
+        publish();
+        {
+            auto const o = index.fetch(*env.closed(), alice.id());
+            BEAST_EXPECT(expectBuilt(o));
+            BEAST_EXPECT(o && o->sums.count(EUR.currency) == 0);
+            BEAST_EXPECT(index.hits() == 2);
+        }
+
+        // A ledger which does not follow the last one forgets the issuers
+        env.close();
+        env.close();
+        publish();
+        BEAST_EXPECT(index.size() == 0);
+        BEAST_EXPECT(expectBuilt(index.fetch(*env.closed(), alice.id())));
+        BEAST_EXPECT(index.misses() == 2 && index.size() == 1);
+
+        // gateway_balances gives the same result with the server's index.
+        // The server publishes closed ledgers from the job queue.
+        env.app().getJobQueue().rendezvous();
+        auto& appIndex = env.app().getObligationsIndex();
+        if (!BEAST_EXPECT(appIndex.fetch(*env.closed(), alice.id())))
+            return;
+
+        auto gatewayBalances = [&](char const* ledger) {
+            Json::Value params;
+            params[jss::account] = alice.human();
+            params[jss::hotwallet] = carol.human();
+            params[jss::ledger_index] = ledger;
+            return env.rpc(
+                "json", "gateway_balances", to_string(params))[jss::result];
+        };
+
+        auto const hits = appIndex.hits();
+        auto const indexed = gatewayBalances("validated");
+        BEAST_EXPECT(appIndex.hits() == hits + 1);
+        auto const walked = gatewayBalances("current");
+        BEAST_EXPECT(appIndex.hits() == hits + 1);
+
+        BEAST_EXPECT(indexed[jss::obligations]["USD"] == "70");
+        for (auto const& field :
+             {jss::obligations,
+              jss::balances,
+              jss::frozen_balances,
+              jss::assets})
+        {
+            BEAST_EXPECT(indexed.isMember(field));
+            BEAST_EXPECT(indexed[field] == walked[field]);
+        }
+    }
+
     void
     run() override
     {
@@ -155,6 +278,7 @@ public:
         auto const sa = supported_amendments();
         testGWB(sa - featureFlowCross);
         testGWB(sa);
+        testIndex();
     }
 };
 
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2022 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/basics/ByteUtilities.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/jss.h>
+#include <ripple/rpc/ResponseCache.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class ResponseCache_test : public beast::unit_test::suite
+{
+    static Json::Value
+    makeResult(std::string const& value)
+    {
+        Json::Value result(Json::objectValue);
+        result[jss::value] = value;
+        return result;
+    }
+
+    void
+    testKey()
+    {
+        testcase("Key");
+
+        using RPC::ResponseCache;
+        uint256 const hash1{1};
+        uint256 const hash2{2};
+
+        Json::Value params(Json::objectValue);
+        params[jss::account] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        params[jss::ledger_index] = "validated";
+        params[jss::strict] = true;
+
+        auto const key = ResponseCache::makeKey(
+            "account_info", params, hash1, Role::USER, 1);
+
+        // The request's id and command do not select its result
+        {
+            auto p = params;
+            p[jss::id] = 7;
+            p[jss::command] = "account_info";
+            p[jss::jsonrpc] = "2.0";
+            BEAST_EXPECT(
+                ResponseCache::makeKey(
+                    "account_info", p, hash1, Role::USER, 1) == key);
+        }
+
+        // Neither does the order of the parameters
+        {
+            Json::Value p(Json::objectValue);
+            p[jss::strict] = true;
+            p[jss::ledger_index] = "validated";
+            p[jss::account] = params[jss::account];
+            BEAST_EXPECT(
+                ResponseCache::makeKey(
+                    "account_info", p, hash1, Role::USER, 1) == key);
+        }
+
+        // Everything else does
+        {
+            auto p = params;
+            p[jss::strict] = false;
+            BEAST_EXPECT(
+                ResponseCache::makeKey(
+                    "account_info", p, hash1, Role::USER, 1) != key);
+        }
+        BEAST_EXPECT(
+            ResponseCache::makeKey(
+                "account_lines", params, hash1, Role::USER, 1) != key);
+        BEAST_EXPECT(
+            ResponseCache::makeKey(
+                "account_info", params, hash2, Role::USER, 1) != key);
+        BEAST_EXPECT(
+            ResponseCache::makeKey(
+                "account_info", params, hash1, Role::ADMIN, 1) != key);
+        BEAST_EXPECT(
+            ResponseCache::makeKey(
+                "account_info", params, hash1, Role::USER, 2) != key);
+    }
+
+    void
+    testCache()
+    {
+        testcase("Cache");
+
+        using RPC::ResponseCache;
+
+        {
+            ResponseCache cache(0);
+            BEAST_EXPECT(!cache.enabled());
+            cache.insert("a", makeResult("a"));
+            BEAST_EXPECT(cache.size() == 0);
+            BEAST_EXPECT(!cache.fetch("a"));
+        }
+
+        ResponseCache cache(4096);
+        BEAST_EXPECT(cache.enabled());
+
+        BEAST_EXPECT(!cache.fetch("a"));
+        BEAST_EXPECT(cache.misses() == 1);
+
+        cache.insert("a", makeResult("a"));
+        auto const a = cache.fetch("a");
+        BEAST_EXPECT(a && (*a)[jss::value] == "a");
+        BEAST_EXPECT(cache.hits() == 1);
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.bytes() > 0);
+
+        // Results larger than a quarter of the budget are not kept
+        cache.insert("big", makeResult(std::string(1024, 'x')));
+        BEAST_EXPECT(!cache.fetch("big"));
+        BEAST_EXPECT(cache.size() == 1);
+
+        // Filling the cache evicts the least recently used results
+        std::string const value(200, 'x');
+        for (int i = 0; i < 40; ++i)
+        {
+            cache.insert(std::to_string(i), makeResult(value));
+            // Keep "a" in use
+            BEAST_EXPECT(cache.fetch("a"));
+        }
+        BEAST_EXPECT(cache.bytes() <= 4096);
+        BEAST_EXPECT(cache.evictions() > 0);
+        BEAST_EXPECT(cache.size() < 41);
+        BEAST_EXPECT(!cache.fetch("0"));
+        BEAST_EXPECT(cache.fetch("39"));
+        BEAST_EXPECT(cache.fetch("a"));
+
+        Json::Value counts(Json::objectValue);
+        cache.getCounts(counts);
+        BEAST_EXPECT(counts[jss::rpc_cache_size].asUInt() == cache.size());
+        BEAST_EXPECT(counts[jss::rpc_cache_hit_rate].asDouble() > 50);
+    }
+
+    void
+    testRPC()
+    {
+        testcase("RPC");
+
+        using namespace jtx;
+        Env env{*this, envconfig([](std::unique_ptr<Config> cfg) {
+                    cfg->RPC_RESPONSE_CACHE = megabytes(1);
+                    return cfg;
+                })};
+        auto& cache = env.app().getRPCResponseCache();
+
+        Account const alice{"alice"};
+        env.fund(XRP(10000), alice);
+        env.close();
+
+        auto accountInfo = [&](Json::Value const& ledgerIndex) {
+            Json::Value params(Json::objectValue);
+            params[jss::account] = alice.human();
+            params[jss::ledger_index] = ledgerIndex;
+            return env.rpc(
+                "json", "account_info", to_string(params))[jss::result];
+        };
+        auto balance = [](Json::Value const& result) {
+            return result[jss::account_data][sfBalance.jsonName];
+        };
+
+        auto const first = accountInfo("validated");
+        BEAST_EXPECT(first[jss::validated].asBool());
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.hits() == 0);
+
+        auto const second = accountInfo("validated");
+        BEAST_EXPECT(cache.hits() == 1);
+        BEAST_EXPECT(balance(second) == balance(first));
+        BEAST_EXPECT(second[jss::ledger_hash] == first[jss::ledger_hash]);
+
+        // Requests for the open ledger are never cached
+        accountInfo("current");
+        accountInfo("current");
+        BEAST_EXPECT(cache.size() == 1);
+        BEAST_EXPECT(cache.hits() == 1);
+
+        // A new validated ledger is a different key
+        env(pay(alice, env.master, XRP(100)));
+        env.close();
+        auto const third = accountInfo("validated");
+        BEAST_EXPECT(cache.hits() == 1);
+        BEAST_EXPECT(balance(third) != balance(first));
+        BEAST_EXPECT(third[jss::ledger_hash] != first[jss::ledger_hash]);
+
+        // An older ledger named by sequence is cached too
+        auto const seq = first[jss::ledger_index];
+        auto const fourth = accountInfo(seq);
+        BEAST_EXPECT(balance(fourth) == balance(first));
+        accountInfo(seq);
+        BEAST_EXPECT(cache.hits() == 2);
+
+        // Errors are not cached
+        accountInfo(env.current()->seq() + 10);
+        accountInfo(env.current()->seq() + 10);
+        BEAST_EXPECT(cache.size() == 3);
+
+        auto const counts = env.rpc("get_counts")[jss::result];
+        BEAST_EXPECT(counts[jss::rpc_cache_size].asUInt() == 3);
+        BEAST_EXPECT(counts.isMember(jss::rpc_cache_hit_rate));
+    }
+
+public:
+    void
+    run() override
+    {
+        testKey();
+        testCache();
+        testRPC();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResponseCache, rpc, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -21,8 +21,11 @@
 #include <ripple/basics/Buffer.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/digest.h>
 #include <ripple/shamap/SHAMap.h>
 #include <algorithm>
+#include <chrono>
+#include <set>
 #include <test/shamap/common.h>
 #include <test/unit_test/SuiteJournal.h>
 
@@ -126,6 +129,141 @@ public:
 
         run(true, journal);
         run(false, journal);
+        testBounds(journal);
+        testFlush(journal);
+    }
+
+    static Buffer
+    makeValue(std::uint64_t v)
+    {
+        Buffer b(16);
+        std::fill_n(b.data(), 8, static_cast<std::uint8_t>(v));
+        std::fill_n(b.data() + 8, 8, static_cast<std::uint8_t>(v >> 8));
+        return b;
+    }
+
+    // Build a map, flush it, then modify `modified` entries of a mutable
+    // snapshot and flush that. Returns the snapshot.
+    static std::shared_ptr<SHAMap>
+    makeModified(
+        tests::TestNodeFamily& f,
+        std::uint64_t items,
+        std::uint64_t modified)
+    {
+        SHAMap map{SHAMapType::FREE, f};
+        for (std::uint64_t i = 0; i < items; ++i)
+            map.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                SHAMapItem{sha512Half(i), makeValue(i)});
+        map.flushDirty(hotUNKNOWN);
+
+        auto snap = map.snapShot(true);
+        for (std::uint64_t i = 0; i < modified; ++i)
+            snap->updateGiveItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                std::make_shared<SHAMapItem const>(
+                    sha512Half((i * 7) % items), makeValue(items + i)));
+        return snap;
+    }
+
+    void
+    testFlush(beast::Journal const& journal)
+    {
+        testcase("flush");
+
+        std::uint64_t const items = 4000;
+
+        for (std::uint64_t modified : {0, 1, 10, 1000, 4000})
+        {
+            tests::TestNodeFamily f(journal);
+            auto const snap = makeModified(f, items, modified);
+            snap->flushDirty(hotUNKNOWN);
+            snap->invariants();
+
+            // The same contents, built and hashed from scratch
+            SHAMap expected{SHAMapType::FREE, f};
+            expected.setUnbacked();
+            for (auto const& item : *snap)
+                expected.addItem(
+                    SHAMapNodeType::tnTRANSACTION_NM, SHAMapItem{item});
+            BEAST_EXPECT(snap->getHash() == expected.getHash());
+
+            // Everything needed to load the map was written
+            f.reset();
+            SHAMap loaded{
+                SHAMapType::FREE, snap->getHash().as_uint256(), f};
+            BEAST_EXPECT(loaded.fetchRoot(snap->getHash(), nullptr));
+            BEAST_EXPECT(std::equal(
+                loaded.begin(),
+                loaded.end(),
+                snap->begin(),
+                snap->end(),
+                [](SHAMapItem const& a, SHAMapItem const& b) {
+                    return a.key() == b.key() && a.slice() == b.slice();
+                }));
+        }
+    }
+
+    void
+    testBounds(beast::Journal const& journal)
+    {
+        testcase("upper_bound/lower_bound");
+
+        tests::TestNodeFamily f(journal);
+        SHAMap map{SHAMapType::FREE, f};
+        std::set<uint256> keys;
+        for (std::uint64_t i = 0; i < 2000; ++i)
+        {
+            auto const key = sha512Half(i);
+            keys.insert(key);
+            map.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                SHAMapItem{key, IntToVUC(0)});
+        }
+        auto const snap = map.snapShot(false);
+
+        BEAST_EXPECT(std::equal(
+            keys.begin(),
+            keys.end(),
+            snap->begin(),
+            snap->end(),
+            [](uint256 const& key, SHAMapItem const& item) {
+                return key == item.key();
+            }));
+
+        // Probe with keys that are in the map, and keys that are not
+        for (std::uint64_t i = 0; i < 4000; i += 3)
+        {
+            auto const probe =
+                (i % 2) ? sha512Half(i / 2) : sha512Half(i, std::uint64_t{1});
+
+            auto const upper = keys.upper_bound(probe);
+            auto const su = snap->upper_bound(probe);
+            if (upper == keys.end())
+                BEAST_EXPECT(su == snap->end());
+            else if (BEAST_EXPECT(su != snap->end()))
+            {
+                BEAST_EXPECT(su->key() == *upper);
+
+                // The iterator continues from where it was positioned
+                auto const next = std::next(upper);
+                auto const sn = std::next(su);
+                if (next == keys.end())
+                    BEAST_EXPECT(sn == snap->end());
+                else
+                    BEAST_EXPECT(sn != snap->end() && sn->key() == *next);
+            }
+
+            auto const lower = keys.lower_bound(probe);
+            auto const sl = snap->lower_bound(probe);
+            if (lower == keys.begin())
+                BEAST_EXPECT(sl == snap->end());
+            else if (BEAST_EXPECT(sl != snap->end()))
+                BEAST_EXPECT(sl->key() == *std::prev(lower));
+        }
+
+        BEAST_EXPECT(snap->upper_bound(*keys.rbegin()) == snap->end());
+        BEAST_EXPECT(snap->lower_bound(*keys.begin()) == snap->end());
     }
 
     void
@@ -326,6 +464,97 @@ public:
     }
 };
 
+// Measures the throughput of iterating over a large immutable map, both
+// from the beginning and by repeatedly finding the successor of a key,
+// and the time taken to flush a map against the number of modified items.
+class SHAMap_manual_test : public SHAMap_test
+{
+    void
+    testIteration(std::size_t const items, beast::Journal const& journal)
+    {
+        testcase << "Iterate " << items << " items";
+        using clock_type = std::chrono::steady_clock;
+        using namespace std::chrono;
+
+        tests::TestNodeFamily f(journal);
+        SHAMap map{SHAMapType::FREE, f};
+        for (std::uint64_t i = 0; i < items; ++i)
+            map.addItem(
+                SHAMapNodeType::tnTRANSACTION_NM,
+                SHAMapItem{sha512Half(i), IntToVUC(0)});
+        auto const snap = map.snapShot(false);
+
+        int const rounds = 10;
+
+        std::size_t count = 0;
+        auto start = clock_type::now();
+        for (int i = 0; i < rounds; ++i)
+            for (auto const& item : *snap)
+                count += item.size() != 0;
+        auto const iterated = clock_type::now() - start;
+        BEAST_EXPECT(count == items * rounds);
+
+        count = 0;
+        start = clock_type::now();
+        for (int i = 0; i < rounds; ++i)
+        {
+            for (auto it = snap->upper_bound(uint256{});
+                 it != snap->end();
+                 it = snap->upper_bound(it->key()))
+                ++count;
+        }
+        auto const stepped = clock_type::now() - start;
+        BEAST_EXPECT(count == items * rounds);
+
+        auto const perItem = [&](auto d) {
+            return duration_cast<nanoseconds>(d).count() / (rounds * items);
+        };
+
+        log << "    iteration: " << perItem(iterated) << "ns/item"
+            << ", upper_bound: " << perItem(stepped) << "ns/item"
+            << std::endl;
+    }
+
+    void
+    testFlush(std::uint64_t const modified, beast::Journal const& journal)
+    {
+        testcase << "Flush " << modified << " modified items";
+        using clock_type = std::chrono::steady_clock;
+        using namespace std::chrono;
+
+        std::uint64_t const items = 500000;
+        int const rounds = 5;
+
+        clock_type::duration elapsed{};
+        for (int i = 0; i < rounds; ++i)
+        {
+            tests::TestNodeFamily f(journal);
+            auto const snap = makeModified(f, items, modified);
+
+            auto const start = clock_type::now();
+            BEAST_EXPECT(snap->flushDirty(hotUNKNOWN) > 0);
+            elapsed += clock_type::now() - start;
+        }
+
+        log << "    flush: "
+            << duration_cast<microseconds>(elapsed).count() / rounds << "us"
+            << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        test::SuiteJournal journal("SHAMap_manual_test", *this);
+
+        testIteration(10000, journal);
+        testIteration(1000000, journal);
+
+        for (std::uint64_t modified : {100, 1000, 10000, 100000})
+            testFlush(modified, journal);
+    }
+};
+
 class SHAMapPathProof_test : public beast::unit_test::suite
 {
     void
@@ -400,5 +629,6 @@ class SHAMapPathProof_test : public beast::unit_test::suite
 
 BEAST_DEFINE_TESTSUITE(SHAMap, ripple_app, ripple);
 BEAST_DEFINE_TESTSUITE(SHAMapPathProof, ripple_app, ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(SHAMap_manual, ripple_app, ripple);
 }  // namespace tests
 }  // namespace ripple